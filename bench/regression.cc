@@ -0,0 +1,843 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/* end-to-end regression benchmark for am_cellgen. runs the full pipeline of AnaMorph_cellgen in-process over a fixed
+ * corpus of bundled SWC files and synthetic networks, records per-stage wall time, peak resident set size, job counts
+ * and output mesh sizes to a JSON file and compares them against a baseline file written by a previous run.
+ *
+ * every case runs in a forked child process, so that its peak RSS can be measured separately and a crash does not
+ * take down the harness. */
+
+#include "common.hh"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <dirent.h>
+
+#include "AnaMorph_cellgen.hh"
+#include "Profiling.hh"
+#include "SWCSynth.hh"
+
+std::string const usage_text =
+"Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph).\n"\
+"\n"\
+"am_bench_regression: run am_cellgen over a fixed corpus and compare timings against a baseline.\n"\
+"\n"\
+"usage: am_bench_regression -corpus <dir> [OPTIONS]\n"\
+"\n"\
+"the corpus consists of all *.swc files in <dir> and a fixed set of synthetic networks. per case, the wall time of\n"\
+"every stage, the peak resident set size, all counters (e.g. analysis jobs) and the sizes of all output meshes are\n"\
+"recorded.\n"\
+"\n"\
+"OPTIONS:\n"\
+"-work <dir>                     directory for inputs, outputs and logs of all cases. default: bench_work.\n"\
+"-o <file>                       JSON result file. default: <work>/results.json.\n"\
+"-baseline <file>                compare against a result file of a previous run. the exit status is non-zero if\n"\
+"                                any threshold is exceeded.\n"\
+"-threads <n>                    -ana-nthreads and -meshing-nthreads passed to am_cellgen. default: 1.\n"\
+"-repeat <n>                     run every case n times, times and RSS are the minimum over all runs. default: 3.\n"\
+"-case <name>                    only run the named case. may be given several times.\n"\
+"-threshold-time <f>             allowed relative increase of the wall time of each case and of its top-level stages.\n"\
+"                                deviations of nested stages are listed, but never fail the run. default: 0.25.\n"\
+"-min-time <s>                   wall time differences below s seconds are never reported. default: 0.1.\n"\
+"-threshold-rss <f>              allowed relative increase of the peak RSS. default: 0.1.\n"\
+"-threshold-count <f>            allowed relative change of counters and mesh sizes. default: 0.\n";
+
+/* a benchmark case: an SWC file from the corpus or a synthetic network, and additional am_cellgen arguments */
+struct BenchCase {
+    std::string                         name;
+    std::string                         swc;
+    bool                                synthetic;
+    SWCSynth::Parameters                synth;
+    std::vector<std::string>            args;
+};
+
+struct MeshSize {
+    std::string                         file;
+    uint64_t                            vertices;
+    uint64_t                            faces;
+};
+
+struct CaseResult {
+    std::string                         status;
+    double                              wall;
+    uint64_t                            peak_rss_kb;
+    std::vector<Profiling::StageRecord> stages;
+    std::vector<
+            std::pair<std::string, int64_t>
+        >                               counters;
+    std::vector<MeshSize>               meshes;
+
+    CaseResult() : status("ok"), wall(0.0), peak_rss_kb(0) {}
+};
+
+/* synthetic part of the corpus. these networks are meant to exercise the analysis on several cells and forced
+ * intersections, which makes them unclean, i.e. they are not meshed. */
+static std::vector<BenchCase>
+syntheticCases()
+{
+    std::vector<BenchCase> cases;
+    BenchCase c;
+    c.synthetic = true;
+
+    c.name                      = "synth_cell";
+    c.synth                     = SWCSynth::Parameters();
+    c.synth.seed                = 0;
+    cases.push_back(c);
+
+    c.name                      = "synth_network";
+    c.synth                     = SWCSynth::Parameters();
+    c.synth.seed                = 2;
+    c.synth.n_cells             = 8;
+    c.synth.density             = 2000.0;
+    cases.push_back(c);
+
+    c.name                      = "synth_intersections";
+    c.synth                     = SWCSynth::Parameters();
+    c.synth.seed                = 3;
+    c.synth.n_cells             = 2;
+    c.synth.density             = 20000.0;
+    c.synth.intersection_rate   = 0.5;
+    cases.push_back(c);
+
+    return cases;
+}
+
+/* all *.swc files in dir, sorted by name */
+static std::vector<BenchCase>
+corpusCases(std::string const &dir)
+{
+    std::vector<BenchCase> cases;
+
+    DIR *d = opendir(dir.c_str());
+    if (!d) {
+        throw("corpusCases(): can't open corpus directory.");
+    }
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        std::string f(e->d_name);
+        if (f.size() > 4 && f.compare(f.size() - 4, 4, ".swc") == 0) {
+            BenchCase c;
+            c.name      = f.substr(0, f.size() - 4);
+            c.swc       = dir + "/" + f;
+            c.synthetic = false;
+            cases.push_back(c);
+        }
+    }
+    closedir(d);
+
+    std::sort(cases.begin(), cases.end(), [] (BenchCase const &a, BenchCase const &b) -> bool { return a.name < b.name; });
+    return cases;
+}
+
+static bool
+copyFile(
+    std::string const &from,
+    std::string const &to)
+{
+    std::ifstream   in(from, std::ios::binary);
+    std::ofstream   out(to, std::ios::binary);
+    if (!in.is_open() || !out.is_open()) {
+        return false;
+    }
+    out << in.rdbuf();
+    return (bool)out;
+}
+
+/* count vertex and face lines of an obj file, false if it doesn't exist */
+static bool
+countObj(
+    std::string const  &filename,
+    MeshSize           &m)
+{
+    FILE *f = fopen(filename.c_str(), "r");
+    if (!f) {
+        return false;
+    }
+    char    line[256];
+    bool    line_start = true;
+    m.vertices  = 0;
+    m.faces     = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (line_start) {
+            if (line[0] == 'v' && line[1] == ' ') {
+                m.vertices++;
+            }
+            else if (line[0] == 'f' && line[1] == ' ') {
+                m.faces++;
+            }
+        }
+        line_start = (strchr(line, '\n') != NULL);
+    }
+    fclose(f);
+    return true;
+}
+
+/* body of the child process: run am_cellgen on work/<name>.swc and write the results line by line to out */
+static void
+runCaseChild(
+    BenchCase const    &c,
+    std::string const  &work,
+    uint32_t            nthreads,
+    FILE               *out)
+{
+    std::string const base = work + "/" + c.name;
+
+    /* am_cellgen is verbose, keep its output in a log file */
+    if (!freopen((base + ".log").c_str(), "w", stdout)) {
+        fprintf(out, "status no_log\n");
+        return;
+    }
+    dup2(fileno(stdout), fileno(stderr));
+
+    std::vector<std::string> args = {
+        "am_cellgen",
+        "-i",               base + ".swc",
+        "-profile-out",     base + "_profile.json",
+        "-ana-nthreads",    std::to_string(nthreads),
+        "-meshing-nthreads",std::to_string(nthreads)
+    };
+    args.insert(args.end(), c.args.begin(), c.args.end());
+
+    std::vector<char *> argv;
+    for (auto &a : args) {
+        argv.push_back(&a[0]);
+    }
+    argv.push_back(NULL);
+
+    int     rc;
+    double  t0 = Aux::Timing::doubletime();
+    try {
+        std::srand(0);
+        AnaMorph_cellgen am_cellgen(argv.size() - 1, argv.data());
+        rc = am_cellgen.run();
+    }
+    catch (...) {
+        rc = EXIT_FAILURE;
+    }
+    double  t1 = Aux::Timing::doubletime();
+    fflush(stdout);
+
+    std::vector<Profiling::StageRecord>                 stages;
+    std::vector<std::pair<std::string, int64_t>>        counters;
+    Profiling::snapshot(stages, counters);
+
+    fprintf(out, "status %s\n", (rc == EXIT_SUCCESS ? "ok" : "failed"));
+    fprintf(out, "wall %.6f\n", t1 - t0);
+    for (auto &s : stages) {
+        fprintf(out, "stage %llu %.6f %.6f %s\n", (unsigned long long)s.calls, s.wall, s.cpu, s.name.c_str());
+    }
+    for (auto &cnt : counters) {
+        fprintf(out, "counter %lld %s\n", (long long)cnt.second, cnt.first.c_str());
+    }
+    for (std::string suffix : { ".obj", "_post_processed.obj" }) {
+        MeshSize m;
+        if (countObj(base + suffix, m)) {
+            fprintf(out, "mesh %llu %llu %s\n", (unsigned long long)m.vertices, (unsigned long long)m.faces,
+                (c.name + suffix).c_str());
+        }
+    }
+}
+
+/* run one case in a forked child process. the child reports through a pipe, the peak RSS is taken from the child's
+ * resource usage. */
+static CaseResult
+runCase(
+    BenchCase const    &c,
+    std::string const  &work,
+    uint32_t            nthreads)
+{
+    std::string const base = work + "/" + c.name;
+
+    /* stale outputs of earlier runs must not be counted */
+    unlink((base + ".obj").c_str());
+    unlink((base + "_post_processed.obj").c_str());
+
+    int fd[2];
+    if (pipe(fd) != 0) {
+        throw("runCase(): can't create pipe.");
+    }
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        throw("runCase(): fork() failed.");
+    }
+    if (pid == 0) {
+        close(fd[0]);
+        FILE *out = fdopen(fd[1], "w");
+        runCaseChild(c, work, nthreads, out);
+        fclose(out);
+        _exit(0);
+    }
+
+    close(fd[1]);
+    CaseResult  res;
+    FILE       *in = fdopen(fd[0], "r");
+    char        line[4096];
+    bool        reported = false;
+
+    while (fgets(line, sizeof(line), in)) {
+        std::istringstream  ls(line);
+        std::string         key;
+        ls >> key;
+
+        if (key == "status") {
+            ls >> res.status;
+            reported = true;
+        }
+        else if (key == "wall") {
+            ls >> res.wall;
+        }
+        else if (key == "stage") {
+            Profiling::StageRecord s;
+            ls >> s.calls >> s.wall >> s.cpu >> s.name;
+            s.wall_max      = 0.0;
+            s.peak_rss_kb   = 0;
+            res.stages.push_back(s);
+        }
+        else if (key == "counter") {
+            std::pair<std::string, int64_t> cnt;
+            ls >> cnt.second >> cnt.first;
+            res.counters.push_back(cnt);
+        }
+        else if (key == "mesh") {
+            MeshSize m;
+            ls >> m.vertices >> m.faces >> m.file;
+            res.meshes.push_back(m);
+        }
+    }
+    fclose(in);
+
+    int             wstatus;
+    struct rusage   ru;
+    if (wait4(pid, &wstatus, 0, &ru) != pid) {
+        throw("runCase(): wait4() failed.");
+    }
+    if (!reported || !WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+        res.status = "crashed";
+    }
+    /* ru_maxrss is given in kB on linux, in bytes on mac os */
+#ifdef __APPLE__
+    res.peak_rss_kb = (uint64_t)ru.ru_maxrss / 1024;
+#else
+    res.peak_rss_kb = (uint64_t)ru.ru_maxrss;
+#endif
+
+    return res;
+}
+
+/* combine repeated runs: minimum of times and RSS, counts of the last run */
+static void
+mergeRepeat(
+    CaseResult         &acc,
+    CaseResult const   &r)
+{
+    acc.wall        = std::min(acc.wall, r.wall);
+    acc.peak_rss_kb = std::min(acc.peak_rss_kb, r.peak_rss_kb);
+    if (r.status != "ok") {
+        acc.status = r.status;
+    }
+    for (auto &s : r.stages) {
+        bool found = false;
+        for (auto &t : acc.stages) {
+            if (t.name == s.name) {
+                t.wall  = std::min(t.wall, s.wall);
+                t.cpu   = std::min(t.cpu, s.cpu);
+                found   = true;
+            }
+        }
+        if (!found) {
+            acc.stages.push_back(s);
+        }
+    }
+    acc.counters    = r.counters;
+    acc.meshes      = r.meshes;
+}
+
+static std::string
+jsonEscape(std::string const &s)
+{
+    std::string r;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            r += '\\';
+        }
+        r += c;
+    }
+    return r;
+}
+
+static bool
+writeResults(
+    std::string const                                              &filename,
+    std::vector<std::pair<std::string, CaseResult>> const          &results,
+    uint32_t                                                        nthreads,
+    uint32_t                                                        repeat)
+{
+    FILE *f = fopen(filename.c_str(), "w");
+    if (!f) {
+        return false;
+    }
+
+    fprintf(f, "{\n  \"info\": { \"threads\": %u, \"repeat\": %u },\n  \"cases\": {", nthreads, repeat);
+    for (size_t i = 0; i < results.size(); i++) {
+        CaseResult const &r = results[i].second;
+
+        fprintf(f, "%s\n    \"%s\": {\n", (i ? "," : ""), jsonEscape(results[i].first).c_str());
+        fprintf(f, "      \"status\": \"%s\",\n", r.status.c_str());
+        fprintf(f, "      \"wall\": %.6f,\n", r.wall);
+        fprintf(f, "      \"peak_rss_kb\": %llu,\n", (unsigned long long)r.peak_rss_kb);
+
+        fprintf(f, "      \"stages\": {");
+        for (size_t j = 0; j < r.stages.size(); j++) {
+            fprintf(f, "%s\n        \"%s\": { \"calls\": %llu, \"wall\": %.6f, \"cpu\": %.6f }", (j ? "," : ""),
+                jsonEscape(r.stages[j].name).c_str(), (unsigned long long)r.stages[j].calls, r.stages[j].wall,
+                r.stages[j].cpu);
+        }
+        fprintf(f, "%s},\n", (r.stages.empty() ? "" : "\n      "));
+
+        fprintf(f, "      \"counters\": {");
+        for (size_t j = 0; j < r.counters.size(); j++) {
+            fprintf(f, "%s\n        \"%s\": %lld", (j ? "," : ""), jsonEscape(r.counters[j].first).c_str(),
+                (long long)r.counters[j].second);
+        }
+        fprintf(f, "%s},\n", (r.counters.empty() ? "" : "\n      "));
+
+        fprintf(f, "      \"meshes\": {");
+        for (size_t j = 0; j < r.meshes.size(); j++) {
+            fprintf(f, "%s\n        \"%s\": { \"vertices\": %llu, \"faces\": %llu }", (j ? "," : ""),
+                jsonEscape(r.meshes[j].file).c_str(), (unsigned long long)r.meshes[j].vertices,
+                (unsigned long long)r.meshes[j].faces);
+        }
+        fprintf(f, "%s}\n    }", (r.meshes.empty() ? "" : "\n      "));
+    }
+    fprintf(f, "%s}\n}\n", (results.empty() ? "" : "\n  "));
+
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+/* minimal JSON reader for result files: all numbers are collected with their '/'-joined path of object keys (array
+ * elements are addressed by index), everything else is skipped. throws on malformed input. */
+class JsonFlattener {
+    private:
+        char const                     *p;
+        char const                     *end;
+        std::map<std::string, double>  &values;
+
+        void
+        skipWhitespace()
+        {
+            while (this->p < this->end && isspace((unsigned char)*this->p)) {
+                this->p++;
+            }
+        }
+
+        void
+        expect(char c)
+        {
+            this->skipWhitespace();
+            if (this->p >= this->end || *this->p != c) {
+                throw("JsonFlattener: malformed JSON.");
+            }
+            this->p++;
+        }
+
+        std::string
+        parseString()
+        {
+            std::string s;
+            this->expect('"');
+            while (this->p < this->end && *this->p != '"') {
+                if (*this->p == '\\' && this->p + 1 < this->end) {
+                    this->p++;
+                    switch (*this->p) {
+                        case 'n':   s += '\n'; break;
+                        case 't':   s += '\t'; break;
+                        case 'u':   this->p += 4; s += '?'; break;
+                        default:    s += *this->p;
+                    }
+                }
+                else {
+                    s += *this->p;
+                }
+                this->p++;
+            }
+            this->expect('"');
+            return s;
+        }
+
+        void
+        parseValue(std::string const &path)
+        {
+            this->skipWhitespace();
+            if (this->p >= this->end) {
+                throw("JsonFlattener: unexpected end of input.");
+            }
+
+            char const c = *this->p;
+            if (c == '{') {
+                this->p++;
+                this->skipWhitespace();
+                if (this->p < this->end && *this->p == '}') {
+                    this->p++;
+                    return;
+                }
+                while (true) {
+                    std::string key = this->parseString();
+                    this->expect(':');
+                    this->parseValue(path.empty() ? key : path + "/" + key);
+                    this->skipWhitespace();
+                    if (this->p < this->end && *this->p == ',') {
+                        this->p++;
+                        continue;
+                    }
+                    this->expect('}');
+                    return;
+                }
+            }
+            else if (c == '[') {
+                this->p++;
+                this->skipWhitespace();
+                if (this->p < this->end && *this->p == ']') {
+                    this->p++;
+                    return;
+                }
+                for (uint32_t i = 0; ; i++) {
+                    this->parseValue(path + "/" + std::to_string(i));
+                    this->skipWhitespace();
+                    if (this->p < this->end && *this->p == ',') {
+                        this->p++;
+                        continue;
+                    }
+                    this->expect(']');
+                    return;
+                }
+            }
+            else if (c == '"') {
+                this->parseString();
+            }
+            else if (c == 't' || c == 'f' || c == 'n') {
+                while (this->p < this->end && isalpha((unsigned char)*this->p)) {
+                    this->p++;
+                }
+            }
+            else {
+                std::string num;
+                while (this->p < this->end && strchr("+-0123456789.eE", *this->p)) {
+                    num += *this->p++;
+                }
+                if (num.empty()) {
+                    throw("JsonFlattener: malformed JSON.");
+                }
+                this->values[path] = std::stod(num);
+            }
+        }
+
+    public:
+        JsonFlattener(
+            std::string const               &text,
+            std::map<std::string, double>   &values)
+        :
+            p(text.data()),
+            end(text.data() + text.size()),
+            values(values)
+        {
+            this->parseValue("");
+        }
+};
+
+static std::map<std::string, double>
+readFlattenedJson(std::string const &filename)
+{
+    std::ifstream in(filename);
+    if (!in.is_open()) {
+        throw("readFlattenedJson(): can't open file.");
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+
+    std::map<std::string, double> values;
+    JsonFlattener(ss.str(), values);
+    return values;
+}
+
+static bool
+endsWith(
+    std::string const  &s,
+    std::string const  &suffix)
+{
+    return (s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+/* compare all wall times, peak RSS values, counters and mesh sizes of the cases present in both files. returns the
+ * number of threshold violations. only the wall times of whole cases and of top-level stages (names without '/') are
+ * gated, nested stages are short and too noisy for a fixed threshold and are listed for information only. */
+static uint32_t
+compareResults(
+    std::map<std::string, double> const    &base,
+    std::map<std::string, double> const    &cur,
+    double                                  threshold_time,
+    double                                  min_time,
+    double                                  threshold_rss,
+    double                                  threshold_count)
+{
+    uint32_t violations = 0;
+
+    printf("\n%-72s %14s %14s %9s\n", "metric", "baseline", "current", "change");
+    for (auto &b : base) {
+        std::string const &key = b.first;
+        if (key.compare(0, 6, "cases/") != 0 || endsWith(key, "/cpu") || endsWith(key, "/calls")) {
+            continue;
+        }
+
+        /* cases that have not been run this time are skipped */
+        std::string case_prefix = key.substr(0, key.find('/', 6) + 1);
+        if (cur.lower_bound(case_prefix) == cur.end() || cur.lower_bound(case_prefix)->first.compare(0, case_prefix.size(), case_prefix) != 0) {
+            continue;
+        }
+
+        auto c = cur.find(key);
+        if (c == cur.end()) {
+            printf("%-72s %14.6g %14s %9s  MISSING\n", key.c_str(), b.second, "-", "-");
+            violations++;
+            continue;
+        }
+
+        double const    bv      = b.second;
+        double const    cv      = c->second;
+        double const    rel     = (bv != 0.0) ? (cv - bv) / std::abs(bv) : (cv != 0.0 ? Aux::Numbers::inf<double>() : 0.0);
+        char const     *verdict = "";
+
+        if (endsWith(key, "/wall")) {
+            std::string const   stage_prefix    = case_prefix + "stages/";
+            bool const          gated           = (key.compare(0, stage_prefix.size(), stage_prefix) != 0 ||
+                key.find('/', stage_prefix.size()) == key.size() - 5);
+
+            if (cv - bv > min_time && rel > threshold_time) {
+                verdict = gated ? "SLOWER" : "slower";
+            }
+            else if (bv - cv > min_time && -rel > threshold_time) {
+                verdict = "faster";
+            }
+        }
+        else if (endsWith(key, "/peak_rss_kb")) {
+            if (rel > threshold_rss) {
+                verdict = "MORE MEMORY";
+            }
+        }
+        else if (std::abs(rel) > threshold_count) {
+            verdict = "CHANGED";
+        }
+
+        if (verdict[0] != '\0') {
+            printf("%-72s %14.6g %14.6g %+8.1f%%  %s\n", key.c_str(), bv, cv, rel * 100.0, verdict);
+            if (isupper((unsigned char)verdict[0])) {
+                violations++;
+            }
+        }
+    }
+
+    printf("\n%u threshold violation(s).\n", violations);
+    return violations;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string                 corpus, work = "bench_work", out, baseline;
+    std::vector<std::string>    only;
+    uint32_t                    nthreads        = 1;
+    uint32_t                    repeat          = 3;
+    double                      threshold_time  = 0.25;
+    double                      min_time        = 0.1;
+    double                      threshold_rss   = 0.1;
+    double                      threshold_count = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+
+        if (i + 1 >= argc) {
+            printf("%s", usage_text.c_str());
+            return EXIT_FAILURE;
+        }
+
+        try {
+            if (arg == "-corpus") {
+                corpus = argv[++i];
+            }
+            else if (arg == "-work") {
+                work = argv[++i];
+            }
+            else if (arg == "-o") {
+                out = argv[++i];
+            }
+            else if (arg == "-baseline") {
+                baseline = argv[++i];
+            }
+            else if (arg == "-case") {
+                only.push_back(argv[++i]);
+            }
+            else if (arg == "-threads") {
+                nthreads = Aux::Alg::stou(argv[++i]);
+            }
+            else if (arg == "-repeat") {
+                repeat = Aux::Alg::stou(argv[++i]);
+            }
+            else if (arg == "-threshold-time") {
+                threshold_time = std::stod(argv[++i]);
+            }
+            else if (arg == "-min-time") {
+                min_time = std::stod(argv[++i]);
+            }
+            else if (arg == "-threshold-rss") {
+                threshold_rss = std::stod(argv[++i]);
+            }
+            else if (arg == "-threshold-count") {
+                threshold_count = std::stod(argv[++i]);
+            }
+            else {
+                printf("%s", usage_text.c_str());
+                return EXIT_FAILURE;
+            }
+        }
+        catch (...) {
+            printf("ERROR: invalid argument for switch \"%s\".\n", arg.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (corpus.empty()) {
+        printf("%s", usage_text.c_str());
+        return EXIT_FAILURE;
+    }
+    if (nthreads == 0 || repeat == 0) {
+        printf("ERROR: number of threads and repetitions must be positive.\n");
+        return EXIT_FAILURE;
+    }
+    if (out.empty()) {
+        out = work + "/results.json";
+    }
+
+    try {
+        mkdir(work.c_str(), 0755);
+
+        std::vector<BenchCase> cases = corpusCases(corpus);
+        for (auto &c : syntheticCases()) {
+            cases.push_back(c);
+        }
+
+        std::vector<std::pair<std::string, CaseResult>> results;
+        for (auto &c : cases) {
+            if (!only.empty() && std::find(only.begin(), only.end(), c.name) == only.end()) {
+                continue;
+            }
+
+            /* every case reads its input from the work directory */
+            std::string const swc = work + "/" + c.name + ".swc";
+            if (c.synthetic) {
+                std::vector<SWCReader::Record<double>> records;
+                SWCSynth::generate(c.synth, records);
+                SWCSynth::write(swc, records);
+            }
+            else if (!copyFile(c.swc, swc)) {
+                printf("ERROR: can't copy \"%s\" to work directory.\n", c.swc.c_str());
+                return EXIT_FAILURE;
+            }
+
+            CaseResult res;
+            for (uint32_t k = 0; k < repeat; k++) {
+                printf("running case %-24s (%u of %u).. ", c.name.c_str(), k + 1, repeat);
+                fflush(stdout);
+
+                CaseResult r = runCase(c, work, nthreads);
+                if (k == 0) {
+                    res = r;
+                }
+                else {
+                    mergeRepeat(res, r);
+                }
+                printf("%s, %.3fs, %llu kB peak RSS.\n", r.status.c_str(), r.wall, (unsigned long long)r.peak_rss_kb);
+            }
+            results.push_back( { c.name, res } );
+        }
+
+        if (!writeResults(out, results, nthreads, repeat)) {
+            printf("ERROR: can't write result file \"%s\".\n", out.c_str());
+            return EXIT_FAILURE;
+        }
+        printf("results written to \"%s\".\n", out.c_str());
+
+        bool failed = false;
+        for (auto &r : results) {
+            failed = failed || (r.second.status != "ok");
+        }
+
+        if (!baseline.empty()) {
+            uint32_t violations = compareResults(
+                readFlattenedJson(baseline),
+                readFlattenedJson(out),
+                threshold_time,
+                min_time,
+                threshold_rss,
+                threshold_count);
+
+            failed = failed || (violations > 0);
+        }
+
+        return (failed ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+    catch (char const *err) {
+        printf("ERROR: %s\n", err);
+        return EXIT_FAILURE;
+    }
+    catch (...) {
+        printf("ERROR: main(): unhandled exception at top level.\n");
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,293 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/* benchmark for the neuron graph traversals on large synthetic neurite trees. compares
+ * CellNetwork::traverseBreadthFirst() with std::function predicates, the function template overload with inlined
+ * predicates and the CSR snapshot traversal. */
+
+#include "common.hh"
+
+#include "NLM_CellNetwork.hh"
+
+std::string const usage_text =
+"Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph).\n"\
+"\n"\
+"am_bench_traversal: benchmark neuron graph traversals on a synthetic neurite tree.\n"\
+"\n"\
+"usage: am_bench_traversal [-n <vertices>] [-b <branching probability>] [-r <repetitions>] [-seed <seed>]\n"\
+"\n"\
+"    -n      number of neurite vertices of the synthetic tree. default: 100000.\n"\
+"    -b      probability that a vertex is attached to a uniformly chosen earlier vertex instead of its predecessor.\n"\
+"            0 yields a single chain, 1 a random recursive tree. default: 0.05.\n"\
+"    -r      number of repetitions of every traversal. default: 5.\n"\
+"    -seed   seed of the random number generator. default: 0.\n";
+
+typedef NLM_CellNetwork<double> CellNetworkType;
+
+/* write a synthetic single cell to an SWC file: a soma at the origin and a neurite tree with n vertices, in which
+ * every vertex continues its predecessor with probability 1 - b and branches off a random earlier vertex otherwise. */
+static void
+writeSyntheticTree(
+    std::string const  &filename,
+    uint32_t            n,
+    double              b,
+    uint32_t            seed)
+{
+    std::mt19937                            rng(seed);
+    std::uniform_real_distribution<double>  U(0.0, 1.0);
+    std::normal_distribution<double>        N(0.0, 1.0);
+
+    std::vector<Vec3<double>>               pos(n + 2);
+
+    FILE *f = fopen(filename.c_str(), "w");
+    if (!f) {
+        throw("writeSyntheticTree(): can't open output file.");
+    }
+
+    pos[1] = Vec3<double>(0, 0, 0);
+    fprintf(f, "1 1 0 0 0 10 -1\n");
+
+    for (uint32_t i = 2; i < n + 2; i++) {
+        uint32_t parent = i - 1;
+        if (i > 2 && U(rng) < b) {
+            parent = 2 + (uint32_t)(U(rng) * (i - 2));
+            parent = std::min(parent, i - 1);
+        }
+
+        /* first neurite vertex leaves the soma sphere, all others are random unit steps */
+        Vec3<double> d(N(rng), N(rng), N(rng));
+        d.normalize();
+        pos[i] = pos[parent] + d * ((i == 2) ? 20.0 : 1.0);
+
+        fprintf(f, "%u 3 %.6f %.6f %.6f 0.2 %u\n", i, pos[i][0], pos[i][1], pos[i][2], parent);
+    }
+    fclose(f);
+}
+
+/* run fn r times, return the minimum time in seconds */
+template <typename F>
+static double
+timeMin(
+    uint32_t    r,
+    F const    &fn)
+{
+    double best = Aux::Numbers::inf<double>();
+    for (uint32_t k = 0; k < r; k++) {
+        double t0 = Aux::Timing::doubletime();
+        fn();
+        best = std::min(best, Aux::Timing::doubletime() - t0);
+    }
+    return best;
+}
+
+static void
+report(
+    char const *name,
+    double      t,
+    size_t      nvisited)
+{
+    printf("%-40s %10.3f ms %12.3f Mvertices/s (%zu vertices)\n", name, t * 1E3, nvisited / t * 1E-6, nvisited);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t    n       = 100000;
+    double      b       = 0.05;
+    uint32_t    r       = 5;
+    uint32_t    seed    = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+
+        try {
+            if (arg == "-n" && i + 1 < argc) {
+                n = Aux::Alg::stou(argv[++i]);
+            }
+            else if (arg == "-b" && i + 1 < argc) {
+                b = std::stod(argv[++i]);
+            }
+            else if (arg == "-r" && i + 1 < argc) {
+                r = Aux::Alg::stou(argv[++i]);
+            }
+            else if (arg == "-seed" && i + 1 < argc) {
+                seed = Aux::Alg::stou(argv[++i]);
+            }
+            else {
+                printf("%s", usage_text.c_str());
+                return EXIT_FAILURE;
+            }
+        }
+        catch (...) {
+            printf("ERROR: invalid argument for switch \"%s\".\n", arg.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (n == 0 || r == 0 || b < 0 || b > 1) {
+        printf("ERROR: number of vertices and repetitions must be positive, branching probability in [0, 1].\n");
+        return EXIT_FAILURE;
+    }
+
+    try {
+        char tmpname[] = "/tmp/am_bench_traversal_XXXXXX";
+        int fd = mkstemp(tmpname);
+        if (fd < 0) {
+            printf("ERROR: can't create temporary file.\n");
+            return EXIT_FAILURE;
+        }
+        close(fd);
+
+        writeSyntheticTree(tmpname, n, b, seed);
+
+        CellNetworkType C("bench");
+        C.readFromNeuroMorphoSWCFile(tmpname);
+        unlink(tmpname);
+
+        typedef CellNetworkType::NeuronVertex      NeuronVertex;
+        typedef CellNetworkType::NeuronEdge        NeuronEdge;
+        typedef CellNetworkType::NeuriteVertex     NeuriteVertex;
+        typedef CellNetworkType::NeuriteSegment    NeuriteSegment;
+
+        CellNetworkType::neurite_iterator r_it = C.neurite_vertices.begin();
+
+        printf("synthetic tree: %zu neuron vertices, %zu neuron edges, branching probability %.3f\n",
+            C.neuron_vertices.size(), C.neuron_edges.size(), b);
+
+        /* undirected traversal of the neurite connected component with std::function predicates */
+        std::list<std::tuple<NeuriteVertex *, std::list<NeuronVertex *>, double>>   vinfo;
+        std::list<NeuriteSegment *>                                                 einfo;
+
+        /* NeuronVertex::getType() / NeuronEdge::getType() are not public, filter neurite vertices / segments by type */
+        auto neurite_vertex_pred    = [] (NeuronVertex const &v) -> bool
+            {
+                return (dynamic_cast<NeuriteVertex const *>(&v) != nullptr);
+            };
+
+        auto neurite_segment_pred   = [] (NeuronEdge const &e) -> bool
+            {
+                return (dynamic_cast<NeuriteSegment const *>(&e) != nullptr);
+            };
+
+        auto vertex_true_pred       = [] (NeuriteVertex const &v) -> bool { return true; };
+        auto vertex_false_pred      = [] (NeuriteVertex const &v) -> bool { return false; };
+        auto segment_true_pred      = [] (NeuriteSegment const &e) -> bool { return true; };
+        auto segment_false_pred     = [] (NeuriteSegment const &e) -> bool { return false; };
+
+        double t = timeMin(r, [&] () -> void
+            {
+                vinfo.clear();
+                einfo.clear();
+                C.traverseBreadthFirst<NeuriteVertex, NeuriteSegment>(
+                    r_it, false, false, vinfo, einfo,
+                    std::function<bool(NeuronVertex const &)>(neurite_vertex_pred),
+                    std::function<bool(NeuronEdge const &)>(neurite_segment_pred),
+                    std::function<bool(NeuriteVertex const &)>(vertex_true_pred),
+                    std::function<bool(NeuriteSegment const &)>(segment_true_pred),
+                    std::function<bool(NeuriteVertex const &)>(vertex_false_pred),
+                    std::function<bool(NeuriteSegment const &)>(segment_false_pred));
+            });
+        report("traverseBreadthFirst, std::function", t, vinfo.size());
+
+        /* same traversal with inlined predicates */
+        t = timeMin(r, [&] () -> void
+            {
+                vinfo.clear();
+                einfo.clear();
+                C.traverseBreadthFirst<NeuriteVertex, NeuriteSegment>(
+                    r_it, false, false, vinfo, einfo,
+                    neurite_vertex_pred, neurite_segment_pred,
+                    vertex_true_pred, segment_true_pred,
+                    vertex_false_pred, segment_false_pred);
+            });
+        report("traverseBreadthFirst, templated", t, vinfo.size());
+
+        /* CSR snapshot: build time and traversal */
+        CellNetworkCSR<double> csr;
+        t = timeMin(r, [&] () -> void
+            {
+                csr = C.getCSRSnapshot();
+            });
+        report("getCSRSnapshot", t, csr.numVertices());
+
+        CellNetworkCSR<double>::Workspace   ws;
+        size_t                              nvisited = 0;
+        uint32_t const                      r_idx    = csr.getVertexIndex(r_it->id());
+
+        t = timeMin(r, [&] () -> void
+            {
+                nvisited = 0;
+                csr.traverseBreadthFirst(r_idx, false,
+                    [&csr] (uint32_t v) -> bool
+                    {
+                        uint32_t const t = csr.vertex(v).type;
+                        return (t == CellNetworkType::AXON_VERTEX || t == CellNetworkType::DENDRITE_VERTEX);
+                    },
+                    [&csr] (uint32_t e) -> bool
+                    {
+                        uint32_t const t = csr.edge(e).type;
+                        return (t == CellNetworkType::AXON_SEGMENT || t == CellNetworkType::DENDRITE_SEGMENT);
+                    },
+                    [&nvisited] (uint32_t v, uint32_t depth, double dist) -> bool
+                    {
+                        nvisited++;
+                        return true;
+                    },
+                    ws);
+            });
+        report("CellNetworkCSR::traverseBreadthFirst", t, nvisited);
+    }
+    catch (const char *err) {
+        printf("ERROR: caught string err: %s\n", err);
+        return EXIT_FAILURE;
+    }
+    catch (std::string &err) {
+        printf("ERROR: caught string err: %s\n", err.c_str());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -87,6 +87,7 @@ class AnaMorph_cellgen : private CLApplication {
         uint32_t            ana_nthreads;
         double              ana_univar_solver_eps;
         double              ana_bivar_solver_eps;
+        bool                ana_cache;
 
         bool                meshing;
         bool                force_meshing;
@@ -94,10 +95,15 @@ class AnaMorph_cellgen : private CLApplication {
 
         bool                meshing_flush;
         uint32_t            meshing_flush_face_limit;
+        uint32_t            meshing_mem_budget;
+        uint32_t            meshing_nthreads;
 
         uint32_t            meshing_n_soma_refs;
         double              scale_radius;
         uint32_t            meshing_canal_segment_n_phi_segments;
+        std::vector<
+                uint32_t
+            >               meshing_lods;
         uint32_t            meshing_outer_loop_maxiter;
         uint32_t            meshing_inner_loop_maxiter;
 
@@ -124,6 +130,33 @@ class AnaMorph_cellgen : private CLApplication {
         double              pp_hc_beta;
         uint32_t            pp_hc_maxiter;
 
+        std::string         batch_input;
+        std::string         batch_report;
+        uint32_t            batch_nthreads;
+
+        std::string         profile_out;
+        std::string         trace_out;
+
+        /* strip supported extensions from a network name. returns false if the extension is not supported. */
+        bool                stripNetworkNameExtension(std::string &name) const;
+
+        /* key for the binary cell network cache (-ana-cache) of a network: hash of the SWC file's size and
+         * modification time and all parameters applied before the cache is written. returns false if the SWC file
+         * can't be stat()ed. */
+        bool                getCacheKey(
+                                std::string const  &swc_filename,
+                                uint64_t           &key) const;
+
+        /* full pipeline (analysis, meshing, post-processing) for a single cell network. paths of all written output
+         * files are appended to outputs. returns false iff the analysis found the network to be unclean. */
+        bool                processNetwork(
+                                std::string const          &name,
+                                std::vector<std::string>   &outputs) const;
+
+        /* batch mode: process all networks listed in / contained in batch_input with batch_nthreads workers */
+        bool                collectBatchNetworkNames(std::vector<std::string> &names) const;
+        int                 runBatch();
+
                             AnaMorph_cellgen(AnaMorph_cellgen const &) = delete;
                             AnaMorph_cellgen(AnaMorph_cellgen const &&) = delete;
         AnaMorph_cellgen   &operator=(AnaMorph_cellgen const &) = delete;
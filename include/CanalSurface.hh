@@ -269,6 +269,58 @@ class LinearRadiusInterpolatorDomain {
 };
 #endif
 
+/*! \brief unit-circle offsets for canal surface ring generation.
+ *
+ * the angular offset phi_0 and the number of angular segments are constant along a neurite path, hence the cos / sin
+ * values of the ring vertices only depend on whether a ring is offset by dphi / 2 or not. both variants are computed
+ * once and shared by all canal segments and the terminal half-sphere of a path, ring construction then reduces to a
+ * small fused kernel p + r*(cos * py + sin * pz). additionally counts the number of triangles generated with the
+ * cache (quads count as two). */
+template <typename R>
+class CanalSurfaceRingCache {
+    private:
+        uint32_t                        n_phi_segments;
+        R                               phi_0;
+
+        /* index 0: offset phi_0, index 1: offset phi_0 + dphi / 2 */
+        std::vector<R>                  cos_phi[2];
+        std::vector<R>                  sin_phi[2];
+
+        uint64_t                        ntriangles;
+
+    public:
+                                        CanalSurfaceRingCache(
+                                            uint32_t    n_phi_segments,
+                                            R const    &phi_0);
+
+        /*! \brief returns true iff the cache has been built for the given segment count and angular offset. */
+        bool                            matches(
+                                            uint32_t    n_phi_segments,
+                                            R const    &phi_0) const;
+
+        uint32_t                        getNPhiSegments() const;
+        R                               getPhi0() const;
+
+        /*! \brief insert the n_phi_segments vertices of the ring with centre p, radius r and frame vectors py, pz
+         * into M and store their iterators in ring, which must have size n_phi_segments. */
+        template <typename Tm, typename Tv, typename Tf>
+        void                            appendRing(
+                                            Mesh<Tm, Tv, Tf, R>                                    &M,
+                                            Vec3<R> const                                          &p,
+                                            Vec3<R> const                                          &py,
+                                            Vec3<R> const                                          &pz,
+                                            R const                                                &r,
+                                            bool                                                    offset,
+                                            std::vector<
+                                                    typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
+                                                >                                                  &ring) const;
+
+        void                            countTriangles(uint64_t n);
+
+        /*! \brief return the number of triangles counted since the last call and reset the count. */
+        uint64_t                        takeTriangleCount();
+};
+
 /*! @brief Canal Surface Class
  *
  * detailed Canal Surface class description */
@@ -372,7 +424,8 @@ class CanalSurface {
                                                     typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
                                                 >                                                  *end_circle_its          = NULL,
                                             typename Mesh<Tm, Tv, Tf, R>::vertex_iterator          *closing_vertex_it       = NULL,
-                                            bool                                                    preserve_crease_edges   = false) const ;
+                                            bool                                                    preserve_crease_edges   = false,
+                                            CanalSurfaceRingCache<R>                               *ring_cache              = NULL) const ;
 };
 
 #if 0
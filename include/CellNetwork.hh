@@ -49,6 +49,11 @@
 
 #include "common.hh"
 #include "Graph.hh"
+#include "CellNetworkCache.hh"
+#include "CellNetworkCSR.hh"
+#include "KdTree.hh"
+#include "Profiling.hh"
+#include "SWCReader.hh"
 
 template <
     typename Tn,
@@ -1316,6 +1321,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                neuron_iterator &
+                operator=(neuron_iterator const &) = default;
+
                ~neuron_iterator()
                {
                }
@@ -1396,6 +1404,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                neuron_const_iterator &
+                operator=(neuron_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 neuron_const_iterator(neuron_iterator const &x)
@@ -1495,6 +1506,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                soma_iterator &
+                operator=(soma_iterator const &) = default;
+
                ~soma_iterator()
                {
                }
@@ -1541,6 +1555,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                soma_const_iterator &
+                operator=(soma_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 soma_const_iterator(soma_iterator const &x)
@@ -1606,6 +1623,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                neurite_iterator &
+                operator=(neurite_iterator const &) = default;
+
                ~neurite_iterator()
                {
                }
@@ -1670,6 +1690,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                neurite_const_iterator &
+                operator=(neurite_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 neurite_const_iterator(neurite_iterator const &x)
@@ -1753,6 +1776,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                axon_iterator &
+                operator=(axon_iterator const &) = default;
+
                ~axon_iterator()
                {
                }
@@ -1799,6 +1825,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                axon_const_iterator &
+                operator=(axon_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 axon_const_iterator(axon_iterator const &x)
@@ -1864,6 +1893,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                dendrite_iterator &
+                operator=(dendrite_iterator const &) = default;
+
                ~dendrite_iterator()
                {
                }
@@ -1910,6 +1942,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                dendrite_const_iterator &
+                operator=(dendrite_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 dendrite_const_iterator(dendrite_iterator const &x)
@@ -1979,6 +2014,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                neuron_edge_iterator &
+                operator=(neuron_edge_iterator const &) = default;
+
                ~neuron_edge_iterator()
                {
                }
@@ -2076,6 +2114,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                neuron_edge_const_iterator &
+                operator=(neuron_edge_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 neuron_edge_const_iterator(neuron_edge_iterator const &x)
@@ -2184,6 +2225,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                neurite_rootedge_iterator &
+                operator=(neurite_rootedge_iterator const &) = default;
+
                ~neurite_rootedge_iterator()
                 {
                 }
@@ -2248,6 +2292,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                neurite_rootedge_const_iterator &
+                operator=(neurite_rootedge_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 neurite_rootedge_const_iterator(neurite_rootedge_iterator const &x)
@@ -2331,6 +2378,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                axon_rootedge_iterator &
+                operator=(axon_rootedge_iterator const &) = default;
+
                ~axon_rootedge_iterator()
                {
                }
@@ -2377,6 +2427,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                axon_rootedge_const_iterator &
+                operator=(axon_rootedge_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 axon_rootedge_const_iterator(axon_rootedge_iterator const &x)
@@ -2442,6 +2495,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                dendrite_rootedge_iterator &
+                operator=(dendrite_rootedge_iterator const &) = default;
+
                ~dendrite_rootedge_iterator()
                {
                }
@@ -2488,6 +2544,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                dendrite_rootedge_const_iterator &
+                operator=(dendrite_rootedge_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 dendrite_rootedge_const_iterator(dendrite_rootedge_iterator const &x)
@@ -2553,6 +2612,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                neurite_segment_iterator &
+                operator=(neurite_segment_iterator const &) = default;
+
                ~neurite_segment_iterator()
                {
                }
@@ -2634,6 +2696,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                neurite_segment_const_iterator &
+                operator=(neurite_segment_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 neurite_segment_const_iterator(neurite_segment_iterator const &x)
@@ -2726,6 +2791,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                axon_segment_iterator &
+                operator=(axon_segment_iterator const &) = default;
+
                ~axon_segment_iterator()
                {
                }
@@ -2772,6 +2840,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                axon_segment_const_iterator &
+                operator=(axon_segment_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 axon_segment_const_iterator(axon_segment_iterator const &x)
@@ -2837,6 +2908,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                dendrite_segment_iterator &
+                operator=(dendrite_segment_iterator const &) = default;
+
                ~dendrite_segment_iterator()
                {
                }
@@ -2883,6 +2957,9 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                 {
                 }
 
+                dendrite_segment_const_iterator &
+                operator=(dendrite_segment_const_iterator const &) = default;
+
                 /* provide copy constructor with non-const argument to allow implicit conversion of non-const to const
                  * iterator */
                 dendrite_segment_const_iterator(dendrite_segment_iterator const &x)
@@ -3526,6 +3603,11 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
             R       neuron_vertices_dist_avg;
             R       neuron_vertices_dist_sigma;
 
+            R       neuron_vertices_nn_dist_min;
+            R       neuron_vertices_nn_dist_max;
+            R       neuron_vertices_nn_dist_avg;
+            R       neuron_vertices_nn_dist_sigma;
+
             R       neuron_vertices_xmin;
             R       neuron_vertices_xmax;
             R       neuron_vertices_xavg;
@@ -3611,7 +3693,42 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
          *  as types and the trivial predicates (which just return true). these defaults result in a normal traversal of
          *  the entire CellNetwork, where all vertex neighbours / edges being are considered. choosing vertex / edge
          *  types further down the hierarchy and choosing specialized predicates will result in increasing filtering and
-         *  different behaviour. */
+         *  different behaviour.
+         *
+         *  NOTE: the predicates may be arbitrary callables with the signatures of the std::function overload below.
+         *  they are inlined into the traversal loop, which is considerably faster than calling them through
+         *  std::function. paths are only assembled if return_paths is true. */
+        template <
+            typename VertexType = NeuronVertex,
+            typename EdgeType   = NeuronEdge,
+            typename VertexPred,
+            typename EdgePred,
+            typename VertexSelectionPred,
+            typename EdgeSelectionPred,
+            typename VertexTerminationPred,
+            typename EdgeTerminationPred
+        >
+        void                                        traverseBreadthFirst(
+                                                        neuron_iterator                                     vstart_it,
+                                                        bool const                                         &directed,
+                                                        bool const                                         &return_paths,
+                                                        std::list<
+                                                                std::tuple<
+                                                                    VertexType *,
+                                                                    std::list<NeuronVertex *>,
+                                                                    R
+                                                                >
+                                                            >                                              &reachable_vertices_info,
+                                                        std::list<EdgeType *>                              &reachable_edges,
+                                                        VertexPred const                                   &vertex_pred,
+                                                        EdgePred const                                     &edge_pred,
+                                                        VertexSelectionPred const                          &vertex_selection_pred,
+                                                        EdgeSelectionPred const                            &edge_selection_pred,
+                                                        VertexTerminationPred const                        &vertex_termination_pred,
+                                                        EdgeTerminationPred const                          &edge_termination_pred,
+                                                        int32_t                                             tid_arg = -1);
+
+        /* std::function overload of traverseBreadthFirst(), a thin wrapper around the function template above. */
         template <typename VertexType = NeuronVertex, typename EdgeType = NeuronEdge>
         void                                        traverseBreadthFirst(
                                                         neuron_iterator                                     vstart_it,
@@ -3643,6 +3760,10 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
                                                         bool                                          (&edge_termination_pred)(EdgeType const &e),
 #endif
 
+        /* build an immutable CSR snapshot of the neuron graph. vertex / edge types in the snapshot are the values of
+         * NeuronVertexTypes / NeuronEdgeTypes. */
+        CellNetworkCSR<R>                           getCSRSnapshot() const;
+
         /* get both integral depth (graph-theoretic depth) and chord-depth (chord-length of longest path to a neurite
          * leaf) of neurite sub-tree rooted in neurite vertex n_it */
         std::pair<uint32_t, R>                      getNeuriteSubTreeDepths(neurite_iterator n_it);
@@ -3669,12 +3790,23 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
         /* get morphological diameter of cell rooted with soma vertex referred to by iterator sit */
         R                                           getMorphologicalDiameter(soma_iterator s_it);
 
+        /* min / max / avg / sigma of the distances of all pairs of neuron vertices in O(n) memory. min / max are
+         * exact and take O(n log n) time. avg / sigma are exact for up to 4096 vertices, larger networks use an
+         * estimate from 2^22 randomly drawn pairs, which keeps the time linear in n. */
         void                                        getNeuronVerticesDistanceStat(
                                                         R  &v_dist_min,
                                                         R  &v_dist_max,
                                                         R  &v_dist_avg,
                                                         R  &v_dist_sigma) const;
 
+        /* min / max / avg / sigma of the distance of each neuron vertex to its nearest other neuron vertex, computed
+         * with a k-d tree in O(n log n) */
+        void                                        getNeuronVerticesNearestNeighbourStat(
+                                                        R  &nn_dist_min,
+                                                        R  &nn_dist_max,
+                                                        R  &nn_dist_avg,
+                                                        R  &nn_dist_sigma) const;
+
         void                                        getNeuronVerticesCoordinateStat(
                                                         R  &v_xmin,
                                                         R  &v_xmax,
@@ -3735,10 +3867,30 @@ class CellNetwork : public Graph<Tn, Tv, Te> {
 
         Vec3<R>                                     getGlobalCoordinateDisplacement() const;
         /* -----------------------------------  I / O  ------------------------------------------------------------- */
-        /* initialize network from standardized SWC file as used by NeuroMorpho.org */
+        /* initialize network from standardized SWC file as used by NeuroMorpho.org. the file is memory-mapped and
+         * parsed in line-aligned chunks by nthreads threads. */
         void                                        readFromNeuroMorphoSWCFile(
                                                         std::string     filename,
-                                                        bool const     &check_coincident_positions = false);
+                                                        bool const     &check_coincident_positions = false,
+                                                        uint32_t        nthreads = 1);
+
+        /* write / read binary cache of the network topology and geometry, see CellNetworkCache.hh for the layout.
+         * readBinaryCache() must be called on an empty network and returns false if the file can't be opened, is
+         * malformed or has been written with a different key, in which case the network remains empty. */
+        void                                        writeBinaryCache(
+                                                        std::string     filename,
+                                                        uint64_t        key) const;
+
+        bool                                        readBinaryCache(
+                                                        std::string     filename,
+                                                        uint64_t        key);
+
+    private:
+        /* insert all records of a cache file with validated header and size. throws on malformed records, leaving the
+         * network partially filled. */
+        void                                        readBinaryCacheRecords(
+                                                        char const                         *data,
+                                                        CellNetworkCache::Header const     &header);
 };
 
 #include "../tsrc/CellNetwork_impl.hh"
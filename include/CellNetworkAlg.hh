@@ -48,6 +48,7 @@
 #define CELL_NETWORK_ALG_HH
 
 #include "CellNetwork.hh"
+#include "Profiling.hh"
 
 namespace CellNetworkAlg {
     template <
@@ -60,7 +61,8 @@ namespace CellNetworkAlg {
         CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr>  &C,
         R const                                                                    &alpha,
         R const                                                                    &beta,
-        R const                                                                    &gamma);
+        R const                                                                    &gamma,
+        uint32_t                                                                   nthreads = 1);
 
     template <typename network_type, typename R = double>
     void scale_radii(network_type& C, const R& scale);
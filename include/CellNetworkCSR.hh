@@ -0,0 +1,191 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef CELL_NETWORK_CSR_HH
+#define CELL_NETWORK_CSR_HH
+
+#include "common.hh"
+
+#include "Vec3.hh"
+
+/*! \brief immutable compressed sparse row (CSR) snapshot of the neuron graph of a CellNetwork, built with
+ * CellNetwork::getCSRSnapshot(). vertices and edges are stored in flat arrays ordered by ascending id of the original
+ * network and are referred to by their index. the out- and in-edges of every vertex are stored contiguously in two
+ * index arrays, again in ascending edge id order, so that all traversals visit neighbours in the same order as
+ * CellNetwork::traverseBreadthFirst().
+ *
+ * the traversal algorithms are function templates: predicates and visitors are arbitrary callables taking vertex /
+ * edge indices and are inlined into the traversal loops. a snapshot does not track later modifications of the
+ * network it has been built from. */
+template <typename R>
+class CellNetworkCSR {
+    public:
+        static uint32_t const           invalid_index = std::numeric_limits<uint32_t>::max();
+
+        struct Vertex {
+            uint32_t                    id;
+            uint32_t                    type;
+            Vec3<R>                     pos;
+        };
+
+        struct Edge {
+            uint32_t                    id;
+            uint32_t                    type;
+            uint32_t                    src;
+            uint32_t                    dst;
+            R                           length;
+        };
+
+        /*! \brief scratch space for traversals. visited marks are epoch stamps, so that one workspace can be reused
+         * for many traversals of small sub-graphs without clearing O(n) memory every time. a workspace must not be
+         * shared between concurrently running traversals. */
+        class Workspace {
+            friend class CellNetworkCSR<R>;
+
+            private:
+                struct Item {
+                    uint32_t            v;
+                    uint32_t            depth;
+                    R                   dist;
+                };
+
+                std::vector<uint32_t>   mark;
+                uint32_t                epoch;
+                std::vector<Item>       items;
+
+                void                    reset(uint32_t n);
+
+            public:
+                                        Workspace();
+        };
+
+    private:
+        std::vector<Vertex>             vertices;
+        std::vector<Edge>               edges;
+
+        std::vector<uint32_t>           out_offsets;
+        std::vector<uint32_t>           out_edges;
+        std::vector<uint32_t>           in_offsets;
+        std::vector<uint32_t>           in_edges;
+
+        template <typename VertexPred, typename EdgePred, typename F>
+        void                            forEachNeighbour(
+                                            uint32_t                v,
+                                            bool                    directed,
+                                            VertexPred const       &vertex_pred,
+                                            EdgePred const         &edge_pred,
+                                            F const                &f) const;
+
+    public:
+                                        CellNetworkCSR();
+
+        /*! \brief build snapshot from vertices and edges, both sorted by ascending id. edge endpoints are vertex
+         * indices. */
+                                        CellNetworkCSR(
+                                            std::vector<Vertex>    &&vertices,
+                                            std::vector<Edge>      &&edges);
+
+        uint32_t                        numVertices() const;
+        uint32_t                        numEdges() const;
+
+        Vertex const                   &vertex(uint32_t v) const;
+        Edge const                     &edge(uint32_t e) const;
+
+        /*! \brief index of the vertex with the given id, invalid_index if there is none. O(log n). */
+        uint32_t                        getVertexIndex(uint32_t id) const;
+
+        uint32_t                        getOutDegree(uint32_t v) const;
+        uint32_t                        getInDegree(uint32_t v) const;
+
+        /*! \brief breadth-first traversal starting from vertex start. a neighbour nb of the currently visited vertex
+         * connected by edge e is considered only if edge_pred(e) and vertex_pred(nb) both return true. for each
+         * reached vertex v, visit(v, depth, dist) is called with the number of edges and the sum of edge lengths of
+         * the traversal path from start to v. the traversal terminates as soon as visit() returns false. if directed
+         * is false, in-edges are followed as well as out-edges. */
+        template <typename VertexPred, typename EdgePred, typename Visitor>
+        void                            traverseBreadthFirst(
+                                            uint32_t                start,
+                                            bool                    directed,
+                                            VertexPred const       &vertex_pred,
+                                            EdgePred const         &edge_pred,
+                                            Visitor const          &visit,
+                                            Workspace              &ws) const;
+
+        /*! \brief depth-first (pre-order) traversal with the same semantics as traverseBreadthFirst(). the
+         * neighbours of each vertex are visited in ascending edge id order. */
+        template <typename VertexPred, typename EdgePred, typename Visitor>
+        void                            traverseDepthFirst(
+                                            uint32_t                start,
+                                            bool                    directed,
+                                            VertexPred const       &vertex_pred,
+                                            EdgePred const         &edge_pred,
+                                            Visitor const          &visit,
+                                            Workspace              &ws) const;
+
+        /*! \brief integral depth (number of edges) and chord depth (path length) of the longest directed path
+         * starting in vertex root, as in CellNetwork::getNeuriteSubTreeDepths(). */
+        template <typename VertexPred, typename EdgePred>
+        std::pair<uint32_t, R>          getSubTreeDepths(
+                                            uint32_t                root,
+                                            VertexPred const       &vertex_pred,
+                                            EdgePred const         &edge_pred,
+                                            Workspace              &ws) const;
+
+        /*! \brief vertex of maximum undirected path length from start (the first one found in breadth-first order in
+         * case of ties) and its path length. */
+        template <typename VertexPred, typename EdgePred>
+        std::pair<uint32_t, R>          getFarthestVertex(
+                                            uint32_t                start,
+                                            VertexPred const       &vertex_pred,
+                                            EdgePred const         &edge_pred,
+                                            Workspace              &ws) const;
+};
+
+#include "../tsrc/CellNetworkCSR_impl.hh"
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CELL_NETWORK_CACHE_HH
+#define CELL_NETWORK_CACHE_HH
+
+#include "common.hh"
+
+/* on-disk layout of the binary cell network cache written by CellNetwork::writeBinaryCache(). the file consists of a
+ * Header followed by four flat arrays (vertices, edges, sections, section edges), all of which are plain old data with
+ * sizes that are multiples of 8 bytes. a cache file can thus be mapped into memory and accessed in place. vertex and
+ * edge indices refer to positions in the respective arrays, which are ordered by ascending id of the original network.
+ * all files are written in host byte order and are not meant to be exchanged between machines. */
+namespace CellNetworkCache {
+    uint32_t const  magic           = 0x4e434d41;   /* "AMCN" */
+    uint32_t const  version         = 2;
+    uint32_t const  invalid_index   = std::numeric_limits<uint32_t>::max();
+    uint64_t const  hash_seed       = 0xcbf29ce484222325ull;
+
+    struct Header {
+        uint32_t                magic;
+        uint32_t                version;
+        uint32_t                real_size;
+        uint32_t                network_info_initialized;
+
+        /* key supplied by the client, typically a hash of the input file and all parameters that influenced the
+         * cached network. a cache with a different key is considered stale. */
+        uint64_t                key;
+
+        /* hash() of all records following the header, starting from hash_seed */
+        uint64_t                checksum;
+
+        uint32_t                nvertices;
+        uint32_t                nedges;
+        uint32_t                nsections;
+        uint32_t                nsection_edges;
+
+        double                  global_coordinate_displacement[3];
+        double                  global_coordinate_scaling_factor;
+    };
+
+    struct VertexRecord {
+        uint32_t                type;
+        uint32_t                apical_dendrite;
+
+        /* soma vertex index / neurite root edge index of neurite vertices, valid if the network info has been
+         * initialized at the time of writing */
+        uint32_t                soma;
+        uint32_t                neurite;
+
+        /* range of NeuronVertex::sections in the section array */
+        uint32_t                sections_begin;
+        uint32_t                nsections;
+
+        /* somas only: section graph vertices, edges and root vertex. section graph edges refer to section graph
+         * vertices relative to section_graph_begin. */
+        uint32_t                section_graph_begin;
+        uint32_t                section_graph_nvertices;
+        uint32_t                section_graph_edges_begin;
+        uint32_t                section_graph_nedges;
+        uint32_t                section_graph_root;
+        uint32_t                padding;
+    };
+
+    struct EdgeRecord {
+        uint32_t                type;
+        uint32_t                src;
+        uint32_t                dst;
+
+        /* neurite segments only, see VertexRecord */
+        uint32_t                soma;
+        uint32_t                neurite;
+        uint32_t                padding;
+    };
+
+    template <typename R>
+    struct SectionRecord {
+        uint32_t                compartment_id;
+        uint32_t                padding;
+        R                       pos[3];
+        R                       radius;
+    };
+
+    struct SectionEdgeRecord {
+        uint32_t                src;
+        uint32_t                dst;
+    };
+
+    /*! \brief FNV-1a hash of n bytes, continuing from h. used to build cache keys and the checksum of the records. */
+    inline uint64_t
+    hash(
+        uint64_t    h,
+        void const *data,
+        size_t      n)
+    {
+        unsigned char const *p = (unsigned char const *)data;
+        for (size_t i = 0; i < n; i++) {
+            h ^= p[i];
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+}
+
+#endif
@@ -308,6 +308,9 @@ class Graph {
                     this->int_it    = x.int_it;
                 }
 
+                vertex_iterator &
+                operator=(const vertex_iterator &) = default;
+
                ~vertex_iterator()
                {
                }
@@ -344,6 +347,9 @@ class Graph {
                     //this->val       = x.val;
                 }
 
+                vertex_const_iterator &
+                operator=(const vertex_const_iterator &) = default;
+
                 /* provide copy constructor with non-const vertex_iterator argument to allow implicit
                  * conversion of non-const vertex_iterator to const vertex_const_iterator */
                 vertex_const_iterator(const vertex_iterator &x)
@@ -402,6 +408,9 @@ class Graph {
                     this->int_it    = x.int_it;
                 }
 
+                edge_iterator &
+                operator=(const edge_iterator &) = default;
+
                ~edge_iterator()
                {
                }
@@ -438,6 +447,9 @@ class Graph {
                     //this->val       = x.val;
                 }
 
+                edge_const_iterator &
+                operator=(const edge_const_iterator &) = default;
+
                 /* provide copy constructor with non-const vertex_iterator argument to allow implicit
                  * conversion of non-const vertex_iterator to const vertex_const_iterator */
                 edge_const_iterator(const edge_iterator &x)
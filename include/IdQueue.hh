@@ -61,6 +61,7 @@ class IdQueue {
         explicit    IdQueue(uint32_t first_id);
         void        clear(uint32_t smallest_id = 0);
         uint32_t    getId();
+        uint32_t    getIdBlock(uint32_t n);
         void        freeId(uint32_t id);
         
 };
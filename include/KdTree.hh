@@ -0,0 +1,122 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef KD_TREE_HH
+#define KD_TREE_HH
+
+#include "common.hh"
+
+#include "BoundingBox.hh"
+#include "Vec3.hh"
+
+/*! \brief static k-d tree over a point set, built once by median splits along the axis of largest extent. nodes are
+ * stored in a flat array and refer to contiguous ranges of a permutation of the input points. all distances are
+ * returned squared. */
+template <typename R>
+class KdTree {
+    private:
+        struct Node {
+            BoundingBox<R>          bb;
+            uint32_t                begin;
+            uint32_t                end;
+            /* child node indices, both 0 for leaves. the root has index 0 and is never a child. */
+            uint32_t                left;
+            uint32_t                right;
+        };
+
+        std::vector<Vec3<R>>        points;
+        std::vector<uint32_t>       index;
+        std::vector<Node>           nodes;
+
+        uint32_t                    build(
+                                        uint32_t begin,
+                                        uint32_t end);
+
+        void                        nearestNeighbour(
+                                        uint32_t        node,
+                                        uint32_t        i,
+                                        R              &best) const;
+
+        void                        farthestPair(
+                                        uint32_t        a,
+                                        uint32_t        b,
+                                        R              &best) const;
+
+        static R                    minDist2(
+                                        BoundingBox<R> const   &bb,
+                                        Vec3<R> const          &p);
+
+        static R                    maxDist2(
+                                        BoundingBox<R> const   &a,
+                                        BoundingBox<R> const   &b);
+
+    public:
+        static uint32_t const       leaf_size = 8;
+
+                                    KdTree(std::vector<Vec3<R>> const &points);
+
+        size_t                      size() const;
+
+        /*! \brief squared distance of point i to its nearest neighbour among all other points. points sharing the
+         * position of i count as neighbours at distance 0. only neighbours closer than bound are considered, bound is
+         * returned if there are none. */
+        R                           nearestNeighbourDistance2(
+                                        uint32_t        i,
+                                        R               bound = Aux::Numbers::inf<R>()) const;
+
+        /*! \brief minimum squared distance over all pairs of distinct points, inf for less than two points. */
+        R                           closestPairDistance2() const;
+
+        /*! \brief maximum squared distance over all pairs of distinct points (the squared diameter of the point set),
+         * -inf for less than two points. exact: node pairs are pruned by branch and bound on the maximum distance of
+         * their bounding boxes. */
+        R                           farthestPairDistance2() const;
+};
+
+#include "../tsrc/KdTree_impl.hh"
+
+#endif
@@ -335,6 +335,9 @@ class Mesh {
                     this->int_it    = x.int_it;
                 }
 
+                vertex_iterator &
+                operator=(const vertex_iterator &) = default;
+
                ~vertex_iterator()
                {
                }
@@ -371,6 +374,9 @@ class Mesh {
                     //this->val       = x.val;
                 }
 
+                vertex_const_iterator &
+                operator=(const vertex_const_iterator &) = default;
+
                 /* provide copy constructor with non-const vertex_iterator argument to allow implicit
                  * conversion of non-const vertex_iterator to const vertex_const_iterator */
                 vertex_const_iterator(const vertex_iterator &x)
@@ -429,6 +435,9 @@ class Mesh {
                     this->int_it    = x.int_it;
                 }
 
+                face_iterator &
+                operator=(const face_iterator &) = default;
+
                ~face_iterator()
                {
                }
@@ -465,6 +474,9 @@ class Mesh {
                     //this->val       = x.val;
                 }
 
+                face_const_iterator &
+                operator=(const face_const_iterator &) = default;
+
                 /* provide copy constructor with non-const vertex_iterator argument to allow implicit
                  * conversion of non-const vertex_iterator to const vertex_const_iterator */
                 face_const_iterator(const face_iterator &x)
@@ -1042,6 +1054,72 @@ class Mesh {
             >                              *O;
         bool                                octree_updated;
 
+        /* undo log of an active checkpoint, see beginCheckpoint(). vertices / faces inserted during
+         * the checkpoint are recorded as created, erased ones are detached from the maps but kept
+         * allocated until the checkpoint is committed or rolled back. the first modification of any
+         * pre-existing vertex / face stores its previous state, so that rollback only touches the
+         * elements that have actually been changed. */
+        struct
+        Mesh_CheckpointVertexState {
+            Vec3<R>                 position;
+            std::list<Vertex *>     adjacent_vertices;
+            std::list<Face *>       incident_faces;
+        };
+
+        struct
+        Mesh_CheckpointFaceState {
+            std::array<Vertex *, 4> vertices;
+            bool                    quad;
+        };
+
+        struct
+        Mesh_Checkpoint {
+            IdQueue                                                 V_idq;
+            IdQueue                                                 F_idq;
+            std::set<Vertex *>                                      created_vertices;
+            std::set<Face *>                                        created_faces;
+            std::vector<std::pair<uint32_t, Vertex *>>              erased_vertices;
+            std::vector<std::pair<uint32_t, Face *>>                erased_faces;
+            std::vector<Vertex *>                                   dead_vertices;
+            std::vector<Face *>                                     dead_faces;
+            std::map<Vertex *, Mesh_CheckpointVertexState>          touched_vertices;
+            std::map<Face *, Mesh_CheckpointFaceState>              touched_faces;
+        };
+
+        Mesh_Checkpoint                    *checkpoint;
+
+        /* undo log hooks, no-ops if no checkpoint is active */
+        void                                checkpointTouch(Vertex *v);
+        void                                checkpointTouch(Face *f);
+        void                                checkpointCreated(Vertex *v);
+        void                                checkpointCreated(Face *f);
+        void                                checkpointErased(Vertex *v);
+        void                                checkpointErased(Face *f);
+
+        /* drop the undo log of an active checkpoint, i.e. commit all changes made since */
+        void                                discardCheckpoint();
+
+        /* persistent spatial index of all faces, see enableFaceIndex(): uniform grid of cells with edge length
+         * cell_len, hashed by integer cell coordinates. every face is registered in all cells overlapped by its
+         * bounding box, face_cells stores the registered cell range [min, max] per face. inserted or modified
+         * faces are only marked dirty and (re-)registered lazily before the next query. */
+        struct
+        Mesh_FaceIndex {
+            R                                                       cell_len;
+            std::unordered_map<uint64_t, std::vector<Face *>>       cells;
+            std::unordered_map<Face *, std::array<int32_t, 6>>      face_cells;
+            std::unordered_set<Face *>                              dirty_faces;
+        };
+
+        Mesh_FaceIndex                     *face_index;
+
+        /* face index hooks, no-ops if the face index is disabled */
+        void                                faceIndexMarkDirty(Face *f);
+        void                                faceIndexErase(Face *f);
+        void                                faceIndexUpdate();
+        uint64_t                            faceIndexKey(int32_t i, int32_t j, int32_t k) const;
+        std::array<int32_t, 6>              faceIndexCellRange(BoundingBox<R> const &box) const;
+
         static void
         partitionOctree(
             Octree<Mesh_OctreeInfo, Mesh_OctreeNodeInfo, R>    &O,
@@ -1105,6 +1183,9 @@ class Mesh {
         R                                   getTotalVolume() const;
         void                                getAvgAspectRatio(R &ar_avg, R &ar_sigma, R *ar_max = NULL, R *ar_min = NULL) const;
         BoundingBox<R>                      getBoundingBox() const;
+        /* estimated heap memory in bytes used by vertices, faces, their adjacency lists and the face index.
+         * computed in O(1) from the vertex and face counts, assuming E ~ V + F. */
+        size_t                              estimateMemoryUsage() const;
 
         /* invert orientation of all faces */
         void                                invertOrientation();
@@ -1134,6 +1215,11 @@ class Mesh {
                                                 Mesh<Tm, Tv, Tf, R>            &B,
                                                 std::list<vertex_iterator>     *update_vits = NULL);
 
+        /* bulk version: move-append all meshes in Bs in the given order, all of which are empty afterwards. ids for
+         * all vertices and faces are reserved as one block each, which are larger than all ids of (this) mesh, so
+         * that the internal maps can be appended to at the end in constant time per element. */
+        void                                moveAppend(std::vector<Mesh<Tm, Tv, Tf, R>> &Bs);
+
         /* delete the connected component (i.e. all reachable vertices / faces) of the vertex identified by iterator
          * vstart_it */
         void                                deleteConnectedComponent(vertex_iterator vstart_it);
@@ -1170,8 +1256,8 @@ class Mesh {
                                                 std::list<Face *>      *face_list);
 
         /* ----------------- selection-related methods -------------------------- */
-        void                                selectNonManifoldVertices(std::list<Vertex *> &vlist) const;
-        void                                selectIsolatedVertices(std::list<Vertex *> &vlist) const;
+        void                                selectNonManifoldVertices(std::list<Vertex *> &vlist);
+        void                                selectIsolatedVertices(std::list<Vertex *> &vlist);
         void                                invertVertexSelection(std::list<Vertex *> &vlist) const;
         void                                invertFaceSelection(std::list<Face *> &flist) const;
 
@@ -1235,6 +1321,35 @@ class Mesh {
                                                 vertex_const_iterator const    &u2_it,
                                                 vertex_const_iterator const    &v2_it) const;
 
+        /* ---------------------------------- checkpoints -------------------------------------- */
+        /*! \brief open a checkpoint: all subsequent insertions / erasures of vertices and faces and
+         * all changes of topology are recorded in an undo log, whose size is proportional to the
+         * number of changed elements. rollbackCheckpoint() restores the mesh to the state at the time
+         * of beginCheckpoint(), including vertex / face ids and the identity of all Vertex / Face
+         * objects, i.e. pointers to pre-existing elements stay valid. commitCheckpoint() accepts all
+         * changes. positions are recorded for scale() / translate(), but not for direct writes
+         * through Vertex::pos(). only one checkpoint can be active at a time, clear(), clearFaces()
+         * and renumberConsecutively() implicitly commit. */
+        void                                beginCheckpoint();
+        void                                commitCheckpoint();
+        void                                rollbackCheckpoint();
+        bool                                checkpointActive() const;
+
+        /* ---------------------------------- face index --------------------------------------- */
+        /*! \brief enable a persistent spatial index of all faces, which is kept up to date under all
+         * insertions / erasures of faces, topological modifications, scale() / translate() and checkpoint
+         * rollbacks. findFacesIndexed() then takes time proportional to the number of faces near the search
+         * box instead of the size of the mesh. if cell_len <= 0, twice the average bounding box extent of all
+         * faces is used. as for checkpoints, direct writes through Vertex::pos() are not tracked: call
+         * invalidateFaceIndex() afterwards. the index is not copied on assignment. */
+        void                                enableFaceIndex(R cell_len = 0);
+        void                                disableFaceIndex();
+        bool                                faceIndexEnabled() const;
+        void                                invalidateFaceIndex();
+        void                                findFacesIndexed(
+                                                BoundingBox<R> const   &search_box,
+                                                std::vector<Face *>    &face_list);
+
         /* ---------------------- topological / geometric modifications ------------------------- */
         void                                scale(R const &r);
         void                                translate(Vec3<R> const &d);
@@ -1309,7 +1424,9 @@ class Mesh {
 
         /* -----------------  I/O  ----------------- */
         void                                readFromObjFile(const char *filename);
-        void                                writeObjFile(const char *jobname);
+        void                                writeObjFile(
+                                                const char     *jobname,
+                                                uint32_t        nthreads = 1);
 
 
         /* NOTE: In the C++11 standard, nested classes are automatically "friends" of the containing
@@ -1342,4 +1459,7 @@ class Mesh {
 /* include header for template implementation */
 #include "../tsrc/Mesh_impl.hh"
 
+/* the mesh type used by am_cellgen and am_meshstat is compiled once into libanamorph, see src/Mesh.cc */
+extern template class Mesh<bool, bool, bool, double>;
+
 #endif
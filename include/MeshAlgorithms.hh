@@ -47,6 +47,10 @@
 #ifndef MESH_ALGORITHMS_H
 #define MESH_ALGORITHMS_H
 
+#include "Tracing.hh"
+#include "MeshObjFlushWriter.hh"
+#include "CanalSurface.hh"
+
 
 /* exception classes for Red-Blue Union algorithms */
 namespace RedBlue_ExCodes {
@@ -178,6 +182,42 @@ struct RedBlue_Ex_AffectedCircleTrivial : public RedBlue_Ex {
 };
 
 namespace MeshAlg {
+    /* refined unit sphere approximations used as templates for sphere meshes */
+    enum UnitSphereType {
+        UNIT_SPHERE_OCT,
+        UNIT_SPHERE_ICO
+    };
+
+    /*! \brief flat unit sphere template: vertex positions in id order and triangles given by vertex indices. */
+    template <typename R>
+    struct UnitSphereTemplate {
+        std::vector<
+                Vec3<R>
+            >                                   vertices;
+        std::vector<
+                std::array<uint32_t, 3>
+            >                                   triangles;
+    };
+
+    /*! \brief returns the unit sphere of given type refined tessellation_depth times. templates are memoized per
+     * (type, depth) for the lifetime of the process, hence only the first call for each pair performs the
+     * refinement. thread-safe. */
+    template <typename R>
+    UnitSphereTemplate<R> const &
+    getUnitSphereTemplate(
+        UnitSphereType          type,
+        uint32_t                tessellation_depth);
+
+    /*! \brief clear S and fill it with template T scaled by r and translated to c. vertex and face ids are assigned
+     * in template order. */
+    template <typename Tm, typename Tv, typename Tf, typename R>
+    void
+    instantiateUnitSphereTemplate(
+        UnitSphereTemplate<R> const    &T,
+        Vec3<R>                         c,
+        R const                        &r,
+        Mesh<Tm, Tv, Tf, R>            &S);
+
     template <typename Tm, typename Tv, typename Tf, typename R>
     void
     generateOctSphere(
@@ -209,7 +249,8 @@ namespace MeshAlg {
                 typename Mesh<Tm, Tv, Tf, R>
                     ::vertex_iterator
             >                                           start_circle_its,
-        typename Mesh<Tm, Tv, Tf, R>::vertex_iterator   closing_vertex_it);
+        typename Mesh<Tm, Tv, Tf, R>::vertex_iterator   closing_vertex_it,
+        CanalSurfaceRingCache<R>                       *ring_cache = NULL);
 
 
     template <typename TMesh>
@@ -350,6 +391,32 @@ namespace MeshAlg {
      * been designed to take care of the vertex indexing / numbering issue. obj files vertex lines semantics do not
      * specify vertex indices, but number the vertices (represented as single lines each) consecutively in order of
      * appearance. */
+    /* removes the faces in face_list from M, assigns consecutive flush ids to all vertices that become isolated or
+     * boundary vertices, deletes isolated vertices and formats the new vertex lines (with "# n flushed vertices"
+     * header) into vertex_lines and the flushed faces (with "# n flushed faces." header) into face_lines. this is the
+     * part of partialFlushToObjFile() that works on M, the obj file is not touched. */
+    template <typename Tm, typename Tv, typename Tf, typename R>
+    void
+    partialFlushExtract(
+        Mesh<Tm, Tv, Tf, R>                                        &M,
+        std::list<typename Mesh<Tm, Tv, Tf, R>::Face *>            &face_list,
+        std::list<
+                std::pair<
+                    typename Mesh<Tm, Tv, Tf, R>::Vertex *,
+                    uint32_t
+                >
+            >                                                      &in_boundary_vertices,
+        uint32_t const                                             &in_last_flush_vertex_id,
+        std::list<
+                std::pair<
+                    typename Mesh<Tm, Tv, Tf, R>::Vertex *,
+                    uint32_t          
+                >
+            >                                                      &out_boundary_vertices,
+        uint32_t                                                   &out_last_flush_vertex_id,
+        std::string                                                &vertex_lines,
+        std::string                                                &face_lines);
+
     template <typename Tm, typename Tv, typename Tf, typename R>
     void
     partialFlushToObjFile(
@@ -372,12 +439,13 @@ namespace MeshAlg {
         uint32_t                                                   &out_last_flush_vertex_id);
 
     /* class storing information about the flushing process to ease use of the above function. used in conjunction with
-     * the wrapper overload of partialFlushToObjFile(..) below. */
+     * the wrapper overload of partialFlushToObjFile(..) below, which hands the flushed lines to a background writer.
+     * the obj file is complete after finalize() (or destruction). */
     template<typename Tm, typename Tv, typename Tf, typename R>
     class MeshObjFlushInfo {
         public:
-            std::string     filename;
-            FILE *          obj_file; 
+            std::string                                             filename;
+            std::unique_ptr<MeshObjFlushWriter>                     writer;
             std::list<
                     std::pair<
                         typename Mesh<Tm, Tv, Tf, R>::Vertex *,
@@ -387,23 +455,22 @@ namespace MeshAlg {
             uint32_t                                                last_flush_vertex_id;
 
             MeshObjFlushInfo()
-            : obj_file(NULL), last_flush_vertex_id(0)
+            : last_flush_vertex_id(0)
             {}
 
             MeshObjFlushInfo(const std::string& _filename)
-            : filename(_filename), obj_file(NULL), last_flush_vertex_id(0)
+            : filename(_filename), last_flush_vertex_id(0)
             {
-                this->obj_file  = fopen( (this->filename + ".obj").c_str(), "w");
-                if (!this->obj_file) {
-                    throw("MeshAlg::MeshObjFlushInfo::MeshObjFlushInfo(std:: string filemame): couldn't open given obj file for writing..\n");
-                }
+                this->writer.reset(new MeshObjFlushWriter(this->filename));
             }
 
+            /* wait for the writer and assemble the obj file */
             void    
             finalize()
             {
-                if (this->obj_file) {
-                    fclose(this->obj_file);
+                if (this->writer) {
+                    this->writer->finish();
+                    this->writer.reset();
                 }
                 this->filename = std::string();
                 this->last_boundary_vertices.clear();
@@ -424,4 +491,17 @@ namespace MeshAlg {
 
 #include "../tsrc/MeshAlgorithms_impl.hh"
 
+/* post-processing of the mesh type used by am_cellgen is compiled once into libanamorph, see src/MeshAlgorithms.cc */
+extern template void MeshAlg::greedyEdgeCollapsePostProcessing<bool, bool, bool, double>(
+    Mesh<bool, bool, bool, double>     &M,
+    double const                       &alpha,
+    double const                       &lambda,
+    double const                       &mu,
+    uint32_t                            d);
+extern template void MeshAlg::HCLaplacianSmoothing<bool, bool, bool, double>(
+    Mesh<bool, bool, bool, double>     &M,
+    double const                       &alpha,
+    double const                       &beta,
+    uint32_t                            maxiter);
+
 #endif 
@@ -0,0 +1,118 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MESH_OBJ_FLUSH_WRITER_HH
+#define MESH_OBJ_FLUSH_WRITER_HH
+
+#include "common.hh"
+
+#include <condition_variable>
+#include <deque>
+
+namespace MeshAlg {
+    /* background writer for partially flushed obj files. each flush produces a block of vertex lines, which belongs
+     * in front of the vertex block delimiter of the obj file, and a block of face lines, which is appended to the
+     * file. both blocks are handed over pre-formatted and are appended by an I/O thread to two separate swap files
+     * next to the obj file, so that the meshing thread only waits if the writer falls behind by more than
+     * max_pending flushes. finish() joins the I/O thread and assembles "<filename>.obj" from both swap files, which
+     * results in exactly the layout produced by merging every flush into the obj file directly: all vertex blocks in
+     * flush order, the delimiter, all face blocks in flush order. errors of the I/O thread are thrown (as const char *)
+     * by the next call to push() or finish(). */
+    class MeshObjFlushWriter {
+        private:
+            struct Block {
+                std::string vertex_lines;
+                std::string face_lines;
+            };
+
+            std::string                 filename;
+            FILE                       *obj_file;
+            FILE                       *vertex_swap_file;
+            FILE                       *face_swap_file;
+            uint32_t                    max_pending;
+            uint32_t                    nblocks;
+
+            std::mutex                  mtx;
+            std::condition_variable     block_pushed;
+            std::condition_variable     block_written;
+            std::deque<Block>           blocks;
+            uint32_t                    writing;
+            bool                        stop;
+            char const                 *error;
+            std::thread                 io_thread;
+
+            void                        run();
+            void                        closeFiles();
+
+        public:
+            /*! \brief opens "<filename>.obj" and the swap files for writing and starts the I/O thread. */
+                                        MeshObjFlushWriter(
+                                            std::string const  &filename,
+                                            uint32_t            max_pending = 2);
+
+            /*! \brief finishes writing all pushed blocks, see finish(). errors are swallowed. */
+                                       ~MeshObjFlushWriter();
+
+                                        MeshObjFlushWriter(MeshObjFlushWriter const &) = delete;
+            MeshObjFlushWriter         &operator=(MeshObjFlushWriter const &) = delete;
+
+            /*! \brief queue the pre-formatted vertex and face lines of one flush. blocks while max_pending flushes
+             * are queued or being written. */
+            void                        push(
+                                            std::string    &&vertex_lines,
+                                            std::string    &&face_lines);
+
+            /*! \brief wait for all queued blocks, join the I/O thread and assemble the obj file. further calls are
+             * no-ops. */
+            void                        finish();
+
+            /*! \brief the vertex block delimiter line (without newline) separating vertex and face lines. */
+            static char const          *vertexDelimiter();
+    };
+}
+
+#endif
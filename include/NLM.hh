@@ -212,6 +212,8 @@ namespace NLM {
 
             R                                       getChordLength() const;
 
+            /* if spline_ws is given, it is used for all temporaries of the spline solver. callers updating many paths
+             * should pass one workspace per thread to avoid allocations. */
             void                                    updateGeometry(
                                                         std::function<
                                                                 std::tuple<
@@ -219,7 +221,9 @@ namespace NLM {
                                                                     std::vector<R>,
                                                                     R
                                                                 >(NLM::NeuritePath<R> const &P)
-                                                            >  const                       &parametrization_algorithm);
+                                                            >  const                       &parametrization_algorithm,
+                                                        Aux::Numerics::SplineSystemWorkspace<R, 3>
+                                                                                           *spline_ws = NULL);
 
             BoundingBox<R>                          getBoundingBox() const;
 
@@ -242,7 +246,8 @@ namespace NLM {
                                                             >                                                  &end_circle_its,
                                                         typename Mesh<Tm, Tv, Tf, R>::vertex_iterator          &closing_vertex_it,
                                                         R const                                                &radius_reduction_factor,
-														bool                                                    preserve_crease_edges = false) const;
+														bool                                                    preserve_crease_edges = false,
+                                                        CanalSurfaceRingCache<R>                               *ring_cache = NULL) const;
 
             /// append only one segment of the tail mesh
             template <typename Tm, typename Tv, typename Tf>
@@ -258,7 +263,8 @@ namespace NLM {
                 bool& circle_offset_inOut,
                 std::vector<typename Mesh<Tm, Tv, Tf, R>::vertex_iterator>& circle_its_inOut,
                 typename Mesh<Tm, Tv, Tf, R>::vertex_iterator& circle_closing_vertex_it_inOut,
-                bool preserve_crease_edges
+                bool preserve_crease_edges,
+                CanalSurfaceRingCache<R>* ring_cache = NULL
             ) const;
 
 
@@ -281,7 +287,8 @@ namespace NLM {
                                                                 typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
                                                             >                                                  *end_circle_its      = NULL,
                                                         typename Mesh<Tm, Tv, Tf, R>::vertex_iterator          *closing_vertex_it   = NULL,
-														bool                                                    preserve_crease_edges = false) const;
+														bool                                                    preserve_crease_edges = false,
+                                                        CanalSurfaceRingCache<R>                               *ring_cache = NULL) const;
                                                         
 
     };
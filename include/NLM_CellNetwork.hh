@@ -50,6 +50,8 @@
 #include "CellNetwork.hh"
 #include "CanalSurface.hh"
 #include "NLM.hh"
+#include "MeshAlgorithms.hh"
+#include "Profiling.hh"
 
 /* forward declarations */
 template <typename R> class NLM_CellNetwork;
@@ -123,6 +125,8 @@ class NLM_CellNetwork
 
         bool            meshing_flush;
         uint32_t        meshing_flush_face_limit;
+        uint32_t        meshing_mem_budget;
+        uint32_t        meshing_nthreads;
 
         uint32_t        meshing_n_soma_refs;
         uint32_t        meshing_canal_segment_n_phi_segments;
@@ -234,6 +238,8 @@ class NLM_CellNetwork
 
             bool            meshing_flush;
             uint32_t        meshing_flush_face_limit;
+            uint32_t        meshing_mem_budget;
+            uint32_t        meshing_nthreads;
 
             uint32_t        meshing_n_soma_refs;
             uint32_t        meshing_canal_segment_n_phi_segments;
@@ -638,22 +644,14 @@ class NLM_CellNetwork
              * IC_SONS, otherwise RC_SONS. */
             if (sons_job.ns_it->getSoma() == s_it) {
                 IC_SONS_IsecInfo *ic_sons_info
-                    = new IC_SONS_IsecInfo(
-                        (*this),
-                        s_it,
-                        ns_it,
-                        sons_job.isec_stat_points);
+                    = new IC_SONS_IsecInfo((*this), sons_job);
 
                 /* return shared pointer containing implicitly up-cast SONS_IsecInfo */
                 return std::shared_ptr<SONS_IsecInfo>(ic_sons_info);
             }
             else {
                 RC_SONS_IsecInfo *rc_sons_info
-                    = new RC_SONS_IsecInfo(
-                        (*this),
-                        s_it,
-                        ns_it,
-                        sons_job.isec_stat_points);
+                    = new RC_SONS_IsecInfo((*this), sons_job);
 
                 /* return shared pointer containing implicitly up-cast SONS_IsecInfo */
                 return std::shared_ptr<SONS_IsecInfo>(rc_sons_info);
@@ -987,7 +985,16 @@ class NLM_CellNetwork
 
         /* cell-partitioning */
 
+        /* CSR snapshot of the network, only valid during partitionNetwork(), in which the network topology is not
+         * modified. used by the selection algorithms to compute sub-tree depths on flat arrays. */
+        CellNetworkCSR<R>                           partition_csr;
+        bool                                        partition_csr_valid;
+
     public:
+        /* sub-tree depths as in CellNetwork::getNeuriteSubTreeDepths(), computed on the partitioning CSR snapshot if
+         * valid. */
+        std::pair<uint32_t, R>                      getPartitionSubTreeDepths(neurite_iterator n_it);
+
         /* methods returning pre-defined std::function wrapped selection algorithms for use during cell partitioning */
         static std::function<
                 typename NLM_CellNetwork<R>::neurite_segment_iterator(
@@ -1038,7 +1045,8 @@ class NLM_CellNetwork
 
         /* update cell geometry for the entire cell C_s identified by soma s. this method assumes that C_s has been
          * properly partitioned, e.g. with partitionCell(). if the partitioning is incomplete, the geometry update will
-         * be incomplete as well, which might be desirable in certain cases, yet it is not the intent of this method */
+         * be incomplete as well, which might be desirable in certain cases, yet it is not the intent of this method.
+         * the neurite paths of the cell are updated by nthreads threads. */
         void                                        updateCellGeometry(
                                                         soma_iterator   s_it,
                                                         std::function<
@@ -1047,7 +1055,117 @@ class NLM_CellNetwork
                                                                     std::vector<R>,
                                                                     R
                                                                 >(NLM::NeuritePath<R> const &P)
-                                                            >  const                       &parametrization_algorithm);
+                                                            >  const                       &parametrization_algorithm,
+                                                        uint32_t                            nthreads = 1);
+
+        /* update the geometry of the given neurite paths concurrently with nthreads threads */
+        void                                        updateNeuritePathGeometry(
+                                                        std::vector<NLM::NeuritePath<R> *> const   &paths,
+                                                        std::function<
+                                                                std::tuple<
+                                                                    R,
+                                                                    std::vector<R>,
+                                                                    R
+                                                                >(NLM::NeuritePath<R> const &P)
+                                                            >  const                               &parametrization_algorithm,
+                                                        uint32_t                                    nthreads);
+
+        /* uniform grid over the search boxes of all neurite canal segments, tagged with the position of their
+         * neurite path in meshing (BFS) order. entries of a cell are sorted by that position, so the segments of all
+         * paths remaining from some position onwards are found without touching the others. also holds the state of
+         * the memory budget flush trigger. */
+        struct MeshingFlushIndex {
+            struct Entry {
+                uint32_t                                            order;
+                BoundingBox<R>                                      bb;
+            };
+
+            R                                                       cell_len;
+            std::vector<Entry>                                      entries;
+            std::unordered_map<uint64_t, std::vector<uint32_t>>     cells;
+            std::unordered_map<
+                    typename NeuritePathTree::Vertex const *,
+                    uint32_t
+                >                                                   path_order;
+            size_t                                                  mem_after_flush;
+
+            uint64_t                                                key(int32_t i, int32_t j, int32_t k) const;
+            std::array<int32_t, 6>                                  cellRange(BoundingBox<R> const &box) const;
+        };
+
+        void                                        buildMeshingFlushIndex(
+                                                        std::list<
+                                                                typename NeuritePathTree::vertex_iterator
+                                                            > const                                            &npt_vertices_bfs_ordered,
+                                                        MeshingFlushIndex                                      &flush_index) const;
+
+        /* mesh generation helpers for renderCellNetwork(). */
+        void                                        computeMeshingOrder(
+                                                        std::list<
+                                                                typename NeuritePathTree::vertex_iterator
+                                                            >                                                  &npt_vertices_bfs_ordered,
+                                                        std::vector<size_t>                                    &npt_subtree_sizes);
+
+        template <typename Tm, typename Tv, typename Tf>
+        void                                        renderCellMesh(
+                                                        std::string                                             filename,
+                                                        uint32_t                                                n_phi_segments,
+                                                        std::list<
+                                                                typename NeuritePathTree::vertex_iterator
+                                                            > const                                            &npt_vertices_bfs_ordered,
+                                                        std::vector<size_t> const                              &npt_subtree_sizes,
+                                                        std::vector<Vec3<R>> const                             *render_vectors,
+                                                        std::mt19937                                           *phi_0_rng) const;
+
+        template <typename Tm, typename Tv, typename Tf>
+        void                                        flushUnaffectedCellMeshFaces(
+                                                        Mesh<Tm, Tv, Tf, R>                                    &M_cell,
+                                                        MeshAlg::MeshObjFlushInfo<Tm, Tv, Tf, R>               &M_cell_flushinfo,
+                                                        MeshingFlushIndex                                      &flush_index,
+                                                        typename std::list<
+                                                                typename NeuritePathTree::vertex_iterator
+                                                            >::const_iterator                                   remaining_begin,
+                                                        typename std::list<
+                                                                typename NeuritePathTree::vertex_iterator
+                                                            >::const_iterator                                   remaining_end) const;
+
+        template <typename Tm, typename Tv, typename Tf>
+        static void                                 splitComplexEdges(
+                                                        Mesh<Tm, Tv, Tf, R>                                    &M_red,
+                                                        Mesh<Tm, Tv, Tf, R>                                    &M_blue,
+                                                        RedBlue_Ex_ComplexEdges<R> const                       &complex_ex);
+
+        template <typename Tm, typename Tv, typename Tf>
+        void                                        meshNeuritePath(
+                                                        Mesh<Tm, Tv, Tf, R>                                    &M_cell,
+                                                        NLM::NeuritePath<R> const                              &P,
+                                                        uint32_t                                                path_id,
+                                                        Vec3<R> const                                          &render_vector,
+                                                        uint32_t                                                n_phi_segments,
+                                                        std::mt19937                                           *phi_0_rng = NULL) const;
+
+        template <typename Tm, typename Tv, typename Tf>
+        void                                        meshRootNeuritePath(
+                                                        Mesh<Tm, Tv, Tf, R>                                    &M_T,
+                                                        NLM::NeuritePath<R> const                              &P,
+                                                        Vec3<R> const                                          &render_vector,
+                                                        uint32_t                                                n_phi_segments,
+                                                        std::mt19937                                           &phi_0_rng) const;
+
+        template <typename Tm, typename Tv, typename Tf>
+        bool                                        mergeNeuritePathTreeMesh(
+                                                        Mesh<Tm, Tv, Tf, R>                                    &M_cell,
+                                                        Mesh<Tm, Tv, Tf, R>                                    &M_T) const;
+
+        template <typename Tm, typename Tv, typename Tf>
+        void                                        renderNeuritePathTreesMultiThreaded(
+                                                        Mesh<Tm, Tv, Tf, R>                                    &M_cell,
+                                                        MeshAlg::MeshObjFlushInfo<Tm, Tv, Tf, R>               &M_cell_flushinfo,
+                                                        MeshingFlushIndex                                      &flush_index,
+                                                        std::list<
+                                                                typename NeuritePathTree::vertex_iterator
+                                                            > const                                            &npt_vertices_bfs_ordered,
+                                                        std::vector<size_t> const                              &npt_subtree_sizes) const;
 
     public:
                                                     NLM_CellNetwork(std::string network_name);
@@ -1058,12 +1176,21 @@ class NLM_CellNetwork
          * tasks, this just calls (and overrides) CellNetwork::readFromNeuroMorphoSWCFile(). */
         void                                        readFromNeuroMorphoSWCFile(
                                                         std::string     filename,
-                                                        bool const     &check_coincident_positions = false);
+                                                        bool const     &check_coincident_positions = false,
+                                                        uint32_t        nthreads = 1);
+
+        /* read binary cache written by CellNetwork::writeBinaryCache() after readFromNeuroMorphoSWCFile() (and possibly
+         * preconditioning). overrides CellNetwork::readBinaryCache() to also restore the NLM network info without
+         * traversing the neurites. */
+        bool                                        readBinaryCache(
+                                                        std::string     filename,
+                                                        uint64_t        key);
 
-        /* partition entire network */
+        /* partition entire network. cells are partitioned concurrently by analysis_nthreads threads. */
         void                                        partitionNetwork();
 
-        /* update geometry of entire network */
+        /* update geometry of entire network. the neurite paths of all cells are updated concurrently by
+         * analysis_nthreads threads. */
         void                                        updateNetworkGeometry();
 
         /* perform one full analysis iteration on the entire cell network. */
@@ -1073,6 +1200,14 @@ class NLM_CellNetwork
         template <typename Tm, typename Tv, typename Tf>
         void                                        renderCellNetwork(std::string filename);
 
+        /* render one cell mesh "<filename>_lod<n>.obj" for every number of segments per cross-section n in
+         * lod_n_phi_segments, reusing the meshing order and render vectors. levels are rendered concurrently on up to
+         * meshing_nthreads threads. */
+        template <typename Tm, typename Tv, typename Tf>
+        void                                        renderCellNetworkLODs(
+                                                        std::string                     filename,
+                                                        std::vector<uint32_t> const    &lod_n_phi_segments);
+
         template <typename Tm, typename Tv, typename Tf>
         void                                        renderModellingMeshesIndividually(std::string filename) const;
 
@@ -1082,4 +1217,32 @@ class NLM_CellNetwork
 
 #include "../tsrc/NLM_CellNetwork_impl.hh"
 
+/* NLM_CellNetwork<double>, its base classes and its mesh generation for Mesh<bool, bool, bool, double> are compiled
+ * once into libanamorph, see src/NLM_CellNetwork.cc and src/NLM_CellNetwork_meshing.cc */
+extern template class Graph<NLM::CellNetworkInfo<double>, NLM::NeuronVertexInfo<double>, NLM::NeuronEdgeInfo<double>>;
+extern template class CellNetwork<
+    NLM::CellNetworkInfo<double>,
+    NLM::NeuronVertexInfo<double>,
+    NLM::NeuronEdgeInfo<double>,
+    NLM::SomaInfo<double>,
+    NLM::NeuriteInfo<double>,
+    NLM::AxonInfo<double>,
+    NLM::DendriteInfo<double>,
+    NLM::NeuriteSegmentInfo<double>,
+    NLM::AxonSegmentInfo<double>,
+    NLM::DendriteSegmentInfo<double>,
+    NLM::NeuriteRootEdgeInfo<double>,
+    NLM::AxonRootEdgeInfo<double>,
+    NLM::DendriteRootEdgeInfo<double>,
+    double
+>;
+extern template class NLM_CellNetwork<double>;
+
+extern template void NLM_CellNetwork<double>::renderCellNetwork<bool, bool, bool>(std::string filename);
+extern template void NLM_CellNetwork<double>::renderCellNetworkLODs<bool, bool, bool>(
+    std::string                     filename,
+    std::vector<uint32_t> const    &lod_n_phi_segments);
+extern template void NLM_CellNetwork<double>::renderModellingMeshesIndividually<bool, bool, bool>(
+    std::string                     filename) const;
+
 #endif
@@ -0,0 +1,138 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILING_HH
+#define PROFILING_HH
+
+#include "common.hh"
+
+#include "Tracing.hh"
+
+/* lightweight structured profiling of the am_cellgen pipeline. stages are identified by (static) name strings such as
+ * "analysis/solve/GSI", per stage the number of calls, accumulated wall time, accumulated cpu time of the calling
+ * thread and the peak resident set size observed at the end of the stage are recorded. counters are named 64-bit
+ * integers. all recording functions are thread-safe and return immediately if profiling is disabled, which is the
+ * default. */
+namespace Profiling {
+    /*! \brief enable / disable recording. */
+    void        enable(bool on);
+
+    /*! \brief returns true iff recording is enabled. */
+    bool        enabled();
+
+    /*! \brief clear all recorded stages and counters and restart the global wall clock. */
+    void        reset();
+
+    /*! \brief cpu time consumed by the calling thread in seconds. */
+    double      threadCpuTime();
+
+    /*! \brief peak resident set size of the process in kB, 0 if unavailable. */
+    uint64_t    peakRSS();
+
+    /*! \brief add measured times for stage, which has been executed calls times in total. */
+    void        addStageTime(
+                    char const *stage,
+                    double      wall,
+                    double      cpu,
+                    uint64_t    calls = 1);
+
+    /*! \brief add delta to counter. */
+    void        addCounter(
+                    char const *counter,
+                    int64_t     delta = 1);
+
+    /*! \brief register a throughput: the report lists the value of counter divided by the accumulated wall time of
+     * stage (per second) under the given name. registrations are cleared by reset(). */
+    void        addRate(
+                    char const *name,
+                    char const *counter,
+                    char const *stage);
+
+    /*! \brief accumulated measurements of one stage. */
+    struct StageRecord {
+        std::string     name;
+        uint64_t        calls;
+        double          wall;
+        double          wall_max;
+        double          cpu;
+        uint64_t        peak_rss_kb;
+    };
+
+    /*! \brief copy all recorded stages and counters, in order of their first occurrence. */
+    void        snapshot(
+                    std::vector<StageRecord>                           &stages,
+                    std::vector<std::pair<std::string, int64_t>>       &counters);
+
+    /*! \brief write all recorded stages and counters as JSON object to file filename. info contains additional
+     * key/value pairs (e.g. input network name) which are written as strings into the "info" object. returns false if
+     * the file could not be written. */
+    bool        writeJsonReport(
+                    std::string const                          &filename,
+                    std::map<std::string, std::string> const   &info);
+
+    /*! \brief scoped stage timer: measures wall and thread cpu time from construction to destruction and adds it to
+     * the given stage. the stage name is not copied and must outlive the object (string literals are used
+     * throughout). if tracing is compiled in and enabled, the stage is additionally recorded as trace event. */
+    class ScopedStage {
+        private:
+            char const     *stage;
+            bool            active;
+            double          wall_start;
+            double          cpu_start;
+#ifdef __TRACING__
+            double          trace_start;
+#endif
+
+        public:
+            explicit        ScopedStage(char const *stage);
+                           ~ScopedStage();
+
+                            ScopedStage(ScopedStage const &) = delete;
+            ScopedStage    &operator=(ScopedStage const &) = delete;
+    };
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SWC_READER_HH
+#define SWC_READER_HH
+
+#include "common.hh"
+
+#include "Vec3.hh"
+#include "aux.hh"
+
+/* fast SWC ingestion: the whole file is mapped into memory, split into chunks at line boundaries and the chunks are
+ * tokenized in place by several threads. no line is copied and no heap allocation is performed per line, records of
+ * all chunks are concatenated in file order. */
+namespace SWCReader {
+    /*! \brief read-only view of an entire file. uses mmap() where available, otherwise the file is read into a
+     * buffer. */
+    class MappedFile {
+        private:
+            char const                 *ptr;
+            size_t                      len;
+            bool                        mapped;
+            std::vector<char>           buffer;
+
+        public:
+                                        MappedFile();
+                                       ~MappedFile();
+
+                                        MappedFile(MappedFile const &) = delete;
+            MappedFile                 &operator=(MappedFile const &) = delete;
+
+            /*! \brief map the file, returns false if it can't be opened or read. */
+            bool                        open(std::string const &filename);
+            void                        close();
+
+            char const                 *data() const;
+            size_t                      size() const;
+    };
+
+    /*! \brief split [0, size) into at most nchunks ranges of approximately equal size, each of which starts at the
+     * beginning of a line. */
+    std::vector<
+            std::pair<size_t, size_t>
+        >                               splitIntoLineChunks(
+                                            char const *data,
+                                            size_t      size,
+                                            uint32_t    nchunks);
+
+    /*! \brief one parsed SWC line, ids as given in the file. */
+    template <typename R>
+    struct Record {
+        uint32_t                        compartment_id;
+        uint32_t                        compartment_type;
+        int32_t                         parent_id;
+        Vec3<R>                         p;
+        R                               r;
+    };
+
+    /*! \brief parse all lines in [begin, end), which must start at the beginning of a line. empty lines and comment
+     * lines (first non-whitespace character '#') are skipped. all other lines must start with the seven SWC fields,
+     * further content is ignored. returns NULL on success, otherwise the start of the first malformed line. */
+    template <typename R>
+    char const                         *parseChunk(
+                                            char const                 *begin,
+                                            char const                 *end,
+                                            std::vector<Record<R>>     &records);
+
+    /*! \brief parse the mapped file with nthreads threads. returns NULL on success, otherwise the start of the first
+     * malformed line of the file. */
+    template <typename R>
+    char const                         *parse(
+                                            MappedFile const           &f,
+                                            uint32_t                    nthreads,
+                                            std::vector<Record<R>>     &records);
+}
+
+#include "../tsrc/SWCReader_impl.hh"
+
+#endif
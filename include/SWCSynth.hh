@@ -0,0 +1,132 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SWC_SYNTH_HH
+#define SWC_SYNTH_HH
+
+#include "common.hh"
+
+#include "Vec3.hh"
+#include "SWCReader.hh"
+
+/* generation of synthetic, reproducible cell networks in SWC format. all lengths are given in SWC units (usually
+ * micrometres). the output only depends on the parameters, including the seed. */
+namespace SWCSynth {
+    /*! \brief parameters of a synthetic cell network.
+     *
+     * somas are placed on a jittered cubic grid inside a cube whose volume is n_cells / density. every soma grows
+     * n_neurites neurites. each growing tip is extended segment by segment: it terminates with probability
+     * termination_probability (never before min_segments segments), otherwise it bifurcates with probability
+     * branch_probability (only up to branch order max_order). segment lengths are lognormally distributed, radii
+     * taper by radius_taper per segment and shrink by branch_radius_ratio at bifurcations. a step that would come
+     * closer to any soma or non-adjacent segment than 1.5 times the sum of both radii is drawn again, and a tip that
+     * finds no free step terminates, so that the grown network is free of intersections.
+     *
+     * after growth, every terminal tip is, with probability intersection_rate, extended by a bridge that runs through
+     * the nearest segment of another neurite within reach, which forces an intersection of the two neurites. these
+     * are the only intersections of the network. */
+    struct Parameters {
+        uint32_t                        seed;
+        uint32_t                        n_cells;
+        double                          density;                    /* cells per cubic millimetre */
+
+        double                          soma_radius_mean;
+        double                          soma_radius_sigma;
+
+        uint32_t                        n_neurites;
+        double                          branch_probability;
+        double                          termination_probability;
+        uint32_t                        min_segments;
+        uint32_t                        max_order;
+        uint32_t                        max_cell_vertices;
+
+        double                          segment_length_mean;
+        double                          segment_length_sigma;
+        double                          tortuosity;                 /* std. deviation of direction change per segment */
+        double                          branch_angle;               /* angle between the two children, in radians */
+
+        double                          radius_mean;                /* radius of neurite root vertices */
+        double                          radius_sigma;
+        double                          radius_min;
+        double                          radius_taper;
+        double                          branch_radius_ratio;
+
+        double                          intersection_rate;
+
+                                        Parameters();
+    };
+
+    /*! \brief summary of a generated network. */
+    struct Statistics {
+        uint32_t                        n_vertices;
+        uint32_t                        n_branch_points;
+        uint32_t                        n_terminals;
+        uint32_t                        n_forced_intersections;
+        double                          total_length;
+        double                          cube_side;
+
+                                        Statistics();
+    };
+
+    /*! \brief generate the network described by p. records are numbered 1, 2, .. in order, every record's parent
+     * precedes it. somas are single point compartments of type 1, neurites are dendrites (type 3). */
+    void                                generate(
+                                            Parameters const                   &p,
+                                            std::vector<SWCReader::Record<double>>
+                                                                               &records,
+                                            Statistics                         *stats = NULL);
+
+    /*! \brief write records in SWC format, preceded by the given comment lines. throws if the file can't be
+     * written. */
+    void                                write(
+                                            std::string const                  &filename,
+                                            std::vector<SWCReader::Record<double>> const
+                                                                               &records,
+                                            std::vector<std::string> const     &comments = std::vector<std::string>());
+}
+
+#endif
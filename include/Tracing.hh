@@ -0,0 +1,135 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACING_HH
+#define TRACING_HH
+
+#include "common.hh"
+
+/* event tracing for analysis and meshing threads. events are recorded as scoped begin/end pairs (chrome trace
+ * "complete" events) into per-thread ring buffers without any locking on the recording path and can be exported as
+ * trace JSON file which opens in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * tracing is only compiled in if __TRACING__ is defined (cmake -DTRACING=ON). otherwise, all TRACE_* macros expand to
+ * nothing and no tracing code or data is part of the build. if compiled in, recording additionally has to be enabled
+ * at runtime with Tracing::enable(). */
+#ifdef __TRACING__
+
+namespace Tracing {
+    /*! \brief enable / disable recording. */
+    void        enable(bool on);
+
+    /*! \brief returns true iff recording is enabled. */
+    bool        enabled();
+
+    /*! \brief set maximum number of events kept per thread. once a thread's ring buffer is full, its oldest events
+     * are overwritten. only affects buffers of threads that record their first event afterwards. */
+    void        setThreadBufferCapacity(size_t capacity);
+
+    /*! \brief name the calling thread in the exported trace. name is copied. */
+    void        setThreadName(std::string const &name);
+
+    /*! \brief microseconds since process start on a monotonic clock. */
+    double      now();
+
+    /*! \brief record a complete event of duration dur starting at ts for the calling thread. name and arg_name are
+     * not copied and must be string literals. arg_name == NULL records no argument. */
+    void        recordEvent(
+                    char const *name,
+                    double      ts,
+                    double      dur,
+                    char const *arg_name,
+                    int64_t     arg);
+
+    /*! \brief write all recorded events of all threads in chrome trace JSON format to filename. must only be called
+     * while no other thread records events, e.g. after all worker threads have been joined. returns false if the file
+     * could not be written. */
+    bool        writeTraceFile(std::string const &filename);
+
+    /*! \brief scoped event: records a complete event covering the lifetime of the object. */
+    class Scope {
+        private:
+            char const     *name;
+            char const     *arg_name;
+            int64_t         arg;
+            double          ts;
+
+        public:
+            explicit        Scope(
+                                char const *name,
+                                char const *arg_name = NULL,
+                                int64_t     arg = 0)
+                                : name(name), arg_name(arg_name), arg(arg), ts(-1.0)
+                            {
+                                if (enabled()) {
+                                    this->ts = now();
+                                }
+                            }
+
+                           ~Scope()
+                            {
+                                if (this->ts >= 0.0) {
+                                    recordEvent(this->name, this->ts, now() - this->ts, this->arg_name, this->arg);
+                                }
+                            }
+
+                            Scope(Scope const &) = delete;
+            Scope          &operator=(Scope const &) = delete;
+    };
+}
+
+    #define TRACE_CONCAT_IMPL(a, b)         a ## b
+    #define TRACE_CONCAT(a, b)              TRACE_CONCAT_IMPL(a, b)
+    #define TRACE_SCOPE(name)               Tracing::Scope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+    #define TRACE_SCOPE_ARG(name, an, a)    Tracing::Scope TRACE_CONCAT(trace_scope_, __LINE__)(name, an, (int64_t)(a))
+    #define TRACE_THREAD_NAME(name)         Tracing::setThreadName(name)
+#else
+    #define TRACE_SCOPE(name)
+    #define TRACE_SCOPE_ARG(name, an, a)
+    #define TRACE_THREAD_NAME(name)
+#endif
+
+#endif
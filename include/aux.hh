@@ -62,6 +62,7 @@
 #include "Vec3.hh"
 #include "StaticVector.hh"
 #include "StaticMatrix.hh"
+#include "Tracing.hh"
 
 #ifdef WITH_BOOST
 	#include <boost/math/special_functions/binomial.hpp>
@@ -81,6 +82,23 @@ namespace Aux {
     namespace Numbers {
         /* FIXME: convert to templates, use std::{sin,cos,sqrt, ..} template specialization wrappers for arithmetic */
         double  frand(double min, double max);
+
+        /* while an instance is alive, frand() draws from the given generator on the constructing thread instead of
+         * from the global std::rand() sequence. used by worker threads to keep their random draws independent of
+         * thread scheduling. */
+        class ScopedRandomGenerator {
+            private:
+                std::mt19937   *previous;
+
+            public:
+                                ScopedRandomGenerator(std::mt19937 &rng);
+                               ~ScopedRandomGenerator();
+
+                                ScopedRandomGenerator(ScopedRandomGenerator const &) = delete;
+                ScopedRandomGenerator &
+                                operator=(ScopedRandomGenerator const &) = delete;
+        };
+
         double  fmin3(double a, double b, double c);
         double  fmax3(double a, double b, double c);
         int     sign(int64_t d);
@@ -103,11 +121,11 @@ namespace Aux {
             return boost::math::binomial_coefficient<R>(n, k);
 #else
             static StaticVector<n+1, R> bicof;
-            static bool bicof_recompute = true;
+            static std::once_flag bicof_init_flag;
 
-            /* indicate necessity to (re)compute more binomial coefficients by toggling flag if required n is
-             * larger than maximum precomputed one */
-            if (bicof_recompute)
+            /* compute binomial coefficients on first use. std::call_once makes this safe for concurrent first calls
+             * from several threads. */
+            std::call_once(bicof_init_flag, [] () -> void
             {
                 debugl(2, "initBinomialCoefficients(): ... \n");
 
@@ -119,9 +137,7 @@ namespace Aux {
                 bicof[n] = (R)1;
 
                 debugl(2, "done.\n");
-
-                bicof_recompute = false;
-            }
+            });
             return bicof[k];
             //return k < n+1 ? bicof[k] : (R)0;
 #endif
@@ -130,192 +146,146 @@ namespace Aux {
     }
 
     namespace Numerics {
-        /* Thomson variant: extremely efficient, linear time, but of at least questionable stability. maybe better cholseky? */
-        template <typename R>
+        /* temporaries of solveSplineCoefficientSystems(). a workspace only grows, so reusing one for a sequence of
+         * systems avoids all allocations once it has seen the largest system. */
+        template <typename R, uint32_t K>
+        struct SplineSystemWorkspace {
+            /* knot differences, eliminated diagonal, upper diagonal and elimination factors of the shared matrix */
+            std::vector<R>  h, diag, upper, factor;
+
+            /* right-hand sides and moments of all K systems, interleaved: d[K*i + k] */
+            std::vector<R>  d, M;
+
+            /* data values and resulting power coefficients, interleaved. filled / read by the caller. */
+            std::vector<R>  x, coeffs;
+        };
+
+        /* solve K cubic spline interpolation systems with hermite boundary conditions that share the knot vector t,
+         * e.g. the {x, y, z} components of a space curve. the data values are read from ws.x, where ws.x[K*i + k] is
+         * the i-th value of system k, and ds0[k] / dsn[k] are the boundary derivatives of system k. the tridiagonal
+         * matrix only depends on t and is hence eliminated once (Thomas algorithm). the K right-hand sides are then
+         * swept in lockstep, which the compiler can vectorize over k. for each of the n segments j, the power
+         * coefficients c_3, c_2, c_1, c_0 of system k are written to ws.coeffs[K*(4*j + l) + k], l = 0, .., 3.
+         *
+         * for every system, the result is identical to that of solveSplineCoefficientSystem(). */
+        template <typename R, uint32_t K>
         void
-        solveSplineCoefficientSystem(
-            std::vector<R> const   &t,
-            std::vector<R> const   &x,
-            R const                &ds0,
-            R const                &dsn,
-            std::vector<R>          &result_vector)
+        solveSplineCoefficientSystems(
+            std::vector<R> const           &t,
+            R const                        *ds0,
+            R const                        *dsn,
+            SplineSystemWorkspace<R, K>    &ws)
         {
-            /*
-            static bool narf_init = false;
-            if (!narf_init) {
-                NA_init();
-                narf_init = true;
-            }
-            */
-
-            int i, j, n = t.size() - 1; 
-
-            /*
-            printf("\n\n ------------------------------ \n\n solveSplineCoefficientSystem(): n = %d, ds0 = %f, dsn = %f\n", n, ds0, dsn);
-            printf("t = [ ");
-            for (i = 0; i <= n; i++) {
-                printf("%+5.4e ", t[i]);
-            }
-            printf("]\n");
-            printf("x = [ ");
-            for (i = 0; i <= n; i++) {
-                printf("%+5.4e ", x[i]);
-            }
-            printf("]\n");
-            */
+            uint32_t const  n = t.size() - 1;
+            uint32_t        i, j, k;
+
+            ws.h.resize(n + 1);
+            ws.diag.resize(n + 1);
+            ws.upper.resize(n + 1);
+            ws.factor.resize(n);
+            ws.d.resize(K*(n + 1));
+            ws.M.resize(K*(n + 1));
+            ws.coeffs.resize(K*4*n);
+
+            R          *h   = ws.h.data();
+            R          *b   = ws.diag.data();
+            R          *c   = ws.upper.data();
+            R          *f   = ws.factor.data();
+            R          *d   = ws.d.data();
+            R          *M   = ws.M.data();
+            R const    *x   = ws.x.data();
+            R          *res = ws.coeffs.data();
 
             /* parameter (knot) differences */
-            std::vector<R>     h(n + 1);
-
             h[0] = 0.0;
             for (i = 0; i <= n - 1; i++) {
                 h[i + 1] = t[i+1] - t[i];
             }
 
-            /* moments of the spline, i.e. second derivatives. solution vector of the constructed system */
-            std::vector<R>     M(n + 1, 0.0); 
-
-            /* tridiagonal matrix encoding: every row is encoded as three values */
-            std::vector<std::vector<R> >   A(n+1);
-            for (i = 0; i < n+1; i++) {
-                A[i].resize(3, 0.0);
-            }
-
-            /* inhomogeneity vector */
-            std::vector<R> d(n+1);
-
-            /* let A_real denote the real (n+1)x(n+1) matrix, not the tridiagonal matrix encoding.
-             * first row of the matrix, A[0][0] is actually "A_real[0][-1]" and not part of the matrix, because
-             * first row has only two entries. upper left element is 2.0, A_real[0][1] = lambda_0  = 1.0 for
-             * hermite boundary conditions */
-            A[0][0] = 0.0;
-            A[0][1] = 2.0;
-            A[0][2] = 1.0;
-
-            /* value for d[0] is specially derived for hermite boundary conditions */
-            d[0]    = 6.0 / h[1] * ( (x[1] - x[0]) / h[1] - ds0);
-            
-            /* last row. A_real[n][n-1] = mu_n = 1.0 for hermite boundary conditions. A_real[n][n] = 2.0.
-             * A[n][2] = A_real[n][n+1] and is not part of the matrix */
-            A[n][0] = 1.0;
-            A[n][1] = 2.0;
-            A[n][2] = 0.0;
-
-            /* special value for hermite boundary conditions */
-            d[n]    = 6.0 / h[n] * (dsn - (x[n] - x[n-1]) / h[n]);
-
+            /* first and last row carry the hermite boundary conditions: (2, 1) and (1, 2). the subdiagonal mu_i is
+             * only needed to compute the elimination factors and is not stored. */
+            b[0] = 2.0;
+            c[0] = 1.0;
+            b[n] = 2.0;
+            c[n] = 0.0;
             for (i = 1; i < n; i++) {
-                /* mu_i, 2.0, lambda_i */
-                A[i][0] = h[i] / (h[i] + h[i+1]);
-                A[i][1] = 2.0;
-                A[i][2] = h[i+1] / (h[i] + h[i+1]);
-
-                /* inhomogeneity vector entry i */
-                d[i]    = 6.0 / (h[i] + h[i+1]) * ( (x[i+1] - x[i]) / h[i+1] - (x[i] - x[i-1]) / h[i]);
+                b[i] = 2.0;
+                c[i] = h[i+1] / (h[i] + h[i+1]);
             }
 
-            /* ---------- debug print ----------- */
-            /*
-            printf("n= %d\n", n);
-            NA_matrix A_real = NA_minit(n+1, n+1);
-            A_real[0][0]    = A[0][1];
-            A_real[0][1]    = A[0][2];
-            for (i = 1; i < n; i++) {
-                A_real[i][i-1] = A[i][0];
-                A_real[i][i] = A[i][1];
-                A_real[i][i + 1] = A[i][2];
+            /* eliminate subdiagonal: add a multiple of row i to row (i+1) */
+            for (i = 0; i < n; i++) {
+                R const mu  = (i + 1 < n) ? h[i+1] / (h[i+1] + h[i+2]) : 1.0;
+                f[i]        = -mu / b[i];
+                b[i+1]     += f[i] * c[i];
             }
-            A_real[n][n-1]  = A[n][0];
-            A_real[n][n]    = A[n][1];
 
-            NA_mprint(A_real, n + 1, n+1);
-            printf("d = [ ");
-            for (i = 0; i < n+1; i++) {
-                printf("+%5.4e ", d[i]);
+            /* right-hand sides */
+            for (k = 0; k < K; k++) {
+                d[k]        = 6.0 / h[1] * ( (x[K + k] - x[k]) / h[1] - ds0[k]);
+                d[K*n + k]  = 6.0 / h[n] * (dsn[k] - (x[K*n + k] - x[K*(n-1) + k]) / h[n]);
+            }
+            for (i = 1; i < n; i++) {
+                for (k = 0; k < K; k++) {
+                    d[K*i + k] = 6.0 / (h[i] + h[i+1]) * ( (x[K*(i+1) + k] - x[K*i + k]) / h[i+1] - (x[K*i + k] - x[K*(i-1) + k]) / h[i]);
+                }
             }
-            printf("]\n");
-            */
-            /* ---------- debug print ----------- */
 
-            /* eliminate subdiagonal entries in tridiagonal system.
-             * add a multiple of row i to row (i+1) to eliminate element A_real[i+1][i] */
-            R lambda;
+            /* forward sweep and back substitution for all systems in lockstep */
             for (i = 0; i < n; i++) {
-                lambda = -A[i+1][0] / A[i][1]; 
-                A[i+1][0] += lambda * A[i][1];
-                A[i+1][1] += lambda * A[i][2];
-                d[i+1]    += lambda * d[i];
+                for (k = 0; k < K; k++) {
+                    d[K*(i+1) + k] += f[i] * d[K*i + k];
+                }
             }
 
-            /* ---------- debug print ----------- */
-            /*
-            A_real[0][0]    = A[0][1];
-            A_real[0][1]    = A[0][2];
-            for (i = 1; i < n; i++) {
-                A_real[i][i-1] = A[i][0];
-                A_real[i][i] = A[i][1];
-                A_real[i][i + 1] = A[i][2];
+            for (k = 0; k < K; k++) {
+                M[K*n + k] = d[K*n + k] / b[n];
             }
-            A_real[n][n-1]  = A[n][0];
-            A_real[n][n]    = A[n][1];
-
-            NA_mprint(A_real, n + 1, n+1);
-            */
-            /* ---------- debug print ----------- */
-
-            /* solve using backsubstitution */
-            M[n]    = d[n] / A[n][1];
-            for (i = n-1; i >= 0; i--) {
-                M[i] = (d[i] - A[i][2] * M[i+1]) / A[i][1];
-            } 
-
-            /*
-            printf("M = [ ");
-            for (i = 0; i < n+1; i++) {
-                printf("%+5.4e ", M[i]);
+            for (i = n; i-- > 0; ) {
+                for (k = 0; k < K; k++) {
+                    M[K*i + k] = (d[K*i + k] - c[i] * M[K*(i+1) + k]) / b[i];
+                }
             }
-            printf("]\n");
-            */
 
-            /* quantities used in the moment representation of the spline segment functions */
-            std::vector<R> a(n), alpha(n), beta(n), gamma(n), delta(n);
+            /* the j-th spline is given as
+             * delta*(t - t[j])^3 + gamma*(t - t[j])^2 + beta*(t - t[j]) + alpha
+             * in terms of the moments M. expand to get the monomial coefficients. */
             for (j = 0; j < n; j++) {
-                //b[j]        = x[j] - ( M[j] * h[j+1] * h[j+1]) / 6.0;
-                a[j]        = (x[j+1] - x[j]) / h[j+1] - h[j+1]/6.0*(M[j+1] - M[j]);
-                alpha[j]    = x[j];
-                gamma[j]    = M[j] / 2.0;
-                beta[j]     = ( -M[j] * h[j+1])/2.0 + a[j];
-                delta[j]    = (M[j+1] - M[j]) / (6.0 * h[j+1]);
-            }
-
-            /* the j-th spline is now given as:
-             * delta[j]*(t - t[j])^3 + gamma[j]*(t - t[j])^2 + beta[j]*(t - t[j]) + alpha[j]
-             * to get the monomial coefficients, this has to be expanded.. */
-             
-            /* output coefficients */
-            result_vector.resize(4*n);
-
-            R c_0, c_1, c_2, c_3;
-            debugTabInc();
-            for (j = 0; j < n; j++) {
-                /* recover coefficients from solution */
-                //c_0 = alpha[j] - beta[j]*t[j] + gamma[j]*t[j]*t[j] - delta[j]*t[j]*t[j]*t[j];
-                c_0 = alpha[j] + t[j]*(- beta[j] + t[j]*(gamma[j] - delta[j]*t[j]) );
-                //c_1 = beta[j] - 2.0*gamma[j]*t[j] + 3.0*delta[j]*t[j]*t[j];
-                c_1 = beta[j] + t[j]*(- 2.0*gamma[j] + t[j]*(+ 3.0*delta[j]) );
-                c_2 = gamma[j] + -3.0*delta[j]*t[j];
-                c_3 = delta[j];
-
-                debugl(2, "segment function = %d, c_0: %f, c_1: %f, c_2: %f, c_3: %f\n", j, c_0, c_1, c_2, c_3);
-                debugl(2, "a[%d] = %f, alpha[%d] = %f, beta[%d] = %f, gamma[%d] = %f, delta[%d] = %f\n", j, a[j], j, alpha[j], j, beta[j], j, gamma[j], j, delta[j]);
-                debugl(2, "t[%d] = %f, x[%d] = %f\n", j, t[j], j, x[j]);
-
-                result_vector[4*j    ] = c_3;
-                result_vector[4*j + 1] = c_2;
-                result_vector[4*j + 2] = c_1;
-                result_vector[4*j + 3] = c_0;
+                R const tj = t[j];
+                for (k = 0; k < K; k++) {
+                    R const M_j     = M[K*j + k];
+                    R const M_jpo   = M[K*(j+1) + k];
+                    R const a       = (x[K*(j+1) + k] - x[K*j + k]) / h[j+1] - h[j+1]/6.0*(M_jpo - M_j);
+                    R const alpha   = x[K*j + k];
+                    R const gamma   = M_j / 2.0;
+                    R const beta    = ( -M_j * h[j+1])/2.0 + a;
+                    R const delta   = (M_jpo - M_j) / (6.0 * h[j+1]);
+
+                    res[K*(4*j    ) + k] = delta;
+                    res[K*(4*j + 1) + k] = gamma + -3.0*delta*tj;
+                    res[K*(4*j + 2) + k] = beta + tj*(- 2.0*gamma + tj*(+ 3.0*delta) );
+                    res[K*(4*j + 3) + k] = alpha + tj*(- beta + tj*(gamma - delta*tj) );
+                }
             }
-            debugTabDec();
+        }
+
+        /* single system variant of solveSplineCoefficientSystems(): interpolate the values x at the knots t with
+         * hermite boundary derivatives ds0, dsn. result_vector holds the 4n power coefficients c_3, c_2, c_1, c_0 of
+         * all n segments. */
+        template <typename R>
+        void
+        solveSplineCoefficientSystem(
+            std::vector<R> const   &t,
+            std::vector<R> const   &x,
+            R const                &ds0,
+            R const                &dsn,
+            std::vector<R>          &result_vector)
+        {
+            SplineSystemWorkspace<R, 1> ws;
+
+            ws.x = x;
+            solveSplineCoefficientSystems<R, 1>(t, &ds0, &dsn, ws);
+            result_vector.swap(ws.coeffs);
         }
     }
 
@@ -1888,6 +1858,61 @@ namespace Aux {
         }
     }
 
+    namespace Parallel {
+        /* call f(i, t) for all i in [0, n) on up to nthreads threads, the calling thread being one of them. indices are
+         * handed out one at a time in increasing order, t in [0, nthreads) identifies the worker that processes i and
+         * can be used to address per-worker state. once f throws, no further indices are handed out and the first
+         * exception is re-thrown on the calling thread after all workers have been joined. if thread_name is given,
+         * every worker is named accordingly in traces. */
+        template <typename F>
+        void
+        forEachIndex(
+            size_t          n,
+            uint32_t        nthreads,
+            F const        &f,
+            char const     *thread_name = NULL)
+        {
+            nthreads = std::max<size_t>(1, std::min<size_t>(nthreads, n));
+
+            std::atomic<size_t>     next(0);
+            std::exception_ptr      error;
+            std::mutex              error_mutex;
+
+            auto worker = [&] (uint32_t t) -> void {
+                if (thread_name) {
+                    TRACE_THREAD_NAME(thread_name);
+                }
+
+                size_t i;
+                while ((i = next++) < n) {
+                    try {
+                        f(i, t);
+                    }
+                    catch (...) {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                        next = n;
+                    }
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (uint32_t t = 1; t < nthreads; t++) {
+                workers.push_back(std::thread(worker, t));
+            }
+            worker(0);
+            for (auto &w : workers) {
+                w.join();
+            }
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
     namespace Stat {
         template <typename R>
         void
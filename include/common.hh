@@ -58,8 +58,10 @@
 #include <errno.h>
 #include <math.h>
 #include <complex>
+#include <exception>
 
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <ctime>
 #include <functional>
@@ -68,9 +70,12 @@
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <random>
 #include <set>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <algorithm>
@@ -93,6 +98,8 @@
     #include <netdb.h>
     #include <arpa/inet.h>
     #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
 #endif
 
 namespace Common {
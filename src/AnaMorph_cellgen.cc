@@ -49,6 +49,9 @@
 #include "CellNetworkAlg.hh"
 #include "MeshAlgorithms.hh"
 
+#include <dirent.h>
+#include <sys/stat.h>
+
 /* initialize static command line switch info */
 const std::list<
     std::pair<
@@ -59,6 +62,9 @@ const std::list<
     { 
         { "h",                                      0 },
         { "i",                                      1 },
+        { "batch",                                  1 },
+        { "batch-nthreads",                         1 },
+        { "batch-report",                           1 },
         { "analysis",                               0 },
         { "no-analysis",                            0 },
         { "meshing",                                0 },
@@ -73,6 +79,7 @@ const std::list<
         { "ana-nthreads",                           1 },
         { "ana-univar-eps",                         1 },
         { "ana-bivar-eps",                          1 },
+        { "ana-cache",                              0 },
         { "no-mesh-pp",                             0 },
         { "mesh-pp-gec",                            4 },
         { "no-mesh-pp-gec",                         0 },
@@ -80,16 +87,21 @@ const std::list<
         { "no-mesh-pp-hc",                          0 },
         { "meshing-soma-refs",                      1 },
         { "meshing-cansurf-angularsegments",        1 },
+        { "meshing-lods",                           1 },
         { "meshing-triangle-height",                1 },
         { "meshing-outerloop-maxiter",              1 },
         { "meshing-innerloop-maxiter",              1 },
         { "preserve-crease-edges",                  0 },
         { "meshing-flush",                          1 },
         { "no-meshing-flush",                       0 },
+        { "meshing-mem-budget",                     1 },
+        { "meshing-nthreads",                       1 },
         { "meshing-merging-initial-radiusfactor",   1 },
         { "meshing-merging-radiusfactor-decrement", 1 },
         { "meshing-complexedge-max-growthfactor",   1 },
-        { "debug-lvl",                              2 }
+        { "debug-lvl",                              2 },
+        { "profile-out",                            1 },
+        { "trace-out",                              1 }
     };
 
 const std::list<
@@ -99,6 +111,7 @@ const std::list<
     >
 > AnaMorph_cellgen::cl_mutex_switch_list = 
     {
+        { "i",              "batch" },
         { "analysis",       "no-analysis" },
         { "meshing",        "no-meshing" },
         { "cellnet-pc",     "no-cellnet-pc" },
@@ -107,14 +120,21 @@ const std::list<
         { "no-mesh-pp",     "mesh-pp-gec"},
         { "no-mesh-pp",     "mesh-pp-hc"},
         { "meshing-flush",  "no-meshing-flush" },
+        { "meshing-flush",  "meshing-mem-budget" },
+        { "no-meshing-flush", "meshing-mem-budget" },
         { "no-analysis",    "meshing" },
         { "no-analysis",    "force-meshing" },
         { "no-analysis",    "meshing-individual-surfaces"           },
+        { "no-analysis",    "ana-cache"                             },
         { "no-analysis",    "meshing-cansurf-angularsegments",      },
+        { "no-analysis",    "meshing-lods",                         },
+        { "no-meshing",     "meshing-lods"                          },
+        { "meshing-cansurf-angularsegments", "meshing-lods"         },
         { "no-analysis",    "meshing-outerloop-maxiter",            },
         { "no-analysis",    "meshing-innerloop-maxiter",            },
         { "no-analysis",    "meshing-flush",                        },
         { "no-analysis",    "no-meshing-flush",                     },
+        { "no-analysis",    "meshing-mem-budget",                   },
         { "no-analysis",    "meshing-merging-initial-radiusfactor", },
         { "no-analysis",    "meshing-merging-radiusfactor-decrement"},
         { "no-analysis",    "meshing-complexedge-max-growthfactor"  },
@@ -169,6 +189,7 @@ const std::string usage_string =
 "analysis approach.\n"\
 "\n"\
 "Usage: am_cellgen -i <NETWORKNAME> [OPTIONS]\n"\
+"       am_cellgen -batch <LIST|DIRECTORY> [OPTIONS]\n"\
 "\n"\
 "Command line switches:\n"\
 " -i <NETWORKNAME>               MANDATORY: specify input cell network name. \n"\
@@ -182,6 +203,32 @@ const std::string usage_string =
 "                                if \"ri05.CNG\". using \"ri05.CNG.obj\" would yield\n"\
 "                                the same network name.\n"\
 "\n"\
+" -batch <LIST|DIRECTORY>        process many cell networks in one process\n"\
+"                                instead of a single one given with -i. the\n"\
+"                                argument is either a directory, in which case\n"\
+"                                all \".swc\" files contained in it are processed,\n"\
+"                                or a text file listing one SWC file per line\n"\
+"                                (empty lines and lines starting with \"#\" are\n"\
+"                                ignored). all other options apply to every\n"\
+"                                network, output files are named as for -i and\n"\
+"                                written next to the respective input file.\n"\
+"                                a failing network does not abort the batch.\n"\
+"\n"\
+" -batch-nthreads <n>            number of cell networks processed concurrently\n"\
+"                                in batch mode. each of them additionally uses\n"\
+"                                -ana-nthreads analysis threads. every network\n"\
+"                                uses its own random number generator with a\n"\
+"                                fixed seed, the output is thus independent of n.\n"\
+"                                n must be > 0.\n"\
+"                                DEFAULT: 1.\n"\
+"\n"\
+" -batch-report <file>           file to which the batch summary report is\n"\
+"                                written. the report lists status (ok, unclean,\n"\
+"                                failed), processing time, output files and\n"\
+"                                error message of every network, separated by\n"\
+"                                tabs.\n"\
+"                                DEFAULT: \"am_cellgen_batch_report.txt\".\n"\
+"\n"\
 " -analysis                  \n"\
 " -no-analysis                   enable / disable geometric analysis. once a\n"\
 "                                single full geometric analysis run completes,\n"\
@@ -199,8 +246,11 @@ const std::string usage_string =
 "                                DEFAULT: enabled.\n"\
 "\n"\
 " -ana-nthreads <n>              number of worker threads used during geometric\n"\
-"                                analysis. work is distributed approximately\n"\
-"                                evenly among all threads. if the host CPU\n"\
+"                                analysis, for parsing the input SWC file and for\n"\
+"                                planning the segment splits of cell network\n"\
+"                                preconditioning. work is\n"\
+"                                distributed approximately evenly among all\n"\
+"                                threads. if the host CPU\n"\
 "                                supports hyper-threading, a good choice is 2*n,\n"\
 "                                otherwise n, where n is the number of physical\n"\
 "                                cores of the CPU. n must be > 0.\n"\
@@ -218,6 +268,21 @@ const std::string usage_string =
 "                                <eps> must be in [1E-11, 1E-3].\n"\
 "                                DEFAULT: 1E-4.\n"\
 "\n"\
+" -ana-cache                     cache the cell network after reading the SWC\n"\
+"                                file, preconditioning and radius scaling in\n"\
+"                                the binary file\n"\
+"\n"\
+"                                \"<CELLNETWORK>.amc\"\n"\
+"\n"\
+"                                and reuse it in subsequent runs, which then\n"\
+"                                skip these steps. the cache is rewritten if the\n"\
+"                                SWC file (size or modification time), the\n"\
+"                                preconditioning parameters or the radius\n"\
+"                                scaling factor have changed. all other options,\n"\
+"                                in particular all meshing options, may differ\n"\
+"                                between runs sharing a cache.\n"\
+"                                DEFAULT: disabled.\n"\
+"\n"\
 " -cellnet-pc <alpha> <beta> <gamma>\n"\
 " -no-cellnet-pc\n"\
 "                                enable / disable cell network preconditioning.\n"\
@@ -341,6 +406,31 @@ const std::string usage_string =
 "                                amount of available RAM is exceeded.\n"\
 "                                DEFAULT: enabled, <flush_face_limit> = 100000.\n"\
 "\n"\
+" -meshing-mem-budget <MB>       enable mesh flushing with a memory budget\n"\
+"                                instead of a face count limit. requires\n"\
+"                                -meshing and -analysis, excludes\n"\
+"                                -meshing-flush. a partial flush is triggered\n"\
+"                                whenever the estimated memory consumption of\n"\
+"                                the partially completed cell mesh exceeds <MB>\n"\
+"                                megabytes. if the parts of the mesh that are\n"\
+"                                still needed exceed the budget, the mesh has\n"\
+"                                to grow by another eighth of the budget before\n"\
+"                                the next flush. <MB> must be > 0.\n"\
+"                                DEFAULT: disabled, face count limit is used.\n"\
+"\n"\
+" -meshing-nthreads <n>          number of worker threads used during inductive\n"\
+"                                cell meshing. for n > 1, the neurite path trees\n"\
+"                                of all neurites are meshed concurrently into\n"\
+"                                separate meshes, which are then merged into the\n"\
+"                                cell mesh one after another. trees that can't\n"\
+"                                be meshed this way are meshed path by path as\n"\
+"                                for n = 1. the output mesh is deterministic,\n"\
+"                                but differs from the one obtained for n = 1.\n"\
+"                                with -meshing-individual-surfaces, all surface\n"\
+"                                meshes are generated and written concurrently.\n"\
+"                                n must be > 0.\n"\
+"                                DEFAULT: 1.\n"\
+"\n"\
 " -meshing-soma-refs <n>         defines the number of refinements performed on an\n"
 "                                icosahedron to represent the soma sphere,\n"
 "                                default value: 3.\n"
@@ -364,6 +454,20 @@ const std::string usage_string =
 "                                vertex / face count.\n"\
 "                                DEFAULT: <nseg> = 6.\n"\
 "\n"\
+" -meshing-lods <nseg_1,...,nseg_k>\n"\
+"                                render the cell network at several levels of\n"\
+"                                detail in one run instead of a single mesh:\n"\
+"                                for every comma-separated <nseg_i>, a mesh with\n"\
+"                                <nseg_i> angular segments is written to\n"\
+"                                \"<CELLNETWORK>_lod<nseg_i>.obj\" and, if\n"\
+"                                enabled, post-processed separately. input,\n"\
+"                                preconditioning, partitioning and analysis are\n"\
+"                                performed once, the levels are meshed on up to\n"\
+"                                -meshing-nthreads threads. each <nseg_i> must be\n"\
+"                                in [3, 64]. excludes\n"\
+"                                -meshing-cansurf-angularsegments.\n"\
+"                                DEFAULT: a single mesh, no levels of detail.\n"\
+"\n"\
 " -meshing-triangle-height <h>   Defines the factor by which the optimal height of\n"
 "                                canal surface triangles is multiplied. This argument\n"
 "                                is useful to reduce the number of faces in the output\n"
@@ -495,6 +599,27 @@ const std::string usage_string =
 "                                and set debug level to <lvl>.\n"\
 "                                Debug component 0 is global debugging.\n"\
 "\n"\
+" -profile-out <file>            write a JSON profiling report to <file>: wall\n"\
+"                                and cpu time per pipeline stage (swc input,\n"\
+"                                preconditioning, partition, geometry,\n"\
+"                                analysis job generation and solving per job\n"\
+"                                type, meshing per neurite path, RedBlue merges,\n"\
+"                                flushes, post-processing, output), counters\n"\
+"                                (analysis jobs, intersections, RedBlue retries\n"\
+"                                per cause, flushed faces) and peak resident\n"\
+"                                memory. stage cpu times refer to the thread\n"\
+"                                executing the stage. in batch mode, the report\n"\
+"                                aggregates over all networks.\n"\
+"\n"\
+" -trace-out <file>              record scoped events of all threads (pipeline\n"\
+"                                stages, analysis worker threads and jobs,\n"\
+"                                meshing iterations per neurite path, RedBlue\n"\
+"                                union calls) and write them in chrome trace\n"\
+"                                JSON format to <file>, which can be opened in\n"\
+"                                chrome://tracing or https://ui.perfetto.dev.\n"\
+"                                only available if am_cellgen has been built\n"\
+"                                with cmake -DTRACING=ON.\n"\
+"\n"\
 " -h                             display this help message.\n";
 
 
@@ -514,6 +639,7 @@ AnaMorph_cellgen::AnaMorph_cellgen(
     this->ana_nthreads                              = 1;
     this->ana_univar_solver_eps                     = 1E-6;
     this->ana_bivar_solver_eps                      = 1E-4;
+    this->ana_cache                                 = false;
 
     this->partition_algo                            = NLM_CellNetwork<double>::partition_select_max_chordal_depth(
                                                           M_PI / 2.0,
@@ -526,6 +652,8 @@ AnaMorph_cellgen::AnaMorph_cellgen(
 
     this->meshing_flush                             = true;
     this->meshing_flush_face_limit                  = 100000;
+    this->meshing_mem_budget                        = 0;
+    this->meshing_nthreads                          = 1;
 
     this->meshing_n_soma_refs                       = 3;
     this->scale_radius                              = 1.0;
@@ -554,6 +682,9 @@ AnaMorph_cellgen::AnaMorph_cellgen(
     this->pp_hc_alpha                               = 0.4;
     this->pp_hc_beta                                = 0.7;
     this->pp_hc_maxiter                             = 10;
+
+    this->batch_report                              = "am_cellgen_batch_report.txt";
+    this->batch_nthreads                            = 1;
 }
 
 bool
@@ -577,6 +708,31 @@ AnaMorph_cellgen::processCommandLineArguments()
         if (s == "i") {
             this->network_name = s_args.front();
         }
+        else if (s == "batch") {
+            this->batch_input = s_args.front();
+        }
+        else if (s == "batch-report") {
+            this->batch_report = s_args.front();
+        }
+        else if (s == "batch-nthreads") {
+            try {
+                this->batch_nthreads = stou(s_args[0]);
+            }
+            catch (std::out_of_range& ex) {
+                printf("ERROR: argument to switch \"batch-nthreads\" out of range.\n");
+                return false;
+            }
+            catch (...) {
+                printf("ERROR: argument to switch \"batch-nthreads\" could not be converted to an unsigned integer.\n");
+                return false;
+            }
+
+            /* check value */
+            if (this->batch_nthreads == 0) {
+                printf("ERROR: number of concurrently processed cell networks must be >= 1\n");
+                return false;
+            }
+        }
         else if (s == "analysis") {
             this->ana = true;
         }
@@ -595,6 +751,9 @@ AnaMorph_cellgen::processCommandLineArguments()
         else if (s == "meshing-individual-surfaces") {
             this->meshing_individual_surfaces = true;
         }
+        else if (s == "ana-cache") {
+            this->ana_cache = true;
+        }
         else if (s == "cellnet-pc") {
             try {
                 this->pc        = true;
@@ -863,6 +1022,41 @@ AnaMorph_cellgen::processCommandLineArguments()
                 return false;
             }
         }
+        else if (s == "meshing-lods") {
+            std::string const  &list    = s_args[0];
+            size_t              start   = 0;
+
+            this->meshing_lods.clear();
+            while (start <= list.size()) {
+                size_t end = list.find(',', start);
+                if (end == std::string::npos) {
+                    end = list.size();
+                }
+
+                uint32_t n_phi;
+                try {
+                    n_phi = stou(list.substr(start, end - start));
+                }
+                catch (std::out_of_range& ex) {
+                    printf("ERROR: at least one argument to switch \"meshing-lods\" out of range.\n");
+                    return false;
+                }
+                catch (...) {
+                    printf("ERROR: argument to switch \"meshing-lods\" must be a comma-separated list of unsigned integers.\n");
+                    return false;
+                }
+
+                /* check value */
+                if (n_phi < 3 || n_phi > 64) {
+                    printf("ERROR: angular segment counts specified in switch \"meshing-lods\" must be in [3,64].\n");
+                    return false;
+                }
+                if (std::find(this->meshing_lods.begin(), this->meshing_lods.end(), n_phi) == this->meshing_lods.end()) {
+                    this->meshing_lods.push_back(n_phi);
+                }
+                start = end + 1;
+            }
+        }
         else if (s == "meshing-outerloop-maxiter") {
             try {
                 this->meshing_outer_loop_maxiter = stou(s_args[0]);
@@ -945,6 +1139,45 @@ AnaMorph_cellgen::processCommandLineArguments()
         else if (s == "no-meshing-flush") {
             this->meshing_flush = false;
         }
+        else if (s == "meshing-mem-budget") {
+            try {
+                this->meshing_flush         = true;
+                this->meshing_mem_budget    = stou(s_args[0]);
+            }
+            catch (std::out_of_range& ex) {
+                printf("ERROR: argument to switch \"meshing-mem-budget\" out of range.\n");
+                return false;
+            }
+            catch (...) {
+                printf("ERROR: argument to switch \"meshing-mem-budget\" could not be converted to an unsigned integer.\n");
+                return false;
+            }
+
+            /* check value */
+            if (this->meshing_mem_budget == 0) {
+                printf("ERROR: meshing memory budget must be >= 1 MB\n");
+                return false;
+            }
+        }
+        else if (s == "meshing-nthreads") {
+            try {
+                this->meshing_nthreads = stou(s_args[0]);
+            }
+            catch (std::out_of_range& ex) {
+                printf("ERROR: argument to switch \"meshing-nthreads\" out of range.\n");
+                return false;
+            }
+            catch (...) {
+                printf("ERROR: argument to switch \"meshing-nthreads\" could not be converted to an unsigned integer.\n");
+                return false;
+            }
+
+            /* check value */
+            if (this->meshing_nthreads == 0) {
+                printf("ERROR: number of meshing threads must be >= 1\n");
+                return false;
+            }
+        }
         else if (s == "meshing-merging-radiusfactor-decrement") {
             try {
                 this->meshing_radius_factor_decrement = std::stod(s_args[0]);
@@ -1001,6 +1234,17 @@ AnaMorph_cellgen::processCommandLineArguments()
                 return false;
             }
         }
+        else if (s == "profile-out") {
+            this->profile_out = s_args.front();
+        }
+        else if (s == "trace-out") {
+#ifdef __TRACING__
+            this->trace_out = s_args.front();
+#else
+            printf("ERROR: switch \"trace-out\" requires am_cellgen to be built with tracing support (cmake -DTRACING=ON).\n");
+            return false;
+#endif
+        }
         else {
             printf("ERROR: unknown command line switch \"%s\".\n%s",
                 s.c_str(), this->usage_text.c_str());
@@ -1009,163 +1253,275 @@ AnaMorph_cellgen::processCommandLineArguments()
     }
 
     /* further checks on successfully parsed command line arguments */
-    if (this->network_name == "") {
+    if (this->network_name == "" && this->batch_input == "") {
         printf("ERROR: no input file name given.\n");
         return false;
     }
     /* remove .swc suffix from network_name */
-    else {
-        size_t  network_name_last_dot_index = this->network_name.find_last_of(".");
-        if (network_name_last_dot_index != std::string::npos) {
-            std::string network_name_extension = this->network_name.substr(network_name_last_dot_index, std::string::npos);
-            if (    network_name_extension != ".swc" &&
-                    network_name_extension != ".amv" &&
-                    network_name_extension != ".obj" &&
-                    network_name_extension != ".CNG")
-            {
-                printf("ERROR: input file name invalid.\n");
-                return false;
-            }
-            else {
-                if (network_name_extension != ".CNG") {
-                    this->network_name = this->network_name.substr(0, network_name_last_dot_index);
-                }
-            }
-        }
+    else if (this->network_name != "" && !this->stripNetworkNameExtension(this->network_name)) {
+        printf("ERROR: input file name invalid.\n");
+        return false;
     }
 
     return true;
 }
 
 bool
-AnaMorph_cellgen::run()
+AnaMorph_cellgen::stripNetworkNameExtension(std::string &name) const
 {
-    try {
-        /* process command line arguments and return false if an error has occurred */
-        if (!this->processCommandLineArguments()) {
+    size_t  name_last_dot_index = name.find_last_of(".");
+    size_t  name_last_sep_index = name.find_last_of("/");
+
+    /* dots in directory names do not start an extension */
+    if (name_last_dot_index != std::string::npos &&
+        (name_last_sep_index == std::string::npos || name_last_dot_index > name_last_sep_index))
+    {
+        std::string name_extension = name.substr(name_last_dot_index, std::string::npos);
+        if (    name_extension != ".swc" &&
+                name_extension != ".amv" &&
+                name_extension != ".obj" &&
+                name_extension != ".CNG")
+        {
             return false;
         }
+        else {
+            if (name_extension != ".CNG") {
+                name = name.substr(0, name_last_dot_index);
+            }
+        }
+    }
+    return true;
+}
 
-        /* try to open input file */
-        printf("AnaMorph cell generator (non-linear geometric modelling). swc input file name: \"%s.swc\"\n", this->network_name.c_str());
-
-        /* analysis and mesh generation */
-        if (this->ana) {
-            printf("reading network from input swc file \"%s.swc\"..", this->network_name.c_str());fflush(stdout);
-            NLM_CellNetwork<double> C(this->network_name);
-            C.readFromNeuroMorphoSWCFile( this->network_name + ".swc", false);
-
-            printf("done.\n"\
-                "\t neuron vertices: %6zu   somas:              %6zu  axon vertices:   %6zu  dendrite vertices:   %6zu\n"\
-                "\t neuron edges:    %6zu   neurite root edges: %6zu  axon root edges: %6zu  dendrite root edges: %6zu\n"\
-                "\t axon segments:   %6zu   dendrite segments:  %6zu\n\n",
-                    C.neuron_vertices.size(), C.soma_vertices.size(), C.axon_vertices.size(), C.dendrite_vertices.size(),
-                    C.neuron_edges.size(), C.neurite_root_edges.size(), C.axon_root_edges.size(), C.dendrite_root_edges.size(), C.axon_segments.size(), C.dendrite_segments.size());
-
-            /* retrieve, update and store settings inside network */
-            NLM_CellNetwork<double>::Settings C_settings = C.getSettings();
+bool
+AnaMorph_cellgen::getCacheKey(
+    std::string const  &swc_filename,
+    uint64_t           &key) const
+{
+    using CellNetworkCache::hash;
 
-            C_settings.analysis_nthreads                        = this->ana_nthreads;
-            C_settings.analysis_univar_solver_eps               = this->ana_univar_solver_eps;
-            C_settings.analysis_bivar_solver_eps                = this->ana_bivar_solver_eps;
+    struct stat st;
+    if (stat(swc_filename.c_str(), &st) != 0) {
+        return false;
+    }
 
-            C_settings.partition_algo                           = this->partition_algo;
-            C_settings.parametrization_algo                     = this->parametrization_algo;
+    /* modification time with nanosecond resolution, so that a file rewritten within the same second as the cache
+     * does not match it */
+    int64_t const   size        = st.st_size;
+    int64_t const   mtime       = st.st_mtime;
+#ifdef __APPLE__
+    int64_t const   mtime_nsec  = st.st_mtimespec.tv_nsec;
+#else
+    int64_t const   mtime_nsec  = st.st_mtim.tv_nsec;
+#endif
+    uint8_t const   pc          = this->pc;
+
+    key = CellNetworkCache::hash_seed;
+    key = hash(key, &size,                 sizeof(size));
+    key = hash(key, &mtime,                sizeof(mtime));
+    key = hash(key, &mtime_nsec,           sizeof(mtime_nsec));
+    key = hash(key, &pc,                   sizeof(pc));
+    key = hash(key, &this->pc_alpha,       sizeof(this->pc_alpha));
+    key = hash(key, &this->pc_beta,        sizeof(this->pc_beta));
+    key = hash(key, &this->pc_gamma,       sizeof(this->pc_gamma));
+    key = hash(key, &this->scale_radius,   sizeof(this->scale_radius));
+    return true;
+}
 
-            C_settings.meshing_flush                            = this->meshing_flush;
-            C_settings.meshing_flush_face_limit                 = this->meshing_flush_face_limit;
+bool
+AnaMorph_cellgen::processNetwork(
+    std::string const          &name,
+    std::vector<std::string>   &outputs) const
+{
+    bool clean = true;
 
-            C_settings.meshing_n_soma_refs                      = this->meshing_n_soma_refs;
-            C_settings.meshing_canal_segment_n_phi_segments     = this->meshing_canal_segment_n_phi_segments;
-            C_settings.meshing_outer_loop_maxiter               = this->meshing_outer_loop_maxiter;
-            C_settings.meshing_inner_loop_maxiter               = this->meshing_inner_loop_maxiter;
+    /* analysis and mesh generation */
+    if (this->ana) {
+        NLM_CellNetwork<double> C(name);
 
-            C_settings.meshing_preserve_crease_edges            = this->meshing_preserve_crease_edges;
-            C_settings.meshing_cansurf_triangle_height_factor	= this->meshing_cansurf_triangle_height_factor;
+        /* try to reuse cached network, which has already been preconditioned and scaled */
+        std::string const   cache_filename  = name + ".amc";
+        uint64_t            cache_key       = 0;
+        bool const          use_cache       = this->ana_cache && this->getCacheKey(name + ".swc", cache_key);
+        bool                cached          = false;
 
-            C_settings.meshing_radius_factor_decrement          = this->meshing_radius_factor_decrement;
-            C_settings.meshing_complex_edge_max_growth_factor   = this->meshing_complex_edge_max_growth_factor;
+        if (use_cache) {
+            printf("reading network from cache file \"%s\"..", cache_filename.c_str());fflush(stdout);
+            {
+                Profiling::ScopedStage stage("read_cache");
+                cached = C.readBinaryCache(cache_filename, cache_key);
+            }
+            if (!cached) {
+                printf("not present or stale.\n");
+            }
+        }
 
-            C.updateSettings(C_settings);
-            
-            // This does not seem to be necessary and is really annoying when trying to
-            // match original 1d positions to 3d positions generated with AnaMorph.
-            /*
-            // transform cell network to centroid system
-            printf("transforming network coordinate system to soma 0 as origin.. ");fflush(stdout);
-            C.transformToSomaSystem(C.soma_vertices.begin());
-            printf("done.\n");
-            */
+        if (!cached) {
+            printf("reading network from input swc file \"%s.swc\"..", name.c_str());fflush(stdout);
+            Profiling::ScopedStage stage("read_swc");
+            C.readFromNeuroMorphoSWCFile( name + ".swc", false, this->ana_nthreads);
+        }
 
-            /* apply preconditioning algorithm */
-            if (this->pc) {
-                printf("applying cell network preconditioning. parameters:\n"\
-                    "\t alpha = %5.4f\n\t beta = %5.4f\n\t gamma = %5.4f\n",
-                    this->pc_alpha, this->pc_beta, this->pc_gamma);
-                fflush(stdout);
+        printf("done.\n"\
+            "\t neuron vertices: %6zu   somas:              %6zu  axon vertices:   %6zu  dendrite vertices:   %6zu\n"\
+            "\t neuron edges:    %6zu   neurite root edges: %6zu  axon root edges: %6zu  dendrite root edges: %6zu\n"\
+            "\t axon segments:   %6zu   dendrite segments:  %6zu\n\n",
+                C.neuron_vertices.size(), C.soma_vertices.size(), C.axon_vertices.size(), C.dendrite_vertices.size(),
+                C.neuron_edges.size(), C.neurite_root_edges.size(), C.axon_root_edges.size(), C.dendrite_root_edges.size(), C.axon_segments.size(), C.dendrite_segments.size());
+
+        /* retrieve, update and store settings inside network */
+        NLM_CellNetwork<double>::Settings C_settings = C.getSettings();
+
+        C_settings.analysis_nthreads                        = this->ana_nthreads;
+        C_settings.analysis_univar_solver_eps               = this->ana_univar_solver_eps;
+        C_settings.analysis_bivar_solver_eps                = this->ana_bivar_solver_eps;
+
+        C_settings.partition_algo                           = this->partition_algo;
+        C_settings.parametrization_algo                     = this->parametrization_algo;
+
+        C_settings.meshing_flush                            = this->meshing_flush;
+        C_settings.meshing_flush_face_limit                 = this->meshing_flush_face_limit;
+        C_settings.meshing_mem_budget                       = this->meshing_mem_budget;
+        C_settings.meshing_nthreads                         = this->meshing_nthreads;
+
+        C_settings.meshing_n_soma_refs                      = this->meshing_n_soma_refs;
+        C_settings.meshing_canal_segment_n_phi_segments     = this->meshing_canal_segment_n_phi_segments;
+        C_settings.meshing_outer_loop_maxiter               = this->meshing_outer_loop_maxiter;
+        C_settings.meshing_inner_loop_maxiter               = this->meshing_inner_loop_maxiter;
+
+        C_settings.meshing_preserve_crease_edges            = this->meshing_preserve_crease_edges;
+        C_settings.meshing_cansurf_triangle_height_factor	= this->meshing_cansurf_triangle_height_factor;
+
+        C_settings.meshing_radius_factor_decrement          = this->meshing_radius_factor_decrement;
+        C_settings.meshing_complex_edge_max_growth_factor   = this->meshing_complex_edge_max_growth_factor;
+
+        C.updateSettings(C_settings);
+        
+        // This does not seem to be necessary and is really annoying when trying to
+        // match original 1d positions to 3d positions generated with AnaMorph.
+        /*
+        // transform cell network to centroid system
+        printf("transforming network coordinate system to soma 0 as origin.. ");fflush(stdout);
+        C.transformToSomaSystem(C.soma_vertices.begin());
+        printf("done.\n");
+        */
+
+        /* apply preconditioning algorithm */
+        if (this->pc && !cached) {
+            printf("applying cell network preconditioning. parameters:\n"\
+                "\t alpha = %5.4f\n\t beta = %5.4f\n\t gamma = %5.4f\n",
+                this->pc_alpha, this->pc_beta, this->pc_gamma);
+            fflush(stdout);
+
+            Profiling::ScopedStage stage("preconditioning");
+            CellNetworkAlg::preliminaryPreconditioning(C, this->pc_alpha, this->pc_beta, this->pc_gamma, this->ana_nthreads);
+            printf("done.\n\n");
+        }
 
-                CellNetworkAlg::preliminaryPreconditioning(C, this->pc_alpha, this->pc_beta, this->pc_gamma);
-                printf("done.\n\n");
-            }
+        // possibly scale radius (useful to create a cell-in-cell ER)
+        if (scale_radius != 1.0 && !cached)
+        {
+            std::cout << "scaling radii using factor " << scale_radius << "." << std::endl;
+            CellNetworkAlg::scale_radii(C, scale_radius);
+        }
 
-            // possibly scale radius (useful to create a cell-in-cell ER)
-            if (scale_radius != 1.0)
+        if (use_cache && !cached) {
+            printf("writing cell network cache file \"%s\".. ", cache_filename.c_str());fflush(stdout);
             {
-                std::cout << "scaling radii using factor " << scale_radius << "." << std::endl;
-                CellNetworkAlg::scale_radii(C, scale_radius);
+                Profiling::ScopedStage stage("write_cache");
+                C.writeBinaryCache(cache_filename, cache_key);
             }
+            printf("done.\n");
+        }
 
-            /* partition cell network and update geometry */
-            printf("partitioning cell network.. ");fflush(stdout);
+        /* partition cell network and update geometry */
+        printf("partitioning cell network.. ");fflush(stdout);
+        {
+            Profiling::ScopedStage stage("partition");
             C.partitionNetwork();
-            printf("done.\n");
+        }
+        printf("done.\n");
 
-            printf("updating cell network geometry.. ");fflush(stdout);
+        printf("updating cell network geometry.. ");fflush(stdout);
+        {
+            Profiling::ScopedStage stage("geometry");
             C.updateNetworkGeometry();
-            printf("done.\n");
+        }
+        printf("done.\n");
 
-            /* perform full analysis */
-            printf("performing single full geometric analysis iteration.. ");fflush(stdout);
-            bool clean = C.performFullAnalysis();
-            printf("done.\n");
+        /* perform full analysis */
+        printf("performing single full geometric analysis iteration.. ");fflush(stdout);
+        {
+            Profiling::ScopedStage stage("analysis");
+            clean = C.performFullAnalysis();
+        }
+        printf("done.\n");
 
 #if 0	// This is meaningless unless one has the morphview code.
-            /* output morphology viewer file */
-            printf("writing AnaMorph visualization file \"%s.amv\".. ", this->network_name.c_str());fflush(stdout);
-            C.writeMorphViewFile( std::string(network_name) + ".amv");
-            printf("done.\n");
+        /* output morphology viewer file */
+        printf("writing AnaMorph visualization file \"%s.amv\".. ", name.c_str());fflush(stdout);
+        C.writeMorphViewFile( std::string(name) + ".amv");
+        printf("done.\n");
 #endif
 
-            /* render cell network mesh */
-            if (clean || this->force_meshing) {
-                printf("rendering cell network to consistent mesh \"%s.obj\".\n", network_name.c_str());
-                if (this->force_meshing) {
-                    printf("\t NOTE: meshing forced in spite of potentially unclean network.\n");fflush(stdout);
+        /* render cell network mesh */
+        if (clean || this->force_meshing) {
+            printf("rendering cell network to consistent mesh \"%s.obj\".\n", name.c_str());
+            if (this->force_meshing) {
+                printf("\t NOTE: meshing forced in spite of potentially unclean network.\n");fflush(stdout);
+            }
+
+            Profiling::ScopedStage stage("meshing");
+            if (this->meshing_lods.empty()) {
+                C.renderCellNetwork<bool, bool, bool>(name);
+                outputs.push_back(name + ".obj");
+            }
+            else {
+                printf("\t rendering %zu levels of detail.\n", this->meshing_lods.size());fflush(stdout);
+                C.renderCellNetworkLODs<bool, bool, bool>(name, this->meshing_lods);
+                for (uint32_t n_phi : this->meshing_lods) {
+                    outputs.push_back(name + "_lod" + std::to_string(n_phi) + ".obj");
                 }
+            }
 
-                C.renderCellNetwork<bool, bool, bool>(network_name);
+            printf("done.\n\n");
+        }
+     
+        if (this->meshing_individual_surfaces) {
+            std::string ims_filename = std::string(name + "_individual_modelling_surfaces");
 
-                printf("done.\n\n");
-            }
-         
-            if (this->meshing_individual_surfaces) {
-                std::string ims_filename = std::string(network_name + "_individual_modelling_surfaces");
+            printf("rendering cell network modelling surfaces individually to output mesh \"%s.obj\".\n", ims_filename.c_str());fflush(stdout);
+            /* render geometric modelling surfaces individually and output mesh */
+            Profiling::ScopedStage stage("meshing_individual_surfaces");
+            C.renderModellingMeshesIndividually<bool, bool, bool>(ims_filename);
+            outputs.push_back(ims_filename + ".obj");
 
-                printf("rendering cell network modelling surfaces individually to output mesh \"%s.obj\".\n", ims_filename.c_str());fflush(stdout);
-                /* render geometric modelling surfaces individually and output mesh */
-                C.renderModellingMeshesIndividually<bool, bool, bool>(std::string(network_name + "_individual_modelling_surfaces"));
+            printf("done.\n");
+        }
+    }
 
-                printf("done.\n");
+    /* mesh-post-processing, applied to every level of detail if several have been rendered */
+    if (this->pp_gec || this->pp_hc) {
+        std::vector<std::string> mesh_names;
+        if (this->meshing_lods.empty()) {
+            mesh_names.push_back(name);
+        }
+        else {
+            for (uint32_t n_phi : this->meshing_lods) {
+                mesh_names.push_back(name + "_lod" + std::to_string(n_phi));
             }
         }
 
-        /* mesh-post-processing */
-        if (this->pp_gec || this->pp_hc) {
-            printf("post-processing union mesh \"%s.obj\".\n", this->network_name.c_str() );
+        for (auto const &mesh_name : mesh_names) {
+            printf("post-processing union mesh \"%s.obj\".\n", mesh_name.c_str() );
             /* reload mesh to ram */
             Mesh<bool, bool, bool, double> M_cell;
             try {
-                M_cell.readFromObjFile( (network_name + ".obj").c_str());
+                {
+                    Profiling::ScopedStage stage("post_processing/read_obj");
+                    M_cell.readFromObjFile( (mesh_name + ".obj").c_str());
+                }
+
                 if (this->pp_gec) {
                     printf("\t stage 1: improved edge-collapse algorithm. parameters:\n"\
                         "\t\t alpha:  %5.4f\n"\
@@ -1174,6 +1530,7 @@ AnaMorph_cellgen::run()
                         "\t\t d:      %5d\n",
                         this->pp_gec_alpha, this->pp_gec_lambda, this->pp_gec_mu, this->pp_gec_d);
 
+                    Profiling::ScopedStage stage("post_processing/gec");
                     MeshAlg::greedyEdgeCollapsePostProcessing(
                         M_cell,
                         this->pp_gec_alpha,
@@ -1189,6 +1546,7 @@ AnaMorph_cellgen::run()
                         "\t\t maxiter: %5d\n",
                         this->pp_hc_alpha, this->pp_hc_beta, this->pp_hc_maxiter);
 
+                    Profiling::ScopedStage stage("post_processing/hc");
                     MeshAlg::HCLaplacianSmoothing(
                         M_cell,
                         this->pp_hc_alpha,
@@ -1196,7 +1554,11 @@ AnaMorph_cellgen::run()
                         this->pp_hc_maxiter);
                 }
 
-                M_cell.writeObjFile( (this->network_name + "_post_processed").c_str() );
+                {
+                    Profiling::ScopedStage stage("post_processing/write_obj");
+                    M_cell.writeObjFile( (mesh_name + "_post_processed").c_str() );
+                }
+                outputs.push_back(mesh_name + "_post_processed.obj");
             }
             catch (MeshEx& e) {
                 if (e.error_type == MESH_IO_ERROR) {
@@ -1206,31 +1568,298 @@ AnaMorph_cellgen::run()
             }
             printf("done.\n\n");
         }
-        printf("all tasks performed. shutting down..\n");
-        return EXIT_SUCCESS;
+    }
+
+    return clean;
+}
+
+bool
+AnaMorph_cellgen::run()
+{
+    int rc = EXIT_SUCCESS;
+
+    try {
+        /* process command line arguments and return false if an error has occurred */
+        if (!this->processCommandLineArguments()) {
+            return false;
+        }
+
+        if (this->profile_out != "") {
+            Profiling::reset();
+            Profiling::enable(true);
+
+            /* canal surface mesh generation throughput */
+            Profiling::addRate("meshing/generated_triangles_per_sec", "meshing/generated_triangles", "meshing/generate");
+            Profiling::addRate(
+                "meshing_individual_surfaces/generated_triangles_per_sec",
+                "meshing_individual_surfaces/generated_triangles",
+                "meshing_individual_surfaces/generate");
+        }
+
+#ifdef __TRACING__
+        if (this->trace_out != "") {
+            Tracing::enable(true);
+            Tracing::setThreadName("main");
+        }
+#endif
+
+        if (this->batch_input != "") {
+            rc = this->runBatch();
+        }
+        else {
+            /* try to open input file */
+            printf("AnaMorph cell generator (non-linear geometric modelling). swc input file name: \"%s.swc\"\n", this->network_name.c_str());
+
+            std::vector<std::string> outputs;
+            this->processNetwork(this->network_name, outputs);
+
+            printf("all tasks performed. shutting down..\n");
+        }
     }
     catch (char const *x) {
         printf("ERROR: Caught string exception at top level. message: \"%s\"\n", x);
-        return  EXIT_FAILURE;
+        rc = EXIT_FAILURE;
     }
     catch (std::string& x) {
         printf("ERROR: Caught string exception at top level. message: \"%s\"\n", x.c_str());
-        return  EXIT_FAILURE;
+        rc = EXIT_FAILURE;
     }
     catch (GraphEx& e) {
         printf("ERROR: Caught GraphEx exception at top level. message: \"%s\".\n", e.error_msg.c_str());
-        return  EXIT_FAILURE;
+        rc = EXIT_FAILURE;
     }
     catch (MeshEx& e) {
         printf("ERROR: Caught MeshEx exception at top level. message: \"%s\".\n", e.error_msg.c_str());
-        return  EXIT_FAILURE;
+        rc = EXIT_FAILURE;
     }
     catch (std::runtime_error& e) {
         printf("ERROR: Caught std::runtime_error exception at top level. message: \"%s\".\n", e.what());
-        return  EXIT_FAILURE;
+        rc = EXIT_FAILURE;
     }
     catch (...) {
         printf("ERROR: Caught unhandled exception at top level.\n");
+        rc = EXIT_FAILURE;
+    }
+
+    /* write profiling report, also if processing failed, since the stages completed so far are still of interest */
+    if (this->profile_out != "") {
+        std::string meshing_lods_str;
+        for (uint32_t n_phi : this->meshing_lods) {
+            meshing_lods_str += (meshing_lods_str.empty() ? "" : ",") + std::to_string(n_phi);
+        }
+
+        std::map<std::string, std::string> info = {
+            { "input",          (this->batch_input != "" ? this->batch_input : this->network_name) },
+            { "mode",           (this->batch_input != "" ? "batch" : "single") },
+            { "ana_nthreads",   std::to_string(this->ana_nthreads) },
+            { "batch_nthreads", std::to_string(this->batch_nthreads) },
+            { "meshing_nthreads", std::to_string(this->meshing_nthreads) },
+            { "meshing_mem_budget", std::to_string(this->meshing_mem_budget) },
+            { "meshing_lods", meshing_lods_str },
+            { "status",         (rc == EXIT_SUCCESS ? "ok" : "failed") }
+        };
+
+        if (Profiling::writeJsonReport(this->profile_out, info)) {
+            printf("profiling report written to \"%s\".\n", this->profile_out.c_str());
+        }
+        else {
+            printf("ERROR: can't write profiling report file \"%s\".\n", this->profile_out.c_str());
+        }
+        Profiling::enable(false);
+    }
+
+#ifdef __TRACING__
+    if (this->trace_out != "") {
+        Tracing::enable(false);
+
+        if (Tracing::writeTraceFile(this->trace_out)) {
+            printf("trace written to \"%s\".\n", this->trace_out.c_str());
+        }
+        else {
+            printf("ERROR: can't write trace file \"%s\".\n", this->trace_out.c_str());
+        }
+    }
+#endif
+
+    return rc;
+}
+
+bool
+AnaMorph_cellgen::collectBatchNetworkNames(std::vector<std::string> &names) const
+{
+    struct stat st;
+
+    names.clear();
+    if (stat(this->batch_input.c_str(), &st) != 0) {
+        printf("ERROR: batch input \"%s\" does not exist.\n", this->batch_input.c_str());
+        return false;
+    }
+
+    /* directory: all contained swc files in lexicographic order */
+    if (S_ISDIR(st.st_mode)) {
+        DIR *dir = opendir(this->batch_input.c_str());
+        if (!dir) {
+            printf("ERROR: can't open batch input directory \"%s\".\n", this->batch_input.c_str());
+            return false;
+        }
+
+        std::string dirname = this->batch_input;
+        if (dirname.back() != '/') {
+            dirname += '/';
+        }
+
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+            std::string filename(entry->d_name);
+            if (filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".swc") == 0) {
+                names.push_back(dirname + filename);
+            }
+        }
+        closedir(dir);
+        std::sort(names.begin(), names.end());
+    }
+    /* list file: one swc file per line */
+    else {
+        std::ifstream   f(this->batch_input);
+        std::string     line;
+
+        if (!f.is_open()) {
+            printf("ERROR: can't open batch input list \"%s\".\n", this->batch_input.c_str());
+            return false;
+        }
+
+        while (std::getline(f, line)) {
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#') {
+                continue;
+            }
+            size_t last = line.find_last_not_of(" \t\r");
+            names.push_back(line.substr(first, last - first + 1));
+        }
+    }
+
+    if (names.empty()) {
+        printf("ERROR: batch input \"%s\" does not contain any cell networks.\n", this->batch_input.c_str());
+        return false;
+    }
+    return true;
+}
+
+int
+AnaMorph_cellgen::runBatch()
+{
+    struct NetworkReport {
+        std::string                 name;
+        std::string                 status;
+        std::string                 message;
+        std::vector<std::string>    outputs;
+        double                      time;
+    };
+
+    std::vector<std::string> names;
+    if (!this->collectBatchNetworkNames(names)) {
         return EXIT_FAILURE;
     }
+
+    uint32_t nworkers = std::min<uint32_t>(this->batch_nthreads, names.size());
+    printf("AnaMorph cell generator (non-linear geometric modelling). batch mode: %zu cell networks from \"%s\", %u concurrent networks.\n",
+        names.size(), this->batch_input.c_str(), nworkers);
+
+    /* precompute solver data shared by all networks before any worker starts */
+    PolyAlg::BiLinClip_getApproximationData<7u, 7u, double>();
+
+    std::vector<NetworkReport>  reports(names.size());
+    double                      batch_start = Aux::Timing::doubletime();
+
+    /* every network reports its own errors, so the workers never throw */
+    Aux::Parallel::forEachIndex(names.size(), nworkers,
+        [&] (size_t i, uint32_t) -> void
+        {
+            NetworkReport  &report  = reports[i];
+            double          t0      = Aux::Timing::doubletime();
+
+            report.name = names[i];
+            try {
+                if (!this->stripNetworkNameExtension(report.name)) {
+                    throw("input file name invalid.");
+                }
+
+                /* every network draws its random numbers from its own generator with a fixed seed, so that its output
+                 * does not depend on the number of workers or on thread scheduling. */
+                std::mt19937                            frand_rng(0);
+                Aux::Numbers::ScopedRandomGenerator     frand_scope(frand_rng);
+
+                printf("\n[%zu/%zu] processing cell network \"%s\".\n", i + 1, names.size(), report.name.c_str());
+                fflush(stdout);
+
+                TRACE_SCOPE_ARG("batch/network", "index", i);
+                report.status = this->processNetwork(report.name, report.outputs) ? "ok" : "unclean";
+            }
+            catch (char const *x) {
+                report.status   = "failed";
+                report.message  = std::string("caught string exception: ") + x;
+            }
+            catch (std::string& x) {
+                report.status   = "failed";
+                report.message  = "caught string exception: " + x;
+            }
+            catch (GraphEx& e) {
+                report.status   = "failed";
+                report.message  = "caught GraphEx exception: " + e.error_msg;
+            }
+            catch (MeshEx& e) {
+                report.status   = "failed";
+                report.message  = "caught MeshEx exception: " + e.error_msg;
+            }
+            catch (std::runtime_error& e) {
+                report.status   = "failed";
+                report.message  = std::string("caught std::runtime_error exception: ") + e.what();
+            }
+            catch (...) {
+                report.status   = "failed";
+                report.message  = "caught unhandled exception.";
+            }
+            report.time = Aux::Timing::doubletime() - t0;
+
+            printf("[%zu/%zu] cell network \"%s\": %s (%.2f s).\n", i + 1, names.size(), report.name.c_str(), report.status.c_str(), report.time);
+            fflush(stdout);
+        });
+
+    double      batch_time = Aux::Timing::doubletime() - batch_start;
+    uint32_t    nok = 0, nunclean = 0, nfailed = 0;
+    for (auto &report : reports) {
+        if (report.status == "ok") nok++;
+        else if (report.status == "unclean") nunclean++;
+        else nfailed++;
+    }
+
+    /* write summary report. messages are made single-line to keep the report tab-separated */
+    FILE *f = fopen(this->batch_report.c_str(), "w");
+    if (!f) {
+        printf("ERROR: can't open batch report file \"%s\".\n", this->batch_report.c_str());
+    }
+    else {
+        fprintf(f, "# am_cellgen batch report\n");
+        fprintf(f, "# input: %s\n", this->batch_input.c_str());
+        fprintf(f, "# networks: %zu, ok: %u, unclean: %u, failed: %u, concurrent networks: %u, wall time: %.3f s\n",
+            reports.size(), nok, nunclean, nfailed, nworkers, batch_time);
+        fprintf(f, "# network\tstatus\ttime[s]\toutputs\tmessage\n");
+
+        for (auto &report : reports) {
+            std::string outputs, message = report.message;
+            for (auto &o : report.outputs) {
+                outputs += (outputs.empty() ? "" : ",") + o;
+            }
+            std::replace(message.begin(), message.end(), '\n', ' ');
+            std::replace(message.begin(), message.end(), '\t', ' ');
+
+            fprintf(f, "%s\t%s\t%.3f\t%s\t%s\n", report.name.c_str(), report.status.c_str(), report.time, outputs.c_str(), message.c_str());
+        }
+        fclose(f);
+    }
+
+    printf("\nbatch done. networks: %zu, ok: %u, unclean: %u, failed: %u, wall time: %.3f s. report written to \"%s\".\n",
+        reports.size(), nok, nunclean, nfailed, batch_time, this->batch_report.c_str());
+
+    return (nfailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
 }
@@ -113,6 +113,39 @@ IdQueue::getId()
     return id;
 }
 
+/* reserve n consecutive ids, all of which are larger than any id handed out so far, and return the first one. if no id
+ * has been freed since the last refill, i.e. q holds exactly the ids ]next_id, last_id], the block starts at next_id and
+ * the result is identical to n calls of getId(). otherwise, the freed ids remain in the queue and the block starts
+ * behind last_id. */
+uint32_t
+IdQueue::getIdBlock(uint32_t n)
+{
+    uint32_t first_id;
+
+    if (this->q.size() == this->last_id - this->next_id) {
+        first_id = this->next_id;
+        if (n > UINT32_MAX - 1 - first_id) {
+            throw("IdQueue::getIdBlock(): block of requested size exceeds UINT32_MAX - 1 => overflow.");
+        }
+
+        this->q             =   std::priority_queue<
+                                    uint32_t,
+                                    std::deque<uint32_t>,
+                                    std::greater<uint32_t> > ();
+        this->next_id       = first_id + n;
+        this->last_id       = this->next_id;
+    }
+    else {
+        first_id = this->last_id + 1;
+        if (n > UINT32_MAX - 1 - this->last_id) {
+            throw("IdQueue::getIdBlock(): block of requested size exceeds UINT32_MAX - 1 => overflow.");
+        }
+        this->last_id      += n;
+    }
+
+    return first_id;
+}
+
 void
 IdQueue::freeId(uint32_t id)
 {
@@ -0,0 +1,223 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "common.hh"
+
+#include "MeshObjFlushWriter.hh"
+#include "Profiling.hh"
+
+namespace MeshAlg {
+    MeshObjFlushWriter::MeshObjFlushWriter(
+        std::string const  &filename,
+        uint32_t            max_pending)
+    :
+        filename(filename),
+        obj_file(NULL),
+        vertex_swap_file(NULL),
+        face_swap_file(NULL),
+        max_pending(std::max(max_pending, 1u)),
+        nblocks(0),
+        writing(0),
+        stop(false),
+        error(NULL)
+    {
+        this->obj_file          = fopen( (this->filename + ".obj").c_str(), "w");
+        this->vertex_swap_file  = fopen( (this->filename + "_swap_v.obj").c_str(), "w+");
+        this->face_swap_file    = fopen( (this->filename + "_swap_f.obj").c_str(), "w+");
+
+        if (!this->obj_file || !this->vertex_swap_file || !this->face_swap_file) {
+            this->closeFiles();
+            throw("MeshAlg::MeshObjFlushWriter::MeshObjFlushWriter(): couldn't open obj file or swap files for writing.");
+        }
+
+        this->io_thread = std::thread(&MeshObjFlushWriter::run, this);
+    }
+
+    MeshObjFlushWriter::~MeshObjFlushWriter()
+    {
+        try {
+            this->finish();
+        }
+        catch (...) {
+            debugl(0, "MeshObjFlushWriter::~MeshObjFlushWriter(): failed to finish obj file \"%s.obj\".\n", this->filename.c_str());
+        }
+        this->closeFiles();
+    }
+
+    void
+    MeshObjFlushWriter::closeFiles()
+    {
+        for (FILE **f : { &this->obj_file, &this->vertex_swap_file, &this->face_swap_file }) {
+            if (*f) {
+                fclose(*f);
+                *f = NULL;
+            }
+        }
+    }
+
+    char const *
+    MeshObjFlushWriter::vertexDelimiter()
+    {
+        return "# ____~V____";
+    }
+
+    void
+    MeshObjFlushWriter::run()
+    {
+        TRACE_THREAD_NAME("obj flush writer");
+
+        std::unique_lock<std::mutex> lock(this->mtx);
+        while (true) {
+            this->block_pushed.wait(lock, [this] () -> bool { return (!this->blocks.empty() || this->stop); });
+            if (this->blocks.empty()) {
+                break;
+            }
+
+            Block b = std::move(this->blocks.front());
+            this->blocks.pop_front();
+            this->writing = 1;
+
+            /* write without holding the lock, so that the meshing thread can queue the next block meanwhile */
+            if (!this->error) {
+                lock.unlock();
+                char const *write_error = NULL;
+                {
+                    Profiling::ScopedStage write_stage("meshing/flush_write");
+                    if (fwrite(b.vertex_lines.data(), 1, b.vertex_lines.size(), this->vertex_swap_file) != b.vertex_lines.size() ||
+                        fwrite(b.face_lines.data(), 1, b.face_lines.size(), this->face_swap_file) != b.face_lines.size())
+                    {
+                        write_error = "MeshAlg::MeshObjFlushWriter::run(): failed to write flushed block to swap file.";
+                    }
+                }
+                lock.lock();
+                if (write_error) {
+                    this->error = write_error;
+                }
+            }
+
+            this->writing = 0;
+            this->block_written.notify_all();
+        }
+    }
+
+    void
+    MeshObjFlushWriter::push(
+        std::string    &&vertex_lines,
+        std::string    &&face_lines)
+    {
+        std::unique_lock<std::mutex> lock(this->mtx);
+        if (!this->io_thread.joinable()) {
+            throw("MeshAlg::MeshObjFlushWriter::push(): writer has already been finished.");
+        }
+
+        if (this->blocks.size() + this->writing >= this->max_pending) {
+            Profiling::addCounter("meshing/flush_writer_stalls");
+            this->block_written.wait(lock, [this] () -> bool { return (this->error || this->blocks.size() + this->writing < this->max_pending); });
+        }
+        if (this->error) {
+            throw(this->error);
+        }
+
+        this->blocks.push_back({ std::move(vertex_lines), std::move(face_lines) });
+        this->nblocks++;
+        this->block_pushed.notify_one();
+    }
+
+    void
+    MeshObjFlushWriter::finish()
+    {
+        if (!this->io_thread.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            this->stop = true;
+            this->block_pushed.notify_one();
+        }
+        this->io_thread.join();
+
+        if (this->error) {
+            this->closeFiles();
+            throw(this->error);
+        }
+
+        /* assemble obj file: all vertex blocks, the delimiter and all face blocks. if nothing has been flushed, the
+         * obj file stays empty. */
+        if (this->nblocks > 0) {
+            std::vector<char>   buf(1 << 16);
+            bool                ok  = true;
+
+            auto copy =
+                [&] (FILE *src) -> void
+                {
+                    size_t n;
+                    rewind(src);
+                    while ( ok && (n = fread(buf.data(), 1, buf.size(), src)) > 0) {
+                        ok = (fwrite(buf.data(), 1, n, this->obj_file) == n);
+                    }
+                    ok = ok && !ferror(src);
+                };
+
+            fflush(this->vertex_swap_file);
+            fflush(this->face_swap_file);
+            copy(this->vertex_swap_file);
+            ok = ok && fprintf(this->obj_file, "%s\n", vertexDelimiter()) > 0;
+            copy(this->face_swap_file);
+
+            if (!ok || fflush(this->obj_file) != 0) {
+                this->closeFiles();
+                throw("MeshAlg::MeshObjFlushWriter::finish(): failed to assemble obj file from swap files.");
+            }
+            fsync(fileno(this->obj_file));
+        }
+
+        this->closeFiles();
+        remove( (this->filename + "_swap_v.obj").c_str() );
+        remove( (this->filename + "_swap_f.obj").c_str() );
+    }
+}
@@ -0,0 +1,322 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common.hh"
+
+#include <atomic>
+
+#include "aux.hh"
+#include "Profiling.hh"
+
+#ifndef __WIN32__
+    #include <sys/resource.h>
+#endif
+
+namespace Profiling {
+    namespace {
+        std::atomic<bool>                   profiling_enabled(false);
+        std::mutex                          profiling_mutex;
+        double                              profiling_start_time = Aux::Timing::doubletime();
+
+        /* stages and counters are stored in order of their first occurrence, which is the natural order of the
+         * pipeline. */
+        std::vector<StageRecord>            stages;
+        std::map<std::string, size_t>       stage_index;
+        std::vector<
+                std::pair<std::string, int64_t>
+            >                               counters;
+        std::map<std::string, size_t>       counter_index;
+
+        /* registered rates (name, counter, stage) */
+        std::vector<
+                std::array<std::string, 3>
+            >                               rates;
+
+        std::string
+        jsonEscape(std::string const &s)
+        {
+            std::string r;
+            for (char c : s) {
+                switch (c) {
+                    case '"':   r += "\\\""; break;
+                    case '\\':  r += "\\\\"; break;
+                    case '\n':  r += "\\n"; break;
+                    case '\t':  r += "\\t"; break;
+                    default:
+                        if ((unsigned char)c < 0x20) {
+                            char buf[8];
+                            snprintf(buf, sizeof(buf), "\\u%04x", (unsigned char)c);
+                            r += buf;
+                        }
+                        else {
+                            r += c;
+                        }
+                }
+            }
+            return r;
+        }
+    }
+
+    void
+    enable(bool on)
+    {
+        profiling_enabled.store(on);
+    }
+
+    bool
+    enabled()
+    {
+        return profiling_enabled.load(std::memory_order_relaxed);
+    }
+
+    void
+    reset()
+    {
+        std::lock_guard<std::mutex> lock(profiling_mutex);
+
+        stages.clear();
+        stage_index.clear();
+        counters.clear();
+        counter_index.clear();
+        rates.clear();
+        profiling_start_time = Aux::Timing::doubletime();
+    }
+
+    double
+    threadCpuTime()
+    {
+#ifndef __WIN32__
+        struct timespec ts;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+            return ( (double)ts.tv_sec + (double)ts.tv_nsec / 1.0E9 );
+        }
+#endif
+        return ( (double)std::clock() / CLOCKS_PER_SEC );
+    }
+
+    uint64_t
+    peakRSS()
+    {
+#ifndef __WIN32__
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            /* ru_maxrss is given in kB on linux, in bytes on mac os */
+    #ifdef __APPLE__
+            return (uint64_t)usage.ru_maxrss / 1024;
+    #else
+            return (uint64_t)usage.ru_maxrss;
+    #endif
+        }
+#endif
+        return 0;
+    }
+
+    void
+    addStageTime(
+        char const *stage,
+        double      wall,
+        double      cpu,
+        uint64_t    calls)
+    {
+        if (!enabled()) {
+            return;
+        }
+
+        uint64_t rss = peakRSS();
+
+        std::lock_guard<std::mutex> lock(profiling_mutex);
+
+        auto it = stage_index.find(stage);
+        if (it == stage_index.end()) {
+            it = stage_index.insert( { std::string(stage), stages.size() } ).first;
+            stages.push_back( { std::string(stage), 0, 0.0, 0.0, 0.0, 0 } );
+        }
+
+        StageRecord &s  = stages[it->second];
+        s.calls        += calls;
+        s.wall         += wall;
+        s.cpu          += cpu;
+        /* for aggregated calls > 1, the maximum of a single call is unknown. use the average as lower bound. */
+        s.wall_max      = std::max(s.wall_max, wall / (double)std::max(calls, (uint64_t)1));
+        s.peak_rss_kb   = std::max(s.peak_rss_kb, rss);
+    }
+
+    void
+    addCounter(
+        char const *counter,
+        int64_t     delta)
+    {
+        if (!enabled()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(profiling_mutex);
+
+        auto it = counter_index.find(counter);
+        if (it == counter_index.end()) {
+            it = counter_index.insert( { std::string(counter), counters.size() } ).first;
+            counters.push_back( { std::string(counter), 0 } );
+        }
+        counters[it->second].second += delta;
+    }
+
+    void
+    addRate(
+        char const *name,
+        char const *counter,
+        char const *stage)
+    {
+        std::lock_guard<std::mutex> lock(profiling_mutex);
+        rates.push_back( { std::string(name), std::string(counter), std::string(stage) } );
+    }
+
+    void
+    snapshot(
+        std::vector<StageRecord>                       &stages_out,
+        std::vector<std::pair<std::string, int64_t>>   &counters_out)
+    {
+        std::lock_guard<std::mutex> lock(profiling_mutex);
+
+        stages_out      = stages;
+        counters_out    = counters;
+    }
+
+    bool
+    writeJsonReport(
+        std::string const                          &filename,
+        std::map<std::string, std::string> const   &info)
+    {
+        FILE *f = fopen(filename.c_str(), "w");
+        if (!f) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(profiling_mutex);
+
+        double user_time = 0.0, system_time = 0.0;
+#ifndef __WIN32__
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            user_time   = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1.0E6;
+            system_time = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1.0E6;
+        }
+#endif
+
+        fprintf(f, "{\n");
+        fprintf(f, "  \"info\": {");
+        size_t i = 0;
+        for (auto &kv : info) {
+            fprintf(f, "%s\n    \"%s\": \"%s\"", (i++ ? "," : ""), jsonEscape(kv.first).c_str(), jsonEscape(kv.second).c_str());
+        }
+        fprintf(f, "%s},\n", (info.empty() ? "" : "\n  "));
+
+        fprintf(f, "  \"wall_time\": %.6f,\n", Aux::Timing::doubletime() - profiling_start_time);
+        fprintf(f, "  \"cpu_time_user\": %.6f,\n", user_time);
+        fprintf(f, "  \"cpu_time_system\": %.6f,\n", system_time);
+        fprintf(f, "  \"peak_rss_kb\": %llu,\n", (unsigned long long)peakRSS());
+
+        fprintf(f, "  \"stages\": [");
+        for (i = 0; i < stages.size(); i++) {
+            StageRecord const &s = stages[i];
+            fprintf(f, "%s\n    { \"name\": \"%s\", \"calls\": %llu, \"wall\": %.6f, \"wall_max\": %.6f, \"cpu\": %.6f, \"peak_rss_kb\": %llu }",
+                (i ? "," : ""), jsonEscape(s.name).c_str(), (unsigned long long)s.calls, s.wall, s.wall_max, s.cpu,
+                (unsigned long long)s.peak_rss_kb);
+        }
+        fprintf(f, "%s],\n", (stages.empty() ? "" : "\n  "));
+
+        fprintf(f, "  \"counters\": {");
+        for (i = 0; i < counters.size(); i++) {
+            fprintf(f, "%s\n    \"%s\": %lld", (i ? "," : ""), jsonEscape(counters[i].first).c_str(), (long long)counters[i].second);
+        }
+        fprintf(f, "%s},\n", (counters.empty() ? "" : "\n  "));
+
+        /* rates whose counter and stage have both been recorded with non-zero wall time */
+        fprintf(f, "  \"rates\": {");
+        size_t nrates = 0;
+        for (auto &rate : rates) {
+            auto c_it = counter_index.find(rate[1]);
+            auto s_it = stage_index.find(rate[2]);
+            if (c_it == counter_index.end() || s_it == stage_index.end() || stages[s_it->second].wall <= 0.0) {
+                continue;
+            }
+            fprintf(f, "%s\n    \"%s\": %.3f", (nrates++ ? "," : ""), jsonEscape(rate[0]).c_str(),
+                (double)counters[c_it->second].second / stages[s_it->second].wall);
+        }
+        fprintf(f, "%s}\n", (nrates ? "\n  " : ""));
+        fprintf(f, "}\n");
+
+        bool ok = !ferror(f);
+        fclose(f);
+        return ok;
+    }
+
+    ScopedStage::ScopedStage(char const *stage)
+        : stage(stage), active(enabled()), wall_start(0.0), cpu_start(0.0)
+    {
+        if (this->active) {
+            this->wall_start    = Aux::Timing::doubletime();
+            this->cpu_start     = threadCpuTime();
+        }
+#ifdef __TRACING__
+        this->trace_start = (Tracing::enabled() ? Tracing::now() : -1.0);
+#endif
+    }
+
+    ScopedStage::~ScopedStage()
+    {
+        if (this->active) {
+            addStageTime(
+                this->stage,
+                Aux::Timing::doubletime() - this->wall_start,
+                threadCpuTime() - this->cpu_start);
+        }
+#ifdef __TRACING__
+        if (this->trace_start >= 0.0) {
+            Tracing::recordEvent(this->stage, this->trace_start, Tracing::now() - this->trace_start, NULL, 0);
+        }
+#endif
+    }
+}
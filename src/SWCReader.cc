@@ -0,0 +1,179 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "common.hh"
+
+#include "SWCReader.hh"
+
+namespace SWCReader {
+    MappedFile::MappedFile()
+    :
+        ptr(NULL),
+        len(0),
+        mapped(false)
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        this->close();
+    }
+
+    bool
+    MappedFile::open(std::string const &filename)
+    {
+        this->close();
+
+#ifndef __WIN32__
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        /* empty files can't be mapped, an empty view is returned instead */
+        if (st.st_size > 0) {
+            void *m = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                madvise(m, st.st_size, MADV_SEQUENTIAL);
+                ::close(fd);
+
+                this->ptr       = (char const *)m;
+                this->len       = st.st_size;
+                this->mapped    = true;
+                return true;
+            }
+        }
+        ::close(fd);
+#endif
+
+        /* fallback: read entire file into buffer */
+        std::ifstream in(filename, std::ios::in | std::ios::binary);
+        if (!in.is_open()) {
+            return false;
+        }
+        in.seekg(0, std::ios::end);
+        std::streamoff n = in.tellg();
+        if (n < 0) {
+            return false;
+        }
+        in.seekg(0, std::ios::beg);
+
+        this->buffer.resize(n);
+        if (n > 0 && !in.read(this->buffer.data(), n)) {
+            this->buffer.clear();
+            return false;
+        }
+        this->ptr       = this->buffer.data();
+        this->len       = this->buffer.size();
+        this->mapped    = false;
+        return true;
+    }
+
+    void
+    MappedFile::close()
+    {
+#ifndef __WIN32__
+        if (this->mapped) {
+            munmap((void *)this->ptr, this->len);
+        }
+#endif
+        this->buffer.clear();
+        this->buffer.shrink_to_fit();
+        this->ptr       = NULL;
+        this->len       = 0;
+        this->mapped    = false;
+    }
+
+    char const *
+    MappedFile::data() const
+    {
+        return (this->ptr);
+    }
+
+    size_t
+    MappedFile::size() const
+    {
+        return (this->len);
+    }
+
+    std::vector<
+            std::pair<size_t, size_t>
+        >
+    splitIntoLineChunks(
+        char const *data,
+        size_t      size,
+        uint32_t    nchunks)
+    {
+        std::vector<std::pair<size_t, size_t>> chunks;
+        if (nchunks == 0) {
+            nchunks = 1;
+        }
+
+        size_t const target = size / nchunks + 1;
+        size_t       begin  = 0;
+        while (begin < size) {
+            size_t end = begin + target;
+            if (end >= size) {
+                end = size;
+            }
+            else {
+                /* advance end to the first byte after the next newline */
+                char const *nl = (char const *)memchr(data + end, '\n', size - end);
+                end = nl ? (size_t)(nl - data) + 1 : size;
+            }
+            chunks.push_back({begin, end});
+            begin = end;
+        }
+        return chunks;
+    }
+}
@@ -0,0 +1,684 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "common.hh"
+
+#include "SWCSynth.hh"
+
+namespace SWCSynth {
+    Parameters::Parameters()
+    :
+        seed                    (0),
+        n_cells                 (1),
+        density                 (1000.0),
+        soma_radius_mean        (8.0),
+        soma_radius_sigma       (1.0),
+        n_neurites              (5),
+        branch_probability      (0.05),
+        termination_probability (0.08),
+        min_segments            (5),
+        max_order               (6),
+        max_cell_vertices       (5000),
+        segment_length_mean     (5.0),
+        segment_length_sigma    (2.0),
+        tortuosity              (0.15),
+        branch_angle            (M_PI / 3.0),
+        radius_mean             (1.5),
+        radius_sigma            (0.3),
+        radius_min              (0.25),
+        radius_taper            (0.99),
+        branch_radius_ratio     (0.63),
+        intersection_rate       (0.0)
+    {
+    }
+
+    Statistics::Statistics()
+    :
+        n_vertices              (0),
+        n_branch_points         (0),
+        n_terminals             (0),
+        n_forced_intersections  (0),
+        total_length            (0.0),
+        cube_side               (0.0)
+    {
+    }
+
+    namespace {
+        /* random variates computed from the raw output of std::mt19937, which is fully specified by the standard.
+         * the distributions of the standard library are implementation-defined, using them would make the output
+         * depend on the standard library. */
+        class Sampler {
+            private:
+                std::mt19937            rng;
+
+            public:
+                Sampler(uint32_t seed)
+                :
+                    rng(seed)
+                {
+                }
+
+                /* uniform in ]0, 1[ */
+                double
+                uniform()
+                {
+                    return ((double)this->rng() + 0.5) / 4294967296.0;
+                }
+
+                /* standard normal, Box-Muller */
+                double
+                normal()
+                {
+                    double u = this->uniform();
+                    double v = this->uniform();
+                    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+                }
+
+                /* lognormal with given mean and standard deviation */
+                double
+                lognormal(
+                    double mean,
+                    double sigma)
+                {
+                    double s2 = log(1.0 + (sigma * sigma) / (mean * mean));
+                    return exp(log(mean) - s2 / 2.0 + sqrt(s2) * this->normal());
+                }
+
+                Vec3<double>
+                normalVec3()
+                {
+                    double x = this->normal();
+                    double y = this->normal();
+                    double z = this->normal();
+                    return Vec3<double>(x, y, z);
+                }
+
+                Vec3<double>
+                unitVec3()
+                {
+                    Vec3<double> d;
+                    do {
+                        d = this->normalVec3();
+                    } while (d.len2squared() < 1E-12);
+                    return d.normalize();
+                }
+        };
+
+        /* growth steps keep a distance of clearance times the sum of both radii to all somas and segments that are
+         * not adjacent on the same path. a tip terminates after max_step_attempts rejected steps in a row. */
+        double const    clearance           = 1.5;
+        uint32_t const  max_step_attempts   = 8;
+
+        /* segments are at least this many times as long as their radius. shorter ones would be collapsed by the
+         * preconditioning of am_cellgen (see -cellnet-pc, default alpha), which moves their vertices. */
+        double const    min_length_radius_ratio = 3.0;
+
+        /* a growing neurite tip */
+        struct Tip {
+            uint32_t                    vertex;
+            Vec3<double>                pos;
+            Vec3<double>                dir;
+            double                      r;
+            uint32_t                    order;
+            uint32_t                    nsegments;
+        };
+
+        /* rotate v around the unit axis a by angle phi (Rodrigues) */
+        Vec3<double>
+        rotate(
+            Vec3<double> const &v,
+            Vec3<double> const &a,
+            double              phi)
+        {
+            return (v * cos(phi) + a.cross(v) * sin(phi) + a * ((a * v) * (1.0 - cos(phi))));
+        }
+
+        /* any unit vector perpendicular to the unit vector d */
+        Vec3<double>
+        perpendicular(Vec3<double> const &d)
+        {
+            Vec3<double> e = (std::abs(d[0]) < 0.9) ? Vec3<double>(1, 0, 0) : Vec3<double>(0, 1, 0);
+            return (d.cross(e)).normalize();
+        }
+
+        /* key of the cube of side length h containing x in a uniform grid */
+        uint64_t
+        gridKey(
+            Vec3<double> const &x,
+            double              h,
+            int64_t             dx = 0,
+            int64_t             dy = 0,
+            int64_t             dz = 0)
+        {
+            uint64_t const mask = ((uint64_t)1 << 21) - 1;
+            uint64_t ix = (uint64_t)((int64_t)floor(x[0] / h) + dx) & mask;
+            uint64_t iy = (uint64_t)((int64_t)floor(x[1] / h) + dy) & mask;
+            uint64_t iz = (uint64_t)((int64_t)floor(x[2] / h) + dz) & mask;
+            return ((ix << 42) | (iy << 21) | iz);
+        }
+
+        /* squared distance between the segments [a0, a1] and [b0, b1] (closest points of two segments, see Ericson,
+         * "Real-Time Collision Detection", 5.1.9) */
+        double
+        segmentDistance2(
+            Vec3<double> const &a0,
+            Vec3<double> const &a1,
+            Vec3<double> const &b0,
+            Vec3<double> const &b1)
+        {
+            Vec3<double> const  d1  = a1 - a0;
+            Vec3<double> const  d2  = b1 - b0;
+            Vec3<double> const  r   = a0 - b0;
+            double const        a   = d1 * d1;
+            double const        e   = d2 * d2;
+            double const        f   = d2 * r;
+            double              s, t;
+
+            if (a < 1E-18 && e < 1E-18) {
+                return r.len2squared();
+            }
+            if (a < 1E-18) {
+                s = 0.0;
+                t = std::min(1.0, std::max(0.0, f / e));
+            }
+            else {
+                double const c = d1 * r;
+                if (e < 1E-18) {
+                    t = 0.0;
+                    s = std::min(1.0, std::max(0.0, -c / a));
+                }
+                else {
+                    double const b      = d1 * d2;
+                    double const denom  = a * e - b * b;
+
+                    s = (denom > 1E-18) ? std::min(1.0, std::max(0.0, (b * f - c * e) / denom)) : 0.0;
+                    t = (b * s + f) / e;
+                    if (t < 0.0) {
+                        t = 0.0;
+                        s = std::min(1.0, std::max(0.0, -c / a));
+                    }
+                    else if (t > 1.0) {
+                        t = 1.0;
+                        s = std::min(1.0, std::max(0.0, (b - c) / a));
+                    }
+                }
+            }
+            return ((a0 + d1 * s) - (b0 + d2 * t)).len2squared();
+        }
+
+        /* all somas and neurite segments grown so far, as capsules (a segment with a radius, somas are degenerate
+         * segments) indexed in a uniform grid. every capsule is entered into all grid cells overlapped by its bounding
+         * box. */
+        class ObstacleGrid {
+            private:
+                struct Capsule {
+                    Vec3<double>        a;
+                    Vec3<double>        b;
+                    double              r;
+                    uint32_t            va;
+                    uint32_t            vb;
+                };
+
+                double                                              h;
+                double                                              r_max;
+                std::vector<Capsule>                                capsules;
+                std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+
+                template <typename F>
+                void
+                forEachCell(
+                    Vec3<double> const &a,
+                    Vec3<double> const &b,
+                    double              margin,
+                    F const            &f) const
+                {
+                    int64_t lo[3], hi[3];
+                    for (uint32_t j = 0; j < 3; j++) {
+                        lo[j] = (int64_t)floor((std::min(a[j], b[j]) - margin) / this->h);
+                        hi[j] = (int64_t)floor((std::max(a[j], b[j]) + margin) / this->h);
+                    }
+                    for (int64_t x = lo[0]; x <= hi[0]; x++) {
+                        for (int64_t y = lo[1]; y <= hi[1]; y++) {
+                            for (int64_t z = lo[2]; z <= hi[2]; z++) {
+                                f(gridKey(Vec3<double>(0, 0, 0), this->h, x, y, z));
+                            }
+                        }
+                    }
+                }
+
+            public:
+                ObstacleGrid(double h)
+                :
+                    h(h),
+                    r_max(0.0)
+                {
+                }
+
+                /* va and vb are the record ids of the end points */
+                void
+                insert(
+                    Vec3<double> const &a,
+                    Vec3<double> const &b,
+                    double              r,
+                    uint32_t            va,
+                    uint32_t            vb)
+                {
+                    uint32_t const i = this->capsules.size();
+                    this->capsules.push_back({ a, b, r, va, vb });
+                    this->r_max = std::max(this->r_max, r);
+                    this->forEachCell(a, b, r, [&] (uint64_t key) { this->cells[key].push_back(i); });
+                }
+
+                /* remove the capsule inserted last */
+                void
+                removeLast()
+                {
+                    Capsule const &c = this->capsules.back();
+                    this->forEachCell(c.a, c.b, c.r, [&] (uint64_t key) { this->cells[key].pop_back(); });
+                    this->capsules.pop_back();
+                }
+
+                /* true if the capsule (a, b, r) keeps a distance of clearance times the sum of both radii to all
+                 * capsules that don't have an end point in excluded. the own soma only has to be cleared by the sum
+                 * of the radii, since neurite roots lie at 1.5 times the soma radius. */
+                bool
+                isFree(
+                    Vec3<double> const             &a,
+                    Vec3<double> const             &b,
+                    double                          r,
+                    std::vector<uint32_t> const    &excluded,
+                    uint32_t                        soma,
+                    double                          clearance) const
+                {
+                    auto is_excluded = [&] (uint32_t v) -> bool {
+                        return (std::find(excluded.begin(), excluded.end(), v) != excluded.end());
+                    };
+
+                    bool free = true;
+                    this->forEachCell(a, b, clearance * (r + this->r_max), [&] (uint64_t key) {
+                        auto cell = this->cells.find(key);
+                        if (!free || cell == this->cells.end()) {
+                            return;
+                        }
+                        for (uint32_t i : cell->second) {
+                            Capsule const  &c   = this->capsules[i];
+                            double const    d   = (c.va == soma && c.vb == soma) ? r + c.r : clearance * (r + c.r);
+                            if (!is_excluded(c.va) && !is_excluded(c.vb) && segmentDistance2(a, b, c.a, c.b) < d * d) {
+                                free = false;
+                                return;
+                            }
+                        }
+                    });
+                    return free;
+                }
+        };
+    }
+
+    void
+    generate(
+        Parameters const                           &p,
+        std::vector<SWCReader::Record<double>>     &records,
+        Statistics                                 *stats)
+    {
+        if (p.n_cells == 0 || p.n_neurites == 0 || p.density <= 0) {
+            throw("SWCSynth::generate(): number of cells, number of neurites and density must be positive.");
+        }
+        if (p.segment_length_mean <= 0 || p.segment_length_sigma < 0 || p.soma_radius_mean <= 0 ||
+            p.radius_mean <= 0 || p.radius_min <= 0)
+        {
+            throw("SWCSynth::generate(): lengths and radii must be positive.");
+        }
+        if (p.branch_probability < 0 || p.branch_probability > 1 || p.termination_probability < 0 ||
+            p.termination_probability > 1 || p.intersection_rate < 0 || p.intersection_rate > 1)
+        {
+            throw("SWCSynth::generate(): probabilities and rates must lie in [0, 1].");
+        }
+
+        Sampler     S(p.seed);
+        Statistics  st;
+
+        records.clear();
+
+        /* neurite index of every record, -1 for somas, and whether a record is a terminal neurite vertex */
+        std::vector<int64_t>    neurite_of;
+        std::vector<bool>       terminal;
+
+        auto addRecord = [&] (uint32_t type, int32_t parent, Vec3<double> const &x, double r, int64_t neurite) -> uint32_t
+            {
+                SWCReader::Record<double> rec;
+                rec.compartment_id      = records.size() + 1;
+                rec.compartment_type    = type;
+                rec.parent_id           = parent;
+                rec.p                   = x;
+                rec.r                   = r;
+                records.push_back(rec);
+                neurite_of.push_back(neurite);
+                terminal.push_back(false);
+
+                if (parent > 0 && neurite_of[parent - 1] >= 0) {
+                    st.total_length += (x - records[parent - 1].p).len2();
+                }
+                return rec.compartment_id;
+            };
+
+        /* somas on a jittered cubic grid, density is given per cubic millimetre. all somas are placed before any
+         * neurite grows, so that neurites can avoid the somas of all other cells. */
+        uint32_t const  g       = (uint32_t)ceil(cbrt((double)p.n_cells) - 1E-9);
+        st.cube_side            = cbrt((double)p.n_cells / p.density) * 1000.0;
+        double const    spacing = st.cube_side / g;
+
+        ObstacleGrid    obstacles(2.0 * p.segment_length_mean);
+        for (uint32_t c = 0; c < p.n_cells; c++) {
+            Vec3<double> s_pos(
+                ((c % g) + 0.5) * spacing - st.cube_side / 2.0,
+                (((c / g) % g) + 0.5) * spacing - st.cube_side / 2.0,
+                ((c / (g * g)) + 0.5) * spacing - st.cube_side / 2.0);
+            for (uint32_t j = 0; j < 3; j++) {
+                s_pos[j] += (S.uniform() - 0.5) * 0.5 * spacing;
+            }
+
+            double const    s_r     = std::max(0.5 * p.soma_radius_mean, p.soma_radius_mean + p.soma_radius_sigma * S.normal());
+            uint32_t const  s_id    = addRecord(1, -1, s_pos, s_r, -1);
+            obstacles.insert(s_pos, s_pos, s_r, s_id, s_id);
+        }
+
+        /* record ids of the vertices preceding v on its neurite, up to the arc length within which neighbouring
+         * segments of the same path necessarily come closer than the clearance. the soma is never included. */
+        std::vector<uint32_t> excluded;
+        auto collectPathNeighbours = [&] (uint32_t v, double arc_length) -> void
+            {
+                excluded.clear();
+                double len = 0.0;
+                while (true) {
+                    excluded.push_back(v);
+                    int32_t const parent = records[v - 1].parent_id;
+                    if (parent <= 0 || neurite_of[parent - 1] < 0 || len >= arc_length) {
+                        break;
+                    }
+                    len    += (records[v - 1].p - records[parent - 1].p).len2();
+                    v       = parent;
+                }
+            };
+
+        for (uint32_t c = 0; c < p.n_cells; c++) {
+            uint32_t const      s_id            = c + 1;
+            Vec3<double> const  s_pos           = records[s_id - 1].p;
+            double const        s_r             = records[s_id - 1].r;
+            uint32_t            nvertices_cell  = 1;
+
+            /* spread the neurite roots evenly over the soma on a golden angle spiral in random orientation */
+            Vec3<double> const  axis    = S.unitVec3();
+            double const        alpha   = 2.0 * M_PI * S.uniform();
+
+            std::vector<Tip> tips;
+            for (uint32_t k = 0; k < p.n_neurites; k++) {
+                double const z      = 1.0 - (2.0 * k + 1.0) / p.n_neurites;
+                double const rho    = sqrt(std::max(0.0, 1.0 - z * z));
+                double const theta  = k * M_PI * (3.0 - sqrt(5.0));
+
+                Tip root;
+                root.dir        = rotate(Vec3<double>(rho * cos(theta), rho * sin(theta), z), axis, alpha);
+                root.pos        = s_pos + root.dir * (1.5 * s_r);
+                root.r          = std::min(0.5 * s_r, std::max(p.radius_min, p.radius_mean + p.radius_sigma * S.normal()));
+                root.order      = 0;
+                root.nsegments  = 0;
+
+                /* neurites whose root is already occupied by a neurite of another cell are left out */
+                excluded.assign(1, s_id);
+                if (!obstacles.isFree(s_pos, root.pos, root.r, excluded, s_id, clearance)) {
+                    continue;
+                }
+                root.vertex     = addRecord(3, s_id, root.pos, root.r, (int64_t)c * p.n_neurites + k);
+                obstacles.insert(s_pos, root.pos, root.r, s_id, root.vertex);
+                nvertices_cell++;
+
+                /* grow one neurite after the other, depth first */
+                tips.push_back(root);
+                while (!tips.empty()) {
+                    Tip t = tips.back();
+                    tips.pop_back();
+
+                    while (true) {
+                        if (nvertices_cell >= p.max_cell_vertices ||
+                            (t.nsegments > 0 && t.nsegments >= p.min_segments && S.uniform() < p.termination_probability))
+                        {
+                            break;
+                        }
+
+                        if (t.nsegments > 0 && t.order < p.max_order && S.uniform() < p.branch_probability) {
+                            /* bifurcate: both children continue from this vertex, rotated apart in a random plane */
+                            Vec3<double> const  a   = rotate(perpendicular(t.dir), t.dir, 2.0 * M_PI * S.uniform());
+                            Tip                 t1  = t;
+                            Tip                 t2  = t;
+
+                            t1.dir      = rotate(t.dir, a,  p.branch_angle / 2.0);
+                            t2.dir      = rotate(t.dir, a, -p.branch_angle / 2.0);
+                            t1.r        = t2.r          = std::max(p.radius_min, t.r * p.branch_radius_ratio);
+                            t1.order    = t2.order      = t.order + 1;
+                            t1.nsegments= t2.nsegments  = 0;
+
+                            tips.push_back(t2);
+                            t = t1;
+                        }
+
+                        /* extend by one segment, turning away from the own soma. steps that would come closer to
+                         * any other soma or segment than the clearance are drawn again, the tip terminates if no
+                         * free step is found. the tube of a segment is as thick as its source vertex, which for the
+                         * children of a bifurcation is the parent radius. */
+                        double const        r_max       = records[t.vertex - 1].r;
+                        collectPathNeighbours(t.vertex, 2.0 * clearance * r_max);
+
+                        Vec3<double> const  prev        = t.pos - records[records[t.vertex - 1].parent_id - 1].p;
+                        double const        prev_len    = prev.len2();
+
+                        /* the first segments of both children of a bifurcation must be long enough for their tubes to
+                         * separate. the spline of am_cellgen continues one child through the branch point, which
+                         * halves the angle between the tangents of both children at their start. */
+                        double const        min_len     = (t.nsegments == 0 && t.order > 0) ?
+                            clearance * r_max / std::max(0.1, sin(p.branch_angle / 4.0)) : 0.0;
+
+                        bool extended = false;
+                        for (uint32_t attempt = 0; attempt < max_step_attempts && !extended; attempt++) {
+                            Vec3<double>    d = (t.dir + S.normalVec3() * p.tortuosity).normalize();
+                            double          l = std::max(0.1 * p.segment_length_mean, S.lognormal(p.segment_length_mean, p.segment_length_sigma));
+                            l                   = std::max(l, std::max(min_len, min_length_radius_ratio * t.r));
+                            if ((t.pos + d * l - s_pos).len2() < 1.5 * s_r) {
+                                d = (t.pos - s_pos).normalize();
+                            }
+
+                            /* the tube around the path must not fold at the vertex: the turn has to be gentle
+                             * compared to the radius and the lengths of both segments. */
+                            double const        turn    = acos(std::min(1.0, std::max(-1.0, (prev * d) / prev_len)));
+                            Vec3<double> const  x       = t.pos + d * l;
+                            if (2.0 * clearance * r_max * tan(turn / 2.0) <= std::min(l, prev_len) &&
+                                obstacles.isFree(t.pos, x, r_max, excluded, s_id, clearance))
+                            {
+                                uint32_t const v = addRecord(3, t.vertex, x, std::max(p.radius_min, t.r * p.radius_taper),
+                                    (int64_t)c * p.n_neurites + k);
+                                obstacles.insert(t.pos, x, r_max, t.vertex, v);
+
+                                t.dir       = d;
+                                t.pos       = x;
+                                t.r         = records[v - 1].r;
+                                t.vertex    = v;
+                                t.nsegments++;
+                                nvertices_cell++;
+                                extended    = true;
+                            }
+                        }
+                        if (!extended) {
+                            break;
+                        }
+                    }
+                }
+
+                /* a root without any segment would be a neurite of zero length: remove it again. it is still the last
+                 * record, since nothing has been grown from it. */
+                if (records.back().compartment_id == root.vertex) {
+                    records.pop_back();
+                    neurite_of.pop_back();
+                    terminal.pop_back();
+                    obstacles.removeLast();
+                    nvertices_cell--;
+                }
+            }
+        }
+
+        /* branch points and terminals of the grown neurites */
+        std::vector<uint32_t> nchildren(records.size(), 0);
+        for (auto &rec : records) {
+            if (rec.parent_id > 0) {
+                nchildren[rec.parent_id - 1]++;
+            }
+        }
+        for (uint32_t i = 0; i < records.size(); i++) {
+            if (neurite_of[i] >= 0) {
+                terminal[i] = (nchildren[i] == 0);
+                st.n_terminals      += (nchildren[i] == 0);
+                st.n_branch_points  += (nchildren[i] >= 2);
+            }
+        }
+
+        /* forced intersections: index midpoints of all neurite segments in a uniform grid whose cell size is the
+         * reach of a bridge, then extend selected terminal tips through the nearest segment of another neurite. */
+        if (p.intersection_rate > 0) {
+            double const                                        reach = 10.0 * p.segment_length_mean;
+            std::unordered_map<uint64_t, std::vector<uint32_t>> grid;
+            size_t const                                        n_grown = records.size();
+
+            for (uint32_t i = 0; i < n_grown; i++) {
+                int32_t const parent = records[i].parent_id;
+                if (parent > 0 && neurite_of[parent - 1] >= 0) {
+                    grid[gridKey((records[i].p + records[parent - 1].p) * 0.5, reach)].push_back(i);
+                }
+            }
+
+            for (uint32_t i = 0; i < n_grown; i++) {
+                if (!terminal[i] || S.uniform() >= p.intersection_rate) {
+                    continue;
+                }
+
+                Vec3<double> const  tip     = records[i].p;
+                double              best    = reach * reach;
+                int64_t             target  = -1;
+                Vec3<double>        target_pos;
+
+                for (int64_t dx = -1; dx <= 1; dx++) {
+                    for (int64_t dy = -1; dy <= 1; dy++) {
+                        for (int64_t dz = -1; dz <= 1; dz++) {
+                            auto cell = grid.find(gridKey(tip, reach, dx, dy, dz));
+                            if (cell == grid.end()) {
+                                continue;
+                            }
+                            for (uint32_t j : cell->second) {
+                                if (neurite_of[j] == neurite_of[i]) {
+                                    continue;
+                                }
+                                Vec3<double> const  m   = (records[j].p + records[records[j].parent_id - 1].p) * 0.5;
+                                double const        d2  = (m - tip).len2squared();
+                                if (d2 < best && d2 > 0) {
+                                    best        = d2;
+                                    target      = j;
+                                    target_pos  = m;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                if (target < 0) {
+                    continue;
+                }
+
+                /* straight bridge from the tip through the target segment, leaving it on the other side */
+                Vec3<double>    d           = (target_pos - tip).normalize();
+                double const    overshoot   = 2.0 * std::max(records[i].r, records[target].r) + 0.5 * p.segment_length_mean;
+                Vec3<double>    end         = target_pos + d * overshoot;
+                double const    len         = (end - tip).len2();
+                uint32_t const  nsegments   = std::max(2u, (uint32_t)ceil(len / p.segment_length_mean));
+
+                uint32_t parent = i + 1;
+                for (uint32_t k = 1; k <= nsegments; k++) {
+                    parent = addRecord(3, parent, tip + (end - tip) * ((double)k / nsegments), records[i].r, neurite_of[i]);
+                }
+                terminal[i]         = false;
+                terminal[parent - 1]= true;
+                st.n_forced_intersections++;
+            }
+        }
+
+        st.n_vertices = records.size();
+        if (stats) {
+            *stats = st;
+        }
+    }
+
+    void
+    write(
+        std::string const                              &filename,
+        std::vector<SWCReader::Record<double>> const   &records,
+        std::vector<std::string> const                 &comments)
+    {
+        FILE *f = fopen(filename.c_str(), "w");
+        if (!f) {
+            throw("SWCSynth::write(): can't open output file.");
+        }
+
+        for (auto &c : comments) {
+            fprintf(f, "# %s\n", c.c_str());
+        }
+        for (auto &rec : records) {
+            fprintf(f, "%u %u %.6f %.6f %.6f %.6f %d\n", rec.compartment_id, rec.compartment_type, rec.p[0], rec.p[1],
+                rec.p[2], rec.r, rec.parent_id);
+        }
+
+        bool failed = ferror(f);
+        if (fclose(f) != 0 || failed) {
+            throw("SWCSynth::write(): error while writing output file.");
+        }
+    }
+}
@@ -0,0 +1,219 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common.hh"
+#include "Tracing.hh"
+
+#ifdef __TRACING__
+
+#include <atomic>
+#include <chrono>
+
+namespace Tracing {
+    namespace {
+        struct Event {
+            char const     *name;
+            char const     *arg_name;
+            int64_t         arg;
+            double          ts;
+            double          dur;
+        };
+
+        /* ring buffer of one thread. only the owning thread writes to it, the buffer itself is owned by the global
+         * registry and thus outlives the thread, so that events of already joined threads can still be exported. */
+        struct ThreadBuffer {
+            uint32_t            tid;
+            std::string         name;
+            size_t              capacity;
+            std::vector<Event>  events;
+            uint64_t            nrecorded;
+        };
+
+        std::atomic<bool>                           tracing_enabled(false);
+        std::atomic<size_t>                         tracing_buffer_capacity(1 << 16);
+        std::chrono::steady_clock::time_point const tracing_t0 = std::chrono::steady_clock::now();
+
+        std::mutex                                  registry_mutex;
+        std::list<std::unique_ptr<ThreadBuffer>>    registry;
+        uint32_t                                    next_tid = 1;
+
+        thread_local ThreadBuffer                  *thread_buffer = NULL;
+
+        ThreadBuffer &
+        getThreadBuffer()
+        {
+            if (!thread_buffer) {
+                std::lock_guard<std::mutex> lock(registry_mutex);
+
+                registry.emplace_back(new ThreadBuffer());
+                thread_buffer               = registry.back().get();
+                thread_buffer->tid          = next_tid++;
+                thread_buffer->name         = "thread " + std::to_string(thread_buffer->tid);
+                thread_buffer->capacity     = std::max(tracing_buffer_capacity.load(), (size_t)1);
+                thread_buffer->nrecorded    = 0;
+            }
+            return *thread_buffer;
+        }
+
+        std::string
+        jsonEscape(std::string const &s)
+        {
+            std::string r;
+            for (char c : s) {
+                if (c == '"' || c == '\\') {
+                    r += '\\';
+                    r += c;
+                }
+                else if ((unsigned char)c >= 0x20) {
+                    r += c;
+                }
+            }
+            return r;
+        }
+    }
+
+    void
+    enable(bool on)
+    {
+        tracing_enabled.store(on);
+    }
+
+    bool
+    enabled()
+    {
+        return tracing_enabled.load(std::memory_order_relaxed);
+    }
+
+    void
+    setThreadBufferCapacity(size_t capacity)
+    {
+        tracing_buffer_capacity.store(capacity);
+    }
+
+    void
+    setThreadName(std::string const &name)
+    {
+        if (enabled()) {
+            getThreadBuffer().name = name;
+        }
+    }
+
+    double
+    now()
+    {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - tracing_t0).count();
+    }
+
+    void
+    recordEvent(
+        char const *name,
+        double      ts,
+        double      dur,
+        char const *arg_name,
+        int64_t     arg)
+    {
+        ThreadBuffer &b = getThreadBuffer();
+        Event e         = { name, arg_name, arg, ts, dur };
+
+        /* the event vector grows up to capacity, then the oldest event is overwritten. short-lived threads thereby
+         * only allocate what they need. */
+        if (b.events.size() < b.capacity) {
+            b.events.push_back(e);
+        }
+        else {
+            b.events[b.nrecorded % b.capacity] = e;
+        }
+        b.nrecorded++;
+    }
+
+    bool
+    writeTraceFile(std::string const &filename)
+    {
+        FILE *f = fopen(filename.c_str(), "w");
+        if (!f) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+
+        uint64_t    ndropped    = 0;
+        bool        first       = true;
+
+        fprintf(f, "{\"traceEvents\":[\n");
+        fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"am_cellgen\"}}");
+        first = false;
+
+        for (auto &bp : registry) {
+            ThreadBuffer const &b = *bp;
+
+            fprintf(f, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                (first ? "" : ","), b.tid, jsonEscape(b.name).c_str());
+
+            /* oldest event is at nrecorded % capacity once the ring buffer has wrapped around */
+            size_t n        = b.events.size();
+            size_t start    = (b.nrecorded > n ? b.nrecorded % n : 0);
+            ndropped       += b.nrecorded - n;
+
+            for (size_t i = 0; i < n; i++) {
+                Event const &e = b.events[(start + i) % n];
+
+                fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"am\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                    e.name, b.tid, e.ts, e.dur);
+                if (e.arg_name) {
+                    fprintf(f, ",\"args\":{\"%s\":%lld}", e.arg_name, (long long)e.arg);
+                }
+                fprintf(f, "}");
+            }
+        }
+        fprintf(f, "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"dropped_events\":%llu}}\n", (unsigned long long)ndropped);
+
+        bool ok = !ferror(f);
+        fclose(f);
+        return ok;
+    }
+}
+
+#endif
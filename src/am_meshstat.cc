@@ -56,6 +56,7 @@
 
 #include "CellNetwork.hh"
 #include "NLM_CellNetwork.hh"
+#include "SWCReader.hh"
 
 std::string const usage_text = 
 "--------------------------------------------------------------------------------\n"
@@ -104,67 +105,888 @@ std::string const usage_text =
 "\n"\
 "am_meshstat: generate mesh statistics.\n"\
 "\n"\
-"Usage: am_meshstat <OBJ_FILE>\n"\
+"Usage: am_meshstat [OPTIONS] <OBJ_FILE> [<OBJ_FILE> ...]\n"\
+"\n"\
+"all given meshes are processed concurrently. for each mesh, all statistics (area, volume, aspect ratio, obtuse\n"\
+"triangles, edge lengths, boundary and non-manifold edges, self-intersections as well as dihedral angle, edge length\n"\
+"and valence histograms) are computed in one fused parallel sweep over its faces and vertices.\n"\
+"\n"\
+"OPTIONS:\n"\
+"-threads <n>                    total number of threads to use. default: number of hardware threads.\n"\
+"\n"\
+"-json                           print statistics of all meshes as a JSON document instead of plain text.\n"\
+"\n"\
+"-no-isec                        skip counting intersecting pairs of non-adjacent triangles, which is the most\n"\
+"                                expensive statistic on large meshes.\n"\
+"\n"\
+"-stream                         compute statistics in a single pass over the memory-mapped obj file without\n"\
+"                                building the mesh topology. memory usage is proportional to the number of\n"\
+"                                vertices and edges instead of the full mesh data structure, which allows\n"\
+"                                statistics on very large meshes. only triangle meshes are supported and faces\n"\
+"                                must reference vertices that have already been declared. dihedral angles,\n"\
+"                                boundary / non-manifold edges and self-intersections are not available in this\n"\
+"                                mode.\n"\
 "\n";
 
 using namespace std;
 
-int main(int argc, char *argv[])
+/* open addressing hash set of undirected edges {u, v}, stored as 64-bit keys (min(u, v) << 32) | max(u, v). this
+ * needs 8 bytes per slot and no per-element allocation, as opposed to std::unordered_set, which is what makes
+ * counting the edges of meshes with tens of millions of faces feasible on small nodes. */
+static const uint64_t empty_key = std::numeric_limits<uint64_t>::max();
+
+class StreamEdgeSet {
+    private:
+        std::vector<uint64_t>   table;
+        uint64_t                mask;
+        uint64_t                nkeys;
+
+        static uint64_t
+        hash(uint64_t key)
+        {
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdULL;
+            key ^= key >> 33;
+            return key;
+        }
+
+        /* insert key into table, return true if key has been added, false if it was already present */
+        static bool
+        insertKey(
+            std::vector<uint64_t>  &t,
+            uint64_t                m,
+            uint64_t                key)
+        {
+            uint64_t i = hash(key) & m;
+            while (t[i] != empty_key) {
+                if (t[i] == key) {
+                    return false;
+                }
+                i = (i + 1) & m;
+            }
+            t[i] = key;
+            return true;
+        }
+
+        void
+        grow()
+        {
+            std::vector<uint64_t> t(2*this->table.size(), empty_key);
+            uint64_t m = t.size() - 1;
+
+            for (uint64_t key : this->table) {
+                if (key != empty_key) {
+                    insertKey(t, m, key);
+                }
+            }
+            this->table.swap(t);
+            this->mask  = m;
+        }
+
+    public:
+        StreamEdgeSet(uint64_t capacity_hint = 1 << 16)
+        {
+            uint64_t cap = 1 << 4;
+            while (cap < 2*capacity_hint) {
+                cap <<= 1;
+            }
+            this->table.assign(cap, empty_key);
+            this->mask  = cap - 1;
+            this->nkeys = 0;
+        }
+
+        /* insert edge {u, v}, return true if the edge has not been contained before. */
+        bool
+        insert(uint32_t u, uint32_t v)
+        {
+            /* keep load factor below 0.7 */
+            if (10*(this->nkeys + 1) > 7*this->table.size()) {
+                this->grow();
+            }
+
+            uint64_t key = (u < v) ? (((uint64_t)u << 32) | v) : (((uint64_t)v << 32) | u);
+            if (insertKey(this->table, this->mask, key)) {
+                this->nkeys++;
+                return true;
+            }
+            return false;
+        }
+
+        uint64_t
+        size() const
+        {
+            return this->nkeys;
+        }
+};
+
+/* histogram layout. dihedral angles are binned in 10 degree steps, edge lengths in powers of two from
+ * 2^edge_len_log2_min to 2^edge_len_log2_max (first and last bin also collect everything below / above), valences
+ * from 0 to max_valence, where the last bin collects all valences >= max_valence. */
+static const uint32_t   dihedral_nbins          = 18;
+static const int        edge_len_log2_min       = -10;
+static const int        edge_len_log2_max       = 10;
+static const uint32_t   edge_len_nbins          = edge_len_log2_max - edge_len_log2_min + 1;
+static const uint32_t   max_valence             = 16;
+
+struct MeshStatResult {
+    std::string             filename;
+    std::string             error;
+
+    uint64_t                nvertices, nedges, nfaces, nobtuse_tris;
+    int64_t                 chi;
+    double                  area, volume, ar_avg, ar_sigma, ar_max;
+    double                  edge_len_min, edge_len_max, edge_len_avg;
+
+    /* topological information not available in stream mode */
+    bool                    topology;
+    uint64_t                nboundary_edges, nnonmanifold_edges;
+
+    /* number of intersecting pairs of non-adjacent triangles, -1 if not computed */
+    int64_t                 nself_isec;
+
+    std::vector<uint64_t>   dihedral_hist, edge_len_hist, valence_hist;
+    double                  time;
+};
+
+/* accumulator for all statistics that can be computed face by face, edge by edge or vertex by vertex. each thread
+ * fills its own accumulator over a range of the mesh, the partial results are merged afterwards. the per-face
+ * quantities are computed exactly as in Mesh::getTotalArea(), Mesh::getTotalVolume(), Mesh::getAvgAspectRatio() and
+ * Mesh::numObtuseTriangles(), aspect ratio moments are accumulated with Welford's method and merged pairwise. */
+class MeshStatAccumulator {
+    public:
+        uint64_t                nfaces, nobtuse_tris, nedges, nboundary_edges, nnonmanifold_edges;
+        double                  area, signed_volume;
+        double                  ar_mean, ar_m2, ar_max;
+        double                  edge_len_sum, edge_len_min, edge_len_max;
+
+        std::vector<uint64_t>   dihedral_hist, edge_len_hist, valence_hist;
+
+        MeshStatAccumulator() :
+            nfaces(0), nobtuse_tris(0), nedges(0), nboundary_edges(0), nnonmanifold_edges(0),
+            area(0.0), signed_volume(0.0),
+            ar_mean(0.0), ar_m2(0.0), ar_max(-Aux::Numbers::inf<double>()),
+            edge_len_sum(0.0), edge_len_min(Aux::Numbers::inf<double>()), edge_len_max(-Aux::Numbers::inf<double>()),
+            dihedral_hist(dihedral_nbins, 0),
+            edge_len_hist(edge_len_nbins, 0),
+            valence_hist(max_valence + 1, 0)
+        {}
+
+        void
+        addTriangle(
+            Vec3<double> const &v0,
+            Vec3<double> const &v1,
+            Vec3<double> const &v2)
+        {
+            /* area and signed volume */
+            this->area          += ((v1 - v0).cross(v2 - v0)).len2() / 2.0;
+            this->signed_volume += (v0 * v1.cross(v2)) / 6.0;
+
+            /* aspect ratio and obtuse test */
+            double a    = (v1 - v0).len2();
+            double b    = (v2 - v1).len2();
+            double c    = (v0 - v2).len2();
+            double s    = 0.5*(a + b + c);
+            double ar   = (a*b*c) / (8.0*(s - a)*(s - b)*(s - c));
+
+            this->nfaces++;
+            double delta    = ar - this->ar_mean;
+            this->ar_mean  += delta / (double)this->nfaces;
+            this->ar_m2    += delta*(ar - this->ar_mean);
+            this->ar_max    = std::max(this->ar_max, ar);
+
+            double aa = a*a, bb = b*b, cc = c*c;
+            if (aa + bb < cc || bb + cc < aa || cc + aa < bb) {
+                this->nobtuse_tris++;
+            }
+        }
+
+        void
+        addEdge(double len)
+        {
+            this->nedges++;
+            this->edge_len_sum += len;
+            this->edge_len_min  = std::min(this->edge_len_min, len);
+            this->edge_len_max  = std::max(this->edge_len_max, len);
+
+            int k = (len > 0.0) ? (int)std::floor(std::log2(len)) : edge_len_log2_min;
+            k = std::max(edge_len_log2_min, std::min(edge_len_log2_max, k));
+            this->edge_len_hist[k - edge_len_log2_min]++;
+        }
+
+        /* add dihedral angle given in degrees */
+        void
+        addDihedralAngle(double angle)
+        {
+            uint32_t k = (uint32_t)std::max(0.0, angle / (180.0 / dihedral_nbins));
+            this->dihedral_hist[std::min(k, dihedral_nbins - 1)]++;
+        }
+
+        void
+        addValence(uint32_t deg)
+        {
+            this->valence_hist[std::min(deg, max_valence)]++;
+        }
+
+        void
+        merge(MeshStatAccumulator const &b)
+        {
+            /* pairwise combination of mean and sum of squared deviations */
+            if (b.nfaces > 0) {
+                double n_a      = (double)this->nfaces;
+                double n_b      = (double)b.nfaces;
+                double delta    = b.ar_mean - this->ar_mean;
+
+                this->ar_mean   = (n_a*this->ar_mean + n_b*b.ar_mean) / (n_a + n_b);
+                this->ar_m2    += b.ar_m2 + delta*delta*n_a*n_b / (n_a + n_b);
+            }
+
+            this->nfaces               += b.nfaces;
+            this->nobtuse_tris         += b.nobtuse_tris;
+            this->nedges               += b.nedges;
+            this->nboundary_edges      += b.nboundary_edges;
+            this->nnonmanifold_edges   += b.nnonmanifold_edges;
+            this->area                 += b.area;
+            this->signed_volume        += b.signed_volume;
+            this->ar_max                = std::max(this->ar_max, b.ar_max);
+            this->edge_len_sum         += b.edge_len_sum;
+            this->edge_len_min          = std::min(this->edge_len_min, b.edge_len_min);
+            this->edge_len_max          = std::max(this->edge_len_max, b.edge_len_max);
+
+            for (uint32_t i = 0; i < dihedral_nbins; i++) {
+                this->dihedral_hist[i] += b.dihedral_hist[i];
+            }
+            for (uint32_t i = 0; i < edge_len_nbins; i++) {
+                this->edge_len_hist[i] += b.edge_len_hist[i];
+            }
+            for (uint32_t i = 0; i <= max_valence; i++) {
+                this->valence_hist[i]  += b.valence_hist[i];
+            }
+        }
+
+        void
+        finalize(
+            uint64_t        nvertices,
+            MeshStatResult &res) const
+        {
+            res.nvertices           = nvertices;
+            res.nedges              = this->nedges;
+            res.nfaces              = this->nfaces;
+            res.chi                 = (int64_t)nvertices - (int64_t)this->nedges + (int64_t)this->nfaces;
+            res.nobtuse_tris        = this->nobtuse_tris;
+            res.nboundary_edges     = this->nboundary_edges;
+            res.nnonmanifold_edges  = this->nnonmanifold_edges;
+            res.area                = this->area;
+            res.volume              = fabs(this->signed_volume);
+            res.ar_avg              = this->ar_mean;
+            res.ar_max              = this->ar_max;
+            /* sigma with bessel correction, as in Aux::Stat::computeMinMaxAvgSigma() */
+            res.ar_sigma            = std::sqrt(this->ar_m2 / ((double)this->nfaces - 1.0));
+            res.edge_len_min        = this->edge_len_min;
+            res.edge_len_max        = this->edge_len_max;
+            res.edge_len_avg        = this->edge_len_sum / (double)this->nedges;
+            res.dihedral_hist       = this->dihedral_hist;
+            res.edge_len_hist       = this->edge_len_hist;
+            res.valence_hist        = this->valence_hist;
+        }
+};
+
+/* split [0, n) into nthreads contiguous ranges and call f(range_id, begin, end) for each range concurrently. the first
+ * exception thrown by any range is rethrown after all threads have been joined. */
+template <typename F>
+static void
+parallelRanges(
+    size_t      n,
+    uint32_t    nthreads,
+    F const    &f)
 {
-    std::string meshname;
+    nthreads = std::max(1u, std::min<uint32_t>(nthreads, n > 0 ? n : 1));
+    Aux::Parallel::forEachIndex(nthreads, nthreads,
+        [&] (size_t t, uint32_t) -> void { f(t, (n*t) / nthreads, (n*(t + 1)) / nthreads); });
+}
 
-    if (argc == 2) {
-        meshname = std::string(argv[1]);
+/* parse the index of a face vertex reference "v", "v/t", "v//n" or "v/t/n" starting at p. returns zero-based vertex
+ * index and advances p past the reference. negative obj indices refer to the most recently declared vertices. */
+static uint32_t
+parseObjFaceVertex(
+    const char    *&p,
+    const char     *eol,
+    uint64_t        nvertices)
+{
+    char       *q;
+    long long   idx;
+
+    while (p < eol && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    idx = strtoll(p, &q, 10);
+    if (q == p) {
+        throw("am_meshstat: malformed face line.");
+    }
+
+    /* skip optional texture / normal indices */
+    p = q;
+    while (p < eol && *p != ' ' && *p != '\t' && *p != '\r') {
+        p++;
+    }
+
+    if (idx < 0) {
+        idx += (long long)nvertices;
     }
     else {
+        idx -= 1;
+    }
+
+    if (idx < 0 || (uint64_t)idx >= nvertices) {
+        throw("am_meshstat: face references undeclared vertex. stream mode requires vertices to be declared before use.");
+    }
+    return (uint32_t)idx;
+}
+
+/* compute statistics in a single pass over the memory-mapped obj file. only vertex positions, per-vertex valences
+ * and the hashed edge set are kept in memory, all remaining statistics are accumulated face by face. */
+static void
+computeStreamingObjStatistics(
+    const char     *filename,
+    MeshStatResult &res)
+{
+    SWCReader::MappedFile   file;
+    if (!file.open(filename)) {
+        throw MeshEx(MESH_IO_ERROR, "am_meshstat: can't open input file.");
+    }
+
+    std::vector<double>     pos;
+    std::vector<uint32_t>   valence;
+    StreamEdgeSet           edges(file.size() / 64);
+    MeshStatAccumulator     acc;
+    std::string             lastline;
+
+    const char *p   = file.data();
+    const char *end = file.data() + file.size();
+
+    while (p < end) {
+        const char *eol = (const char *)memchr(p, '\n', end - p);
+        const char *line;
+
+        /* strtod / strtoll need a terminating character inside valid memory. if the last line is not terminated by
+         * a newline, copy it. */
+        if (!eol) {
+            lastline.assign(p, end);
+            line    = lastline.c_str();
+            eol     = line + lastline.size();
+            p       = end;
+        }
+        else {
+            line    = p;
+            p       = eol + 1;
+        }
+
+        if (line[0] == 'v' && (line[1] == ' ' || line[1] == '\t')) {
+            char       *q;
+            const char *r = line + 1;
+            double      x[3];
+
+            for (int i = 0; i < 3; i++) {
+                x[i] = strtod(r, &q);
+                if (q == r) {
+                    throw("am_meshstat: malformed vertex line.");
+                }
+                r = q;
+            }
+            pos.insert(pos.end(), x, x + 3);
+            valence.push_back(0);
+        }
+        else if (line[0] == 'f' && (line[1] == ' ' || line[1] == '\t')) {
+            const char *r = line + 1;
+            uint32_t    vi[3];
+
+            for (int i = 0; i < 3; i++) {
+                vi[i] = parseObjFaceVertex(r, eol, valence.size());
+            }
+            while (r < eol && (*r == ' ' || *r == '\t' || *r == '\r')) {
+                r++;
+            }
+            if (r < eol) {
+                throw("am_meshstat: non-triangle face encountered. stream mode only supports triangle meshes.");
+            }
+
+            Vec3<double> v[3];
+            for (int i = 0; i < 3; i++) {
+                v[i] = Vec3<double>(pos[3*vi[i]], pos[3*vi[i] + 1], pos[3*vi[i] + 2]);
+            }
+            acc.addTriangle(v[0], v[1], v[2]);
+
+            for (int i = 0; i < 3; i++) {
+                int j = (i + 1) % 3;
+                if (edges.insert(vi[i], vi[j])) {
+                    acc.addEdge((v[j] - v[i]).len2());
+                    valence[vi[i]]++;
+                    valence[vi[j]]++;
+                }
+            }
+        }
+        /* comments, object declarations, normals, texture coordinates and empty lines are ignored. */
+    }
+
+    for (uint32_t deg : valence) {
+        acc.addValence(deg);
+    }
+
+    acc.finalize(valence.size(), res);
+    res.topology    = false;
+    res.nself_isec  = -1;
+}
+
+/* count pairs of intersecting triangles that do not share a vertex. candidate pairs are obtained with the same
+ * top-down spatial partitioning used by MeshAlg::getPotentiallyIntersectingEdgeFacePairs(), the exact tests are
+ * distributed over nthreads threads. */
+static uint64_t
+countSelfIntersections(
+    Mesh<bool, bool, bool, double>                         &M,
+    std::vector<Mesh<bool, bool, bool, double>::Face *>    &faces,
+    uint32_t                                                nthreads)
+{
+    typedef Mesh<bool, bool, bool, double>::Face FaceType;
+
+    std::vector<std::pair<FaceType *, BoundingBox<double>>> face_info_list(faces.size());
+    parallelRanges(faces.size(), nthreads,
+        [&] (uint32_t, size_t begin, size_t end) -> void
+        {
+            for (size_t i = begin; i < end; i++) {
+                face_info_list[i] = { faces[i], faces[i]->getBoundingBox() };
+            }
+        });
+
+    std::vector<std::pair<FaceType *, FaceType *>> candidate_pairs;
+    Aux::Geometry::computeSpatialIntersectionCandidatePairs<FaceType *, FaceType *, double>(
+            M.getBoundingBox(),
+            face_info_list, face_info_list,
+            0, 32, 8,
+            candidate_pairs);
+
+    /* every unordered pair is tested once: keep pairs with first id < second id, remove duplicates from different
+     * leaves */
+    auto it = std::remove_if(candidate_pairs.begin(), candidate_pairs.end(),
+        [] (std::pair<FaceType *, FaceType *> const &x) -> bool { return !(x.first->id() < x.second->id()); });
+    candidate_pairs.erase(it, candidate_pairs.end());
+
+    std::sort(candidate_pairs.begin(), candidate_pairs.end(),
+        [] (std::pair<FaceType *, FaceType *> const &x, std::pair<FaceType *, FaceType *> const &y) -> bool
+        {
+            if (x.first->id() < y.first->id()) return true;
+            if (y.first->id() < x.first->id()) return false;
+            return x.second->id() < y.second->id();
+        });
+    candidate_pairs.erase(std::unique(candidate_pairs.begin(), candidate_pairs.end()), candidate_pairs.end());
+
+    std::vector<uint64_t> nisec(std::max(1u, nthreads), 0);
+    parallelRanges(candidate_pairs.size(), nthreads,
+        [&] (uint32_t tid, size_t begin, size_t end) -> void
+        {
+            Vec3<double>    a0, a1, a2, b0, b1, b2;
+            uint32_t        a_ids[3], b_ids[3];
+
+            for (size_t i = begin; i < end; i++) {
+                FaceType *A = candidate_pairs[i].first;
+                FaceType *B = candidate_pairs[i].second;
+
+                /* adjacent triangles always touch, skip them */
+                A->getTriIndices(a_ids[0], a_ids[1], a_ids[2]);
+                B->getTriIndices(b_ids[0], b_ids[1], b_ids[2]);
+                if (std::find(b_ids, b_ids + 3, a_ids[0]) != b_ids + 3 ||
+                    std::find(b_ids, b_ids + 3, a_ids[1]) != b_ids + 3 ||
+                    std::find(b_ids, b_ids + 3, a_ids[2]) != b_ids + 3)
+                {
+                    continue;
+                }
+
+                A->getTriPositions(a0, a1, a2);
+                B->getTriPositions(b0, b1, b2);
+                if (Aux::Geometry::triTri3d(a0, a1, a2, b0, b1, b2)) {
+                    nisec[tid]++;
+                }
+            }
+        });
+
+    return std::accumulate(nisec.begin(), nisec.end(), (uint64_t)0);
+}
+
+/* compute all statistics of an obj mesh with one fused sweep over faces and vertices, split among nthreads threads.
+ * each face accounts for its own area, volume, aspect ratio and obtuseness as well as for all of its edges for which
+ * it is the incident face with minimum id (edge length, dihedral angle, boundary / non-manifold classification). */
+static void
+computeMeshStatistics(
+    const char     *filename,
+    uint32_t        nthreads,
+    bool            self_isec,
+    MeshStatResult &res)
+{
+    typedef Mesh<bool, bool, bool, double> MeshType;
+
+    MeshType M;
+    M.readFromObjFile(filename);
+
+    std::vector<MeshType::Face *>   faces;
+    std::vector<MeshType::Vertex *> vertices;
+
+    faces.reserve(M.numFaces());
+    vertices.reserve(M.numVertices());
+    for (auto &f : M.faces) {
+        f.checkTri("am_meshstat:");
+        faces.push_back(&f);
+    }
+    for (auto &v : M.vertices) {
+        vertices.push_back(&v);
+    }
+
+    nthreads = std::max(1u, nthreads);
+    std::vector<MeshStatAccumulator> partial(nthreads);
+
+    parallelRanges(faces.size(), nthreads,
+        [&] (uint32_t tid, size_t begin, size_t end) -> void
+        {
+            MeshStatAccumulator    &acc = partial[tid];
+            MeshType::Vertex       *fv[3];
+            MeshType::Face         *efaces[8];
+            Vec3<double>            p[3], n_f, n_g, g0, g1, g2;
+
+            for (size_t i = begin; i < end; i++) {
+                MeshType::Face *f = faces[i];
+
+                f->getTriVertices(fv[0], fv[1], fv[2]);
+                for (int k = 0; k < 3; k++) {
+                    p[k] = fv[k]->pos();
+                }
+                acc.addTriangle(p[0], p[1], p[2]);
+                n_f = (p[1] - p[0]).cross(p[2] - p[0]);
+                n_f.normalize();
+
+                for (int k = 0; k < 3; k++) {
+                    int     l       = (k + 1) % 3;
+                    size_t  nfaces  = 8;
+                    bool    owner   = true;
+
+                    M.getFacesIncidentToEdge(fv[k]->iterator(), fv[l]->iterator(), efaces, nfaces);
+                    for (size_t j = 0; j < nfaces; j++) {
+                        if (efaces[j]->id() < f->id()) {
+                            owner = false;
+                        }
+                    }
+                    if (!owner) {
+                        continue;
+                    }
+
+                    acc.addEdge((p[l] - p[k]).len2());
+                    if (nfaces == 1) {
+                        acc.nboundary_edges++;
+                    }
+                    else if (nfaces > 2) {
+                        acc.nnonmanifold_edges++;
+                    }
+                    else {
+                        MeshType::Face *g = (efaces[0] == f) ? efaces[1] : efaces[0];
+
+                        g->getTriPositions(g0, g1, g2);
+                        n_g = (g1 - g0).cross(g2 - g0);
+                        n_g.normalize();
+
+                        /* interior dihedral angle = pi - angle between consistently oriented normals */
+                        double cos_phi = std::max(-1.0, std::min(1.0, n_f*n_g));
+                        acc.addDihedralAngle(180.0 - Aux::Numbers::rad2deg(std::acos(cos_phi)));
+                    }
+                }
+            }
+        });
+
+    std::vector<MeshStatAccumulator> vpartial(nthreads);
+    parallelRanges(vertices.size(), nthreads,
+        [&] (uint32_t tid, size_t begin, size_t end) -> void
+        {
+            std::vector<uint32_t> star;
+
+            for (size_t i = begin; i < end; i++) {
+                vertices[i]->getVertexStarIndicesVector(star);
+                std::sort(star.begin(), star.end());
+                vpartial[tid].addValence(std::unique(star.begin(), star.end()) - star.begin());
+            }
+        });
+
+    MeshStatAccumulator acc;
+    for (uint32_t t = 0; t < nthreads; t++) {
+        acc.merge(partial[t]);
+        acc.merge(vpartial[t]);
+    }
+
+    acc.finalize(vertices.size(), res);
+    res.topology    = true;
+    res.nself_isec  = self_isec ? (int64_t)countSelfIntersections(M, faces, nthreads) : -1;
+}
+
+static void
+printMeshStatisticsText(MeshStatResult const &res)
+{
+    if (!res.error.empty()) {
+        printf("Mesh: \"%s\"\n\nerror: %s\n", res.filename.c_str(), res.error.c_str());
+        return;
+    }
+
+    printf("Mesh: \"%s\"\n\n"\
+           "nvertices:      %8lu\n"\
+           "nedges:         %8lu\n"\
+           "nfaces:         %8lu\n"\
+           "chi:            %8ld\n"\
+           "area:           %14.5f\n"\
+           "volume:         %14.5f\n"\
+           "ar_avg:         %14.5f\n"\
+           "ar_sigma:       %14.5f\n"\
+           "ar_max:         %14.5f\n"\
+           "obtuse tris:    %8lu\n"\
+           "edge_len_min:   %14.5f\n"\
+           "edge_len_avg:   %14.5f\n"\
+           "edge_len_max:   %14.5f\n",
+            res.filename.c_str(),
+            (unsigned long)res.nvertices, (unsigned long)res.nedges, (unsigned long)res.nfaces, (long)res.chi,
+            res.area, res.volume, res.ar_avg, res.ar_sigma, res.ar_max,
+            (unsigned long)res.nobtuse_tris,
+            res.edge_len_min, res.edge_len_avg, res.edge_len_max);
+
+    if (res.topology) {
+        printf("boundary edges: %8lu\n"\
+               "nonmf edges:    %8lu\n",
+                (unsigned long)res.nboundary_edges, (unsigned long)res.nnonmanifold_edges);
+    }
+    if (res.nself_isec >= 0) {
+        printf("self isecs:     %8ld\n", (long)res.nself_isec);
+    }
+
+    if (res.topology) {
+        printf("\ndihedral angle histogram:\n");
+        for (uint32_t i = 0; i < dihedral_nbins; i++) {
+            printf("    [%3d, %3d): %10lu\n", i*180/dihedral_nbins, (i + 1)*180/dihedral_nbins, (unsigned long)res.dihedral_hist[i]);
+        }
+    }
+
+    printf("\nedge length histogram:\n");
+    for (uint32_t i = 0; i < edge_len_nbins; i++) {
+        printf("    [2^%3d, 2^%3d): %10lu\n", edge_len_log2_min + (int)i, edge_len_log2_min + (int)i + 1, (unsigned long)res.edge_len_hist[i]);
+    }
+
+    printf("\nvalence histogram:\n");
+    for (uint32_t i = 0; i <= max_valence; i++) {
+        printf("    %2d%s: %10lu\n", i, (i == max_valence) ? "+" : " ", (unsigned long)res.valence_hist[i]);
+    }
+    printf("\ntime:           %14.5f\n", res.time);
+}
+
+static std::string
+jsonEscape(std::string const &s)
+{
+    std::string r;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            r += '\\';
+            r += c;
+        }
+        else if ((unsigned char)c < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            r += buf;
+        }
+        else {
+            r += c;
+        }
+    }
+    return r;
+}
+
+/* format x with %.10g, or as null if x is not finite (e.g. averages over an empty mesh), which JSON can't represent. */
+static std::string
+jsonNumber(double x)
+{
+    char buf[32];
+
+    if (!std::isfinite(x)) {
+        return "null";
+    }
+    snprintf(buf, sizeof(buf), "%.10g", x);
+    return buf;
+}
+
+static void
+printJsonArray(std::vector<uint64_t> const &v)
+{
+    printf("[");
+    for (size_t i = 0; i < v.size(); i++) {
+        printf("%s%lu", i ? ", " : "", (unsigned long)v[i]);
+    }
+    printf("]");
+}
+
+static void
+printMeshStatisticsJson(std::vector<MeshStatResult> const &results)
+{
+    printf("{\n  \"meshes\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        MeshStatResult const &res = results[i];
+
+        printf("    {\n      \"file\": \"%s\",\n", jsonEscape(res.filename).c_str());
+        if (!res.error.empty()) {
+            printf("      \"error\": \"%s\"\n    }%s\n", jsonEscape(res.error).c_str(), (i + 1 < results.size()) ? "," : "");
+            continue;
+        }
+
+        printf("      \"nvertices\": %lu,\n"\
+               "      \"nedges\": %lu,\n"\
+               "      \"nfaces\": %lu,\n"\
+               "      \"chi\": %ld,\n"\
+               "      \"area\": %s,\n"\
+               "      \"volume\": %s,\n"\
+               "      \"ar_avg\": %s,\n"\
+               "      \"ar_sigma\": %s,\n"\
+               "      \"ar_max\": %s,\n"\
+               "      \"obtuse_tris\": %lu,\n"\
+               "      \"edge_len_min\": %s,\n"\
+               "      \"edge_len_avg\": %s,\n"\
+               "      \"edge_len_max\": %s,\n",
+                (unsigned long)res.nvertices, (unsigned long)res.nedges, (unsigned long)res.nfaces, (long)res.chi,
+                jsonNumber(res.area).c_str(), jsonNumber(res.volume).c_str(), jsonNumber(res.ar_avg).c_str(),
+                jsonNumber(res.ar_sigma).c_str(), jsonNumber(res.ar_max).c_str(),
+                (unsigned long)res.nobtuse_tris,
+                jsonNumber(res.edge_len_min).c_str(), jsonNumber(res.edge_len_avg).c_str(),
+                jsonNumber(res.edge_len_max).c_str());
+
+        if (res.topology) {
+            printf("      \"boundary_edges\": %lu,\n"\
+                   "      \"nonmanifold_edges\": %lu,\n",
+                    (unsigned long)res.nboundary_edges, (unsigned long)res.nnonmanifold_edges);
+        }
+        else {
+            printf("      \"boundary_edges\": null,\n      \"nonmanifold_edges\": null,\n");
+        }
+
+        if (res.nself_isec >= 0) {
+            printf("      \"self_intersections\": %ld,\n", (long)res.nself_isec);
+        }
+        else {
+            printf("      \"self_intersections\": null,\n");
+        }
+
+        printf("      \"dihedral_histogram\": { \"bin_width_deg\": %d, \"counts\": ", 180 / dihedral_nbins);
+        if (res.topology) {
+            printJsonArray(res.dihedral_hist);
+        }
+        else {
+            printf("null");
+        }
+        printf(" },\n      \"edge_length_histogram\": { \"log2_min\": %d, \"log2_max\": %d, \"counts\": ", edge_len_log2_min, edge_len_log2_max);
+        printJsonArray(res.edge_len_hist);
+        printf(" },\n      \"valence_histogram\": { \"max_valence\": %d, \"counts\": ", max_valence);
+        printJsonArray(res.valence_hist);
+        printf(" },\n      \"time\": %.6f\n    }%s\n", res.time, (i + 1 < results.size()) ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string>    meshnames;
+    bool                        stream      = false;
+    bool                        json        = false;
+    bool                        self_isec   = true;
+    uint32_t                    nthreads    = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+
+        if (arg == "-stream") {
+            stream = true;
+        }
+        else if (arg == "-json") {
+            json = true;
+        }
+        else if (arg == "-no-isec") {
+            self_isec = false;
+        }
+        else if (arg == "-threads" && i + 1 < argc) {
+            try {
+                nthreads = Aux::Alg::stou(argv[++i]);
+            }
+            catch (...) {
+                printf("ERROR: invalid argument for switch \"-threads\".\n");
+                return EXIT_FAILURE;
+            }
+            if (nthreads == 0) {
+                printf("ERROR: number of threads must be positive.\n");
+                return EXIT_FAILURE;
+            }
+        }
+        else if (arg[0] == '-') {
+            printf("%s", usage_text.c_str());
+            return EXIT_FAILURE;
+        }
+        else {
+            meshnames.push_back(arg);
+        }
+    }
+
+    if (meshnames.empty()) {
         printf("%s", usage_text.c_str());
         return EXIT_FAILURE;
     }
-    try {
-        double      area, volume, ar_avg, ar_sigma, ar_max;
-        uint32_t    nobtuse_tris;
-        int         nvertices, nfaces, nedges, chi;
-
-        Mesh<bool, bool, bool, double> M;
-        M.readFromObjFile(meshname.c_str());
-
-        /* statistics */
-        area            = M.getTotalArea();
-        volume          = M.getTotalVolume();
-        nvertices       = M.numVertices();
-        nfaces          = M.numFaces();
-        nedges          = M.numEdges();
-        chi             = nvertices - nedges + nfaces;
-        M.getAvgAspectRatio(ar_avg, ar_sigma, &ar_max);
-        nobtuse_tris    = M.numObtuseTriangles();
-
-        printf("Mesh: \"%s\"\n\n"\
-               "nvertices:      %8d\n"\
-               "nedges:         %8d\n"\
-               "nfaces:         %8d\n"\
-               "chi:            %8d\n"\
-               "area:           %14.5f\n"\
-               "volume:         %14.5f\n"\
-               "ar_avg:         %14.5f\n"\
-               "ar_sigma:       %14.5f\n"\
-               "ar_max:         %14.5f\n"\
-               "obtuse tris:    %8d\n",
-                meshname.c_str(), nvertices, nedges, nfaces, chi, 
-                area, volume, ar_avg, ar_sigma, ar_max,
-                nobtuse_tris);
-
-        fflush(stdout);
-    }
-    catch (const char *err) {
-        printf("caught string err: \"%s\". shutting down..\n", err);
-    }
-    catch (std::string& err) {
-        printf("caught string err: \"%s\". shutting down..\n", err.c_str());
-    }
-    catch (MeshEx& ex) {
-        printf("caught MeshEx. error msg: \"%s\". shutting down..\n", ex.error_msg.c_str());
-    }
-    catch (...) {
-        printf("caught unhandled exception. shutting down..\n");
+
+    /* meshes are processed concurrently by up to nthreads workers, the remaining threads are distributed among the
+     * workers for the fused reduction over each individual mesh. */
+    std::vector<MeshStatResult> results(meshnames.size());
+    uint32_t                    nworkers            = std::min<uint32_t>(nthreads, meshnames.size());
+    uint32_t                    nthreads_per_mesh   = std::max(1u, nthreads / nworkers);
+
+    /* every mesh reports its own errors, so the workers never throw */
+    Aux::Parallel::forEachIndex(meshnames.size(), nworkers,
+        [&] (size_t i, uint32_t) -> void
+        {
+            MeshStatResult &res = results[i];
+            res.filename        = meshnames[i];
+            double t0           = Aux::Timing::doubletime();
+
+            try {
+                if (stream) {
+                    computeStreamingObjStatistics(meshnames[i].c_str(), res);
+                }
+                else {
+                    computeMeshStatistics(meshnames[i].c_str(), nthreads_per_mesh, self_isec, res);
+                }
+            }
+            catch (const char *err) {
+                res.error = std::string("caught string err: ") + err;
+            }
+            catch (std::string& err) {
+                res.error = "caught string err: " + err;
+            }
+            catch (MeshEx& ex) {
+                res.error = "caught MeshEx. error msg: " + ex.error_msg;
+            }
+            catch (...) {
+                res.error = "caught unhandled exception.";
+            }
+            res.time = Aux::Timing::doubletime() - t0;
+        });
+
+    bool failed = false;
+    for (auto &res : results) {
+        failed = failed || !res.error.empty();
     }
+
+    if (json) {
+        printMeshStatisticsJson(results);
+    }
+    else {
+        for (size_t i = 0; i < results.size(); i++) {
+            if (i > 0) {
+                printf("\n--------------------------------------------------------------------------------\n");
+            }
+            printMeshStatisticsText(results[i]);
+        }
+    }
+    fflush(stdout);
+
+    return (failed ? EXIT_FAILURE : EXIT_SUCCESS);
 }
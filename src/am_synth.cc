@@ -0,0 +1,231 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "common.hh"
+
+#include "aux.hh"
+#include "SWCSynth.hh"
+
+std::string const usage_text =
+"Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph).\n"\
+"\n"\
+"am_synth: generate a reproducible synthetic cell network in SWC format.\n"\
+"\n"\
+"Usage: am_synth [OPTIONS] -o <SWC_FILE>\n"\
+"\n"\
+"somas are placed on a jittered cubic grid. every soma grows a number of neurites, every growing tip terminates,\n"\
+"bifurcates or is extended by one segment at a time. the output only depends on the options, including the seed.\n"\
+"\n"\
+"OPTIONS:\n"\
+"-seed <n>                       seed of the random number generator. default: 0.\n"\
+"\n"\
+"-cells <n>                      number of cells. default: 1.\n"\
+"\n"\
+"-density <d>                    packing density in cells per cubic millimetre. default: 1000.\n"\
+"\n"\
+"-soma-radius <mean> <sigma>     normal distribution of soma radii. default: 8 1.\n"\
+"\n"\
+"-neurites <n>                   number of neurites per cell. default: 5.\n"\
+"\n"\
+"-branch-prob <p>                probability that a tip bifurcates instead of being extended. default: 0.05.\n"\
+"\n"\
+"-term-prob <p>                  probability that a tip terminates. default: 0.08.\n"\
+"\n"\
+"-min-segments <n>               minimum number of segments between a branch point or root and a terminal.\n"\
+"                                default: 5.\n"\
+"\n"\
+"-max-order <n>                  maximum branch order. default: 6.\n"\
+"\n"\
+"-max-cell-vertices <n>          maximum number of vertices of a cell, including the soma. default: 5000.\n"\
+"\n"\
+"-seg-len <mean> <sigma>         lognormal distribution of segment lengths. default: 5 2.\n"\
+"\n"\
+"-tortuosity <s>                 standard deviation of the direction change per segment. default: 0.15.\n"\
+"\n"\
+"-branch-angle <deg>             angle between the two children of a bifurcation in degrees. default: 60.\n"\
+"\n"\
+"-radius <mean> <sigma>          normal distribution of neurite root radii. default: 1.5 0.3.\n"\
+"\n"\
+"-radius-min <r>                 minimum neurite radius. default: 0.25.\n"\
+"\n"\
+"-radius-taper <f>               factor applied to the radius per segment. default: 0.99.\n"\
+"\n"\
+"-branch-radius-ratio <f>        factor applied to the radius at bifurcations. default: 0.63.\n"\
+"\n"\
+"-isec-rate <p>                  fraction of terminal tips that are extended through the nearest segment of another\n"\
+"                                neurite within reach, forcing an intersection. default: 0.\n"\
+"\n";
+
+int main(int argc, char *argv[])
+{
+    SWCSynth::Parameters    p;
+    std::string             filename;
+    std::string             cmdline = "am_synth";
+
+    for (int i = 1; i < argc; i++) {
+        cmdline += std::string(" ") + argv[i];
+    }
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+
+        /* number of values the switch takes */
+        uint32_t nvalues = 1;
+        if (arg == "-soma-radius" || arg == "-seg-len" || arg == "-radius") {
+            nvalues = 2;
+        }
+        if (arg[0] != '-' || i + (int)nvalues >= argc) {
+            printf("%s", usage_text.c_str());
+            return EXIT_FAILURE;
+        }
+
+        try {
+            if (arg == "-o") {
+                filename = argv[++i];
+            }
+            else if (arg == "-seed") {
+                p.seed = Aux::Alg::stou(argv[++i]);
+            }
+            else if (arg == "-cells") {
+                p.n_cells = Aux::Alg::stou(argv[++i]);
+            }
+            else if (arg == "-density") {
+                p.density = std::stod(argv[++i]);
+            }
+            else if (arg == "-soma-radius") {
+                p.soma_radius_mean  = std::stod(argv[++i]);
+                p.soma_radius_sigma = std::stod(argv[++i]);
+            }
+            else if (arg == "-neurites") {
+                p.n_neurites = Aux::Alg::stou(argv[++i]);
+            }
+            else if (arg == "-branch-prob") {
+                p.branch_probability = std::stod(argv[++i]);
+            }
+            else if (arg == "-term-prob") {
+                p.termination_probability = std::stod(argv[++i]);
+            }
+            else if (arg == "-min-segments") {
+                p.min_segments = Aux::Alg::stou(argv[++i]);
+            }
+            else if (arg == "-max-order") {
+                p.max_order = Aux::Alg::stou(argv[++i]);
+            }
+            else if (arg == "-max-cell-vertices") {
+                p.max_cell_vertices = Aux::Alg::stou(argv[++i]);
+            }
+            else if (arg == "-seg-len") {
+                p.segment_length_mean   = std::stod(argv[++i]);
+                p.segment_length_sigma  = std::stod(argv[++i]);
+            }
+            else if (arg == "-tortuosity") {
+                p.tortuosity = std::stod(argv[++i]);
+            }
+            else if (arg == "-branch-angle") {
+                p.branch_angle = Aux::Numbers::deg2rad(std::stod(argv[++i]));
+            }
+            else if (arg == "-radius") {
+                p.radius_mean   = std::stod(argv[++i]);
+                p.radius_sigma  = std::stod(argv[++i]);
+            }
+            else if (arg == "-radius-min") {
+                p.radius_min = std::stod(argv[++i]);
+            }
+            else if (arg == "-radius-taper") {
+                p.radius_taper = std::stod(argv[++i]);
+            }
+            else if (arg == "-branch-radius-ratio") {
+                p.branch_radius_ratio = std::stod(argv[++i]);
+            }
+            else if (arg == "-isec-rate") {
+                p.intersection_rate = std::stod(argv[++i]);
+            }
+            else {
+                printf("%s", usage_text.c_str());
+                return EXIT_FAILURE;
+            }
+        }
+        catch (...) {
+            printf("ERROR: invalid argument for switch \"%s\".\n", arg.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (filename.empty()) {
+        printf("%s", usage_text.c_str());
+        return EXIT_FAILURE;
+    }
+
+    try {
+        std::vector<SWCReader::Record<double>>  records;
+        SWCSynth::Statistics                    stats;
+
+        double t0 = Aux::Timing::doubletime();
+        SWCSynth::generate(p, records, &stats);
+        SWCSynth::write(filename, records, { "generated by " + cmdline });
+        double t1 = Aux::Timing::doubletime();
+
+        printf("am_synth: wrote \"%s\" (%.3fs).\n", filename.c_str(), t1 - t0);
+        printf("\t cells:                  %10u\n", p.n_cells);
+        printf("\t vertices:               %10u\n", stats.n_vertices);
+        printf("\t branch points:          %10u\n", stats.n_branch_points);
+        printf("\t terminals:              %10u\n", stats.n_terminals);
+        printf("\t forced intersections:   %10u\n", stats.n_forced_intersections);
+        printf("\t total neurite length:   %10.1f\n", stats.total_length);
+        printf("\t cube side length:       %10.1f\n", stats.cube_side);
+    }
+    catch (const char *err) {
+        printf("ERROR: %s\n", err);
+        return EXIT_FAILURE;
+    }
+    catch (...) {
+        printf("ERROR: main(): unhandled exception at top level.\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
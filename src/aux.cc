@@ -53,7 +53,8 @@
 
 namespace Aux {
     namespace Timing {
-        struct timeval 
+        /* timer registers are per thread, since meshing may run on several threads. */
+        thread_local struct timeval
             starttimes[TIMER_REGISTERS], 
             endtimes[TIMER_REGISTERS];
 
@@ -85,14 +86,34 @@ namespace Aux {
     }
 
     namespace Numbers {
+        /* generator installed by ScopedRandomGenerator on the calling thread, if any */
+        thread_local std::mt19937  *frand_rng = NULL;
+
         /* random double */
         double
         frand(double min, double max)
         {
-            double f = (double)std::rand() / RAND_MAX;
+            double f;
+            if (frand_rng) {
+                f = (double)(*frand_rng)() / (double)std::mt19937::max();
+            }
+            else {
+                f = (double)std::rand() / RAND_MAX;
+            }
             return (min + f*(max - min));
         }
 
+        ScopedRandomGenerator::ScopedRandomGenerator(std::mt19937 &rng)
+        {
+            this->previous  = frand_rng;
+            frand_rng       = &rng;
+        }
+
+        ScopedRandomGenerator::~ScopedRandomGenerator()
+        {
+            frand_rng       = this->previous;
+        }
+
         double
         fmin3(double a, double b, double c)
         {
@@ -44,6 +44,107 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+/* ------------------------------------------------------------------------------------------------------------------ *
+ *                                                                                                                    *
+ *                        CanalSurfaceRingCache implementation..                                                      *
+ *                                                                                                                    *
+ * ------------------------------------------------------------------------------------------------------------------ */
+template <typename R>
+CanalSurfaceRingCache<R>::CanalSurfaceRingCache(
+    uint32_t    n_phi_segments,
+    R const    &phi_0)
+{
+    this->n_phi_segments    = n_phi_segments;
+    this->phi_0             = phi_0;
+    this->ntriangles        = 0;
+
+    /* NOTE: angles are computed with exactly the same expressions as previously done per ring, so that the generated
+     * vertex positions are bit-identical. */
+    R const dphi            = Common::twopi / (R)n_phi_segments;
+    R const phi_offsets[2]  = { phi_0, phi_0 + dphi / 2.0 };
+
+    for (uint32_t k = 0; k < 2; k++) {
+        this->cos_phi[k].resize(n_phi_segments);
+        this->sin_phi[k].resize(n_phi_segments);
+
+        for (uint32_t j = 0; j < n_phi_segments; j++) {
+            R phi                   = ( (R)j * Common::twopi) / (R)n_phi_segments;
+            this->cos_phi[k][j]     = cos(phi + phi_offsets[k]);
+            this->sin_phi[k][j]     = sin(phi + phi_offsets[k]);
+        }
+    }
+}
+
+template <typename R>
+bool
+CanalSurfaceRingCache<R>::matches(
+    uint32_t    n_phi_segments,
+    R const    &phi_0) const
+{
+    return (this->n_phi_segments == n_phi_segments && this->phi_0 == phi_0);
+}
+
+template <typename R>
+uint32_t
+CanalSurfaceRingCache<R>::getNPhiSegments() const
+{
+    return (this->n_phi_segments);
+}
+
+template <typename R>
+R
+CanalSurfaceRingCache<R>::getPhi0() const
+{
+    return (this->phi_0);
+}
+
+template <typename R>
+template <typename Tm, typename Tv, typename Tf>
+void
+CanalSurfaceRingCache<R>::appendRing(
+    Mesh<Tm, Tv, Tf, R>                                    &M,
+    Vec3<R> const                                          &p,
+    Vec3<R> const                                          &py,
+    Vec3<R> const                                          &pz,
+    R const                                                &r,
+    bool                                                    offset,
+    std::vector<
+            typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
+        >                                                  &ring) const
+{
+    R const    *c = this->cos_phi[offset ? 1 : 0].data();
+    R const    *s = this->sin_phi[offset ? 1 : 0].data();
+    R           rc, rs;
+
+    /* componentwise evaluation of p + py*(r*c) + pz*(r*s), same evaluation order as the Vec3 operators */
+    for (uint32_t j = 0; j < this->n_phi_segments; j++) {
+        rc      = r*c[j];
+        rs      = r*s[j];
+        ring[j] = M.vertices.insert(
+                Vec3<R>(
+                    (p[0] + py[0]*rc) + pz[0]*rs,
+                    (p[1] + py[1]*rc) + pz[1]*rs,
+                    (p[2] + py[2]*rc) + pz[2]*rs)
+            );
+    }
+}
+
+template <typename R>
+void
+CanalSurfaceRingCache<R>::countTriangles(uint64_t n)
+{
+    this->ntriangles += n;
+}
+
+template <typename R>
+uint64_t
+CanalSurfaceRingCache<R>::takeTriangleCount()
+{
+    uint64_t n          = this->ntriangles;
+    this->ntriangles    = 0;
+    return n;
+}
+
 /* ------------------------------------------------------------------------------------------------------------------ *
  *                                                                                                                    *
  *                        CanalSurface implementation..                                                               *
@@ -268,17 +369,26 @@ CanalSurface<C2F, RadF, R>::generateMesh(
             typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
         >                                                  *end_circle_its,
     typename Mesh<Tm, Tv, Tf, R>::vertex_iterator          *closing_vertex_it,
-	bool                                                    preserve_crease_edges) const
+	bool                                                    preserve_crease_edges,
+    CanalSurfaceRingCache<R>                               *ring_cache) const
 {
     debugl(1, "CanalSurface::generateMesh().\n");
     debugTabInc();
 
     uint32_t    i, j, ntsegments;
-    R           t, r, phi, dphi, phi_offset;
-    Vec3<R>     c, p, n, last_p, a, px, py, pz, vpos;
+    R           t, r, dphi;
+    bool        ring_offset;
+    Vec3<R>     c, p, n, last_p, a, px, py, pz;
 
     dphi = Common::twopi / (R)n_phi_segments;
 
+    /* use the given ring cache if it has been built for n_phi_segments and phi_0, otherwise set up a local one */
+    std::unique_ptr<CanalSurfaceRingCache<R>> local_ring_cache;
+    if (!ring_cache || !ring_cache->matches(n_phi_segments, phi_0)) {
+        local_ring_cache.reset(new CanalSurfaceRingCache<R>(n_phi_segments, phi_0));
+        ring_cache = local_ring_cache.get();
+    }
+
     /* compute t values: start at t = 0.0 and compute an increment based on the radius. if the
      * radius is larger, we want to take a larger step than if it is smaller. the step is computed
      * in the following way: with n_phi_segments given, the length of a line segment on the
@@ -365,15 +475,10 @@ CanalSurface<C2F, RadF, R>::generateMesh(
         typename Mesh<Tm, Tv, Tf, R>::vertex_iterator   start_closing_vertex_it;
 
         /* start circle is never offset, overwrite wrong argument if necessary */
-        phi_offset          = phi_0;
         start_circle_offset = false;
 
         /* generate starting circle vertices and save iterators */
-        for (j = 0; j < n_phi_segments; j++) {
-            phi                         = ( (R)j * Common::twopi) / (R)n_phi_segments;
-            vpos                        = p + py*(r*cos(phi + phi_offset)) + pz*(r*sin(phi + phi_offset));
-            current_circle[j]           = M.vertices.insert(vpos);
-        }
+        ring_cache->appendRing(M, p, py, pz, r, false, current_circle);
 
         /* get centroid of initial circle */
         start_closing_vertex_it     = M.vertices.insert(p);
@@ -383,6 +488,7 @@ CanalSurface<C2F, RadF, R>::generateMesh(
         for (j = 0; j < n_phi_segments - 1; j++) {
             M.faces.insert(start_closing_vertex_it, current_circle[j+1], current_circle[j]);
         }
+        ring_cache->countTriangles(n_phi_segments);
     }
     /* otherwise, this canal surface is not the start canal segment and the previous canal surface
      * has already generated the vertices of the start circle, which is the end circle of the
@@ -409,15 +515,15 @@ CanalSurface<C2F, RadF, R>::generateMesh(
         if (start_circle_offset)
         {
             if (!preserve_crease_edges && i % 2 == 0)
-                phi_offset = phi_0 + dphi / 2.0;
+                ring_offset = true;
             else
-                phi_offset = phi_0;
+                ring_offset = false;
         }
         else {
             if (preserve_crease_edges || i % 2 == 0)
-                phi_offset = phi_0;
+                ring_offset = false;
             else
-                phi_offset = phi_0 + dphi / 2.0;
+                ring_offset = true;
         }
 
         //t = (R)i / (R)ntsegments;
@@ -435,10 +541,7 @@ CanalSurface<C2F, RadF, R>::generateMesh(
         //this->spineCurveGetFrenetFrame(t, px, py, pz);
 
         /* generate current circle vertices and save iterators */
-        for (j = 0; j < n_phi_segments; j++) {
-            phi                 = ( (R)j * Common::twopi) / (R)n_phi_segments;
-            current_circle[j]   = M.vertices.insert( p + py*(r*cos(phi + phi_offset)) + pz*(r*sin(phi + phi_offset)) );
-        }
+        ring_cache->appendRing(M, p, py, pz, r, ring_offset, current_circle);
 
         /* generate quad faces between last_circle and current_circle */
         for (j = 0; j < n_phi_segments - 1; j++) {
@@ -447,6 +550,7 @@ CanalSurface<C2F, RadF, R>::generateMesh(
 
         /* closing quad at index wrap-around */
         M.faces.insert(last_circle[n_phi_segments - 1], last_circle[0], current_circle[0], current_circle[n_phi_segments - 1]);
+        ring_cache->countTriangles(2*n_phi_segments);
     }
 
     debugl(1, "rendering last circle..\n");
@@ -463,28 +567,22 @@ CanalSurface<C2F, RadF, R>::generateMesh(
     if (start_circle_offset)
     {
         if (!preserve_crease_edges && ntsegments % 2 == 0)
-            phi_offset = phi_0 + dphi / 2.0;
+            ring_offset = true;
         else
-            phi_offset = phi_0;
+            ring_offset = false;
     }
     else
     {
         if (preserve_crease_edges || ntsegments % 2 == 0)
-            phi_offset = phi_0;
+            ring_offset = false;
         else
-            phi_offset = phi_0 + dphi / 2.0;
+            ring_offset = true;
     }
 
     px.print_debugl(1);
     py.print_debugl(1);
     pz.print_debugl(1);
-    debugTabInc();
-    for (j = 0; j < n_phi_segments; j++) {
-        phi                     = ( (R)j * Common::twopi) / (R)n_phi_segments;
-        vpos                    = p + py*(r*cos(phi + phi_offset)) + pz*(r*sin(phi + phi_offset));
-        current_circle[j]       = M.vertices.insert(vpos);
-    }
-    debugTabDec();
+    ring_cache->appendRing(M, p, py, pz, r, ring_offset, current_circle);
 
     /* get centroid of last circle vertices and place closing vertex in the middle */
     Vec3<R> end_closing_vertex_pos = p;
@@ -503,6 +601,7 @@ CanalSurface<C2F, RadF, R>::generateMesh(
     for (j = 0; j < n_phi_segments - 1; j++) {
         M.faces.insert(end_closing_vertex_it, current_circle[j], current_circle[j + 1] );
     }
+    ring_cache->countTriangles(3*n_phi_segments);
 
     /* if desired by the caller, write out information to referenced data */
     if (end_circle_its) {
@@ -787,48 +886,55 @@ template <uint32_t degree, typename R>
 void
 BLRCanalSurface<degree, R>::initGlobalSelfIntersectionData()
 {
-    uint32_t i, j, k, m;
-    std::vector<PowerPolynomial<degree, R, R> >  B_n_pow;
-    StaticMatrix<degree, degree, R> F_i_n_powercoeff;
+    /* G only depends on the degree, so it is computed once per process and then shared by all canal surfaces of all
+     * cell networks. */
+    static std::once_flag G_init_flag;
 
-    // helper polynomials
-    StaticVector<degree+1, BiBernsteinPolynomial<degree-1, degree-1, R, R> > F;
-
-    // compute the monomial representation of each i-th Bernstein basis polynom B_i^n(t)
-    B_n_pow.resize(degree+1);
-    for (i = 0; i < degree + 1; ++i)
-        PolyAlg::convertBasis<degree, R>(B_n_pow[i], PolyAlg::computeBernsteinBasisPoly<degree, R, R>(i));
-
-    // compute all bivariate polynomials F_i^n(x,y), i = 0..n
-    for (i = 0; i < degree + 1; ++i)
+    std::call_once(G_init_flag, [] () -> void
     {
-        // first, compute coefficients of F_i^n in M(n-1, n-1) => nxn coefficient matrix
-        // init F_i_n_powercoeff to zerod (n, n) matrix
-        F_i_n_powercoeff.fill(0.0);
+        uint32_t i, j, k, m;
+        std::vector<PowerPolynomial<degree, R, R> >  B_n_pow;
+        StaticMatrix<degree, degree, R> F_i_n_powercoeff;
 
-        for (k = 1; k < degree + 1; ++k)
-            for (m = 0; m < k; ++m)
-                F_i_n_powercoeff(m, k - 1 - m) += B_n_pow[i][k];
+        // helper polynomials
+        StaticVector<degree+1, BiBernsteinPolynomial<degree-1, degree-1, R, R> > F;
 
-        // now generate F_i^n from the power coefficient matrix F_i_n_powercoeff.
-        F[i].convertFromPowerBasis(F_i_n_powercoeff);
-    }
+        // compute the monomial representation of each i-th Bernstein basis polynom B_i^n(t)
+        B_n_pow.resize(degree+1);
+        for (i = 0; i < degree + 1; ++i)
+            PolyAlg::convertBasis<degree, R>(B_n_pow[i], PolyAlg::computeBernsteinBasisPoly<degree, R, R>(i));
 
-    // compute all bivariate polynomials G_{ij}^n, i, j = 0..n
-    BiBernsteinPolynomial<degree, degree, R, R> B_in_y, B_jn_y;
-    for (i = 0; i < degree + 1; ++i)
-    {
-        for (j = 0; j < degree + 1; ++j)
+        // compute all bivariate polynomials F_i^n(x,y), i = 0..n
+        for (i = 0; i < degree + 1; ++i)
         {
-            B_in_y = PolyAlg::BernsteinConvertToBiPoly<degree, degree, false>::get
-                     (PolyAlg::computeBernsteinBasisPoly<degree, R, R>(i));
-            B_jn_y = PolyAlg::BernsteinConvertToBiPoly<degree, degree, false>::get
-                     (PolyAlg::computeBernsteinBasisPoly<degree, R, R>(j));
+            // first, compute coefficients of F_i^n in M(n-1, n-1) => nxn coefficient matrix
+            // init F_i_n_powercoeff to zerod (n, n) matrix
+            F_i_n_powercoeff.fill(0.0);
+
+            for (k = 1; k < degree + 1; ++k)
+                for (m = 0; m < k; ++m)
+                    F_i_n_powercoeff(m, k - 1 - m) += B_n_pow[i][k];
 
-            // compute coefficient G(i, j)
-            G(i, j) = B_jn_y.multiply(F(i)) - B_in_y.multiply(F(j));
+            // now generate F_i^n from the power coefficient matrix F_i_n_powercoeff.
+            F[i].convertFromPowerBasis(F_i_n_powercoeff);
         }
-    }
+
+        // compute all bivariate polynomials G_{ij}^n, i, j = 0..n
+        BiBernsteinPolynomial<degree, degree, R, R> B_in_y, B_jn_y;
+        for (i = 0; i < degree + 1; ++i)
+        {
+            for (j = 0; j < degree + 1; ++j)
+            {
+                B_in_y = PolyAlg::BernsteinConvertToBiPoly<degree, degree, false>::get
+                         (PolyAlg::computeBernsteinBasisPoly<degree, R, R>(i));
+                B_jn_y = PolyAlg::BernsteinConvertToBiPoly<degree, degree, false>::get
+                         (PolyAlg::computeBernsteinBasisPoly<degree, R, R>(j));
+
+                // compute coefficient G(i, j)
+                G(i, j) = B_jn_y.multiply(F(i)) - B_in_y.multiply(F(j));
+            }
+        }
+    });
 }
 
 template <uint32_t degree, typename R>
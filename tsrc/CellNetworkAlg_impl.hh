@@ -54,7 +54,8 @@ preliminaryPreconditioning(
     CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr>  &C,
     R const                                                                    &alpha,
     R const                                                                    &beta,
-    R const                                                                    &gamma)
+    R const                                                                    &gamma,
+    uint32_t                                                                   nthreads)
 {
     debugl(1, "CellNetwork::preliminaryPreconditioning(): alpha: %2.3f, beta: %2.3f, gamma: %2.3f.\n", alpha, beta, gamma);
     debugTabInc();
@@ -91,46 +92,75 @@ preliminaryPreconditioning(
      *      sum_{i = 0}^k{ (len(m_i) - gamma*maxRadius(m_i))^2 }.
      *
      *  with an initial upper bound nmax, all values n = 2,.., nmax are tested and the value n with minimum quadratic
-     *  error function is chosen.  */
+     *  error function is chosen.
+     *
+     *  the split plans only depend on the respective segment and are computed in parallel with nthreads threads. the
+     *  graph is then modified in a single serial pass in the original order of the segments, so the result does not
+     *  depend on nthreads. */
     typename CellNetworkType::neurite_iterator  u, v;
-    Vec3<R>                                     p_u, p_v;
-    R                                           uv_len, r_u, r_v, rmax;
-    uint32_t                                    k, nmax, m;
-    R                                           k_penalty, n_penalty, ratio;
-    std::vector<std::pair<Vec3<R>, R>>          k_vertex_info, n_vertex_info;
 
+    /* penalty of splitting the segment from (p_u, r_u) to (p_v, r_v) into k segments of equal length with linearly
+     * interpolated radii. the interpolated vertices are evaluated on the fly with the same expressions that are used
+     * for the split itself, hence the penalty is identical to the one of the explicitly constructed vertex list. */
     auto
-    penalty_function = [gamma] (std::vector< std::pair<Vec3<R>, R>> vertices) -> R
+    penalty_function = [gamma] (
+        Vec3<R> const  &p_u,
+        R const        &r_u,
+        Vec3<R> const  &p_v,
+        R const        &r_v,
+        uint32_t        k) -> R
     {
         /* sum individual penalties over all neurite segments.. */
-        uint32_t const  n = vertices.size();
+        Vec3<R> const   dp = p_v - p_u;
+        R const         dr = r_v - r_u;
+        Vec3<R>         x_i, x_next;
+        R               r_i, r_next, ratio;
         R               p, penalty_total = 0, len, rmax;
 
-        for (uint32_t i = 0; n > 0 && i < n - 1; i++) {
-            len             = (vertices[i + 1].first - vertices[i].first).len2();
-            rmax            = std::max(vertices[i+1].second, vertices[i].second);
+        x_i = p_u;
+        r_i = r_u;
+        for (uint32_t m = 1; m <= k; m++) {
+            if (m < k) {
+                ratio   = (R)m / (R)k;
+                x_next  = p_u + dp * ratio;
+                r_next  = r_u + dr * ratio;
+            }
+            else {
+                x_next  = p_v;
+                r_next  = r_v;
+            }
+
+            len             = (x_next - x_i).len2();
+            rmax            = std::max(r_next, r_i);
             p               = (len - gamma * rmax);
             penalty_total  += p*p;
+
+            x_i = x_next;
+            r_i = r_next;
         }
 
         return penalty_total;
     };
 
-    debugTabInc();
-    for (auto &lns : long_neurite_segments) {
-        debugl(2, "handling \"gamma\"-long neurite segment %d\n", lns->id() );
-        debugTabInc();
-
-        uv_len  = lns->getLength();
-        u       = lns->getSourceVertex();
-        v       = lns->getDestinationVertex();
-        p_u     = u->getPosition();
-        p_v     = v->getPosition();
-        r_u     = u->getRadius();
-        r_v     = v->getRadius();
-        rmax    = std::max(r_u, r_v);
+    /* split plan: intermediate vertices of one long neurite segment */
+    std::vector<
+            std::vector<std::pair<Vec3<R>, R>>
+        >                                       split_plans(long_neurite_segments.size());
+    std::vector<
+            typename CellNetworkType::neurite_segment_iterator
+        >                                       split_segments(long_neurite_segments.begin(), long_neurite_segments.end());
 
-        debugl(2, "len: %5.4f, rmax: %5.4f\n", uv_len, rmax);
+    auto
+    plan_split = [&] (size_t i) -> void
+    {
+        auto const  &lns        = split_segments[i];
+        R const      uv_len     = lns->getLength();
+        Vec3<R>      p_u        = lns->getSourceVertex()->getPosition();
+        Vec3<R>      p_v        = lns->getDestinationVertex()->getPosition();
+        R            r_u        = lns->getSourceVertex()->getRadius();
+        R            r_v        = lns->getDestinationVertex()->getRadius();
+        R            rmax       = std::max(r_u, r_v);
+        R            k_penalty, ratio;
 
         /* calculate upper bound: nmax is the minimum number of segments to be created such that the length of one
          * segment falls beneath rmax => 
@@ -140,50 +170,54 @@ preliminaryPreconditioning(
          *  nmax = ceil(uv_len / rmax)
          *
          *  */
-        nmax        = std::ceil(uv_len / rmax);
-        n_penalty   = Aux::Numbers::inf<R>();
+        uint32_t    nmax        = std::ceil(uv_len / rmax);
+        uint32_t    n           = 0;
+        R           n_penalty   = Aux::Numbers::inf<R>();
 
-        debugl(2, "nmax: %d\n", nmax);
-
-        debugl(2, "testing possible values for n..\n");
         /* test all possible values 2, .., nmax */
-        debugTabInc();
-        for (k = 2; k <= nmax; k++) {
-            debugl(3, "testing n = %d.\n", k);
-            /* construct vertex info vector: neurite segment is partitioned into k segments => k + 1 vertices, the first
-             * and last of which are u and v, respectively. */
-            k_vertex_info.resize(k + 1);  
-            k_vertex_info[0] = { p_u, r_u };
-            k_vertex_info[k] = { p_v, r_v };
-
-            for (m = 1; m < k; m++) {
-                ratio = (R)m / (R)k;
-
-                k_vertex_info[m] = {
-                        p_u + (p_v - p_u) * ratio,
-                        r_u + (r_v - r_u) * ratio
-                    };
-            }
-
-            /* calculate penalty */
-            k_penalty = penalty_function(k_vertex_info);
+        for (uint32_t k = 2; k <= nmax; k++) {
+            k_penalty = penalty_function(p_u, r_u, p_v, r_v, k);
             if (k_penalty < n_penalty) {
-                n_penalty       = k_penalty;
-                n_vertex_info   = k_vertex_info;
+                n_penalty   = k_penalty;
+                n           = k;
             }
         }
-        debugTabDec();
 
-        /* value for n has been chosen. split the segment using n_vertex_info, but remove u (front) and v (back) to get
-         * information about intermediate vertices. */
-        n_vertex_info.erase(n_vertex_info.begin());
-        n_vertex_info.pop_back();
+        /* value for n has been chosen. store intermediate vertices, i.e. without u and v. */
+        std::vector<std::pair<Vec3<R>, R>> &n_vertex_info = split_plans[i];
+        for (uint32_t m = 1; m < n; m++) {
+            ratio = (R)m / (R)n;
 
-        C.neurite_segments.split(lns, n_vertex_info);
+            n_vertex_info.push_back( {
+                    p_u + (p_v - p_u) * ratio,
+                    r_u + (r_v - r_u) * ratio
+                } );
+        }
+    };
 
-        debugTabDec();
+    debugl(1, "computing split plans for %zu neurite segments with %d threads..\n", split_segments.size(), nthreads);
+    {
+        Profiling::ScopedStage  plan_stage("preconditioning/split_plan");
+
+        Aux::Parallel::forEachIndex(split_segments.size(), nthreads,
+            [&] (size_t i, uint32_t) -> void { plan_split(i); },
+            "preconditioning worker");
+    }
+
+    debugl(1, "applying split plans..\n");
+    debugTabInc();
+    {
+        Profiling::ScopedStage apply_stage("preconditioning/split_apply");
+
+        for (size_t i = 0; i < split_segments.size(); i++) {
+            debugl(2, "splitting \"gamma\"-long neurite segment %d into %zu segments.\n", split_segments[i]->id(),
+                split_plans[i].size() + 1);
+
+            C.neurite_segments.split(split_segments[i], split_plans[i]);
+        }
     }
     debugTabDec();
+    Profiling::addCounter("preconditioning/split_segments", split_segments.size());
 
     /* greedy neurite segment collapsing with priority queue indexing on reduced neurite segment length */
     PriorityQueue<double, uint32_t>             Q;
@@ -204,6 +238,7 @@ preliminaryPreconditioning(
 
     debugl(1, "performing greedy collapse fixed-point iteration.\n");
     debugTabInc();
+    Profiling::ScopedStage collapse_stage("preconditioning/collapse");
     R           e_len, e_weight;
     uint32_t    e_id;
     bool        fixed_point = false;
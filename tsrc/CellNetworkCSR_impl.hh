@@ -0,0 +1,339 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+template <typename R>
+uint32_t const CellNetworkCSR<R>::invalid_index;
+
+template <typename R>
+CellNetworkCSR<R>::Workspace::Workspace()
+:
+    epoch(0)
+{
+}
+
+template <typename R>
+void
+CellNetworkCSR<R>::Workspace::reset(uint32_t n)
+{
+    if (this->mark.size() != n) {
+        this->mark.assign(n, 0);
+        this->epoch = 0;
+    }
+
+    /* on overflow of the epoch counter, all marks have to be cleared once */
+    if (++this->epoch == 0) {
+        std::fill(this->mark.begin(), this->mark.end(), 0);
+        this->epoch = 1;
+    }
+    this->items.clear();
+}
+
+template <typename R>
+CellNetworkCSR<R>::CellNetworkCSR()
+:
+    out_offsets(1, 0),
+    in_offsets(1, 0)
+{
+}
+
+template <typename R>
+CellNetworkCSR<R>::CellNetworkCSR(
+    std::vector<Vertex>    &&vertices,
+    std::vector<Edge>      &&edges)
+:
+    vertices(std::move(vertices)),
+    edges(std::move(edges))
+{
+    uint32_t const n = this->vertices.size();
+    uint32_t const m = this->edges.size();
+
+    /* counting sort of edge indices by source / destination vertex. edges are processed in ascending index order,
+     * hence the adjacency lists of all vertices are sorted by ascending edge id. */
+    this->out_offsets.assign(n + 1, 0);
+    this->in_offsets.assign(n + 1, 0);
+    for (auto &e : this->edges) {
+        if (e.src >= n || e.dst >= n) {
+            throw("CellNetworkCSR::CellNetworkCSR(): edge endpoint out of range.");
+        }
+        this->out_offsets[e.src + 1]++;
+        this->in_offsets[e.dst + 1]++;
+    }
+    std::partial_sum(this->out_offsets.begin(), this->out_offsets.end(), this->out_offsets.begin());
+    std::partial_sum(this->in_offsets.begin(), this->in_offsets.end(), this->in_offsets.begin());
+
+    std::vector<uint32_t> out_pos(this->out_offsets.begin(), this->out_offsets.end() - 1);
+    std::vector<uint32_t> in_pos(this->in_offsets.begin(), this->in_offsets.end() - 1);
+
+    this->out_edges.resize(m);
+    this->in_edges.resize(m);
+    for (uint32_t e = 0; e < m; e++) {
+        this->out_edges[out_pos[this->edges[e].src]++]  = e;
+        this->in_edges[in_pos[this->edges[e].dst]++]    = e;
+    }
+}
+
+template <typename R>
+uint32_t
+CellNetworkCSR<R>::numVertices() const
+{
+    return this->vertices.size();
+}
+
+template <typename R>
+uint32_t
+CellNetworkCSR<R>::numEdges() const
+{
+    return this->edges.size();
+}
+
+template <typename R>
+typename CellNetworkCSR<R>::Vertex const &
+CellNetworkCSR<R>::vertex(uint32_t v) const
+{
+    return this->vertices[v];
+}
+
+template <typename R>
+typename CellNetworkCSR<R>::Edge const &
+CellNetworkCSR<R>::edge(uint32_t e) const
+{
+    return this->edges[e];
+}
+
+template <typename R>
+uint32_t
+CellNetworkCSR<R>::getVertexIndex(uint32_t id) const
+{
+    auto it = std::lower_bound(
+            this->vertices.begin(),
+            this->vertices.end(),
+            id,
+            [] (Vertex const &v, uint32_t id) -> bool
+            {
+                return (v.id < id);
+            });
+
+    if (it != this->vertices.end() && it->id == id) {
+        return (it - this->vertices.begin());
+    }
+    else {
+        return invalid_index;
+    }
+}
+
+template <typename R>
+uint32_t
+CellNetworkCSR<R>::getOutDegree(uint32_t v) const
+{
+    return (this->out_offsets[v + 1] - this->out_offsets[v]);
+}
+
+template <typename R>
+uint32_t
+CellNetworkCSR<R>::getInDegree(uint32_t v) const
+{
+    return (this->in_offsets[v + 1] - this->in_offsets[v]);
+}
+
+template <typename R>
+template <typename VertexPred, typename EdgePred, typename F>
+void
+CellNetworkCSR<R>::forEachNeighbour(
+    uint32_t                v,
+    bool                    directed,
+    VertexPred const       &vertex_pred,
+    EdgePred const         &edge_pred,
+    F const                &f) const
+{
+    for (uint32_t k = this->out_offsets[v]; k < this->out_offsets[v + 1]; k++) {
+        uint32_t const e    = this->out_edges[k];
+        uint32_t const nb   = this->edges[e].dst;
+        if (edge_pred(e) && vertex_pred(nb)) {
+            f(nb, e);
+        }
+    }
+
+    if (!directed) {
+        for (uint32_t k = this->in_offsets[v]; k < this->in_offsets[v + 1]; k++) {
+            uint32_t const e    = this->in_edges[k];
+            uint32_t const nb   = this->edges[e].src;
+            if (edge_pred(e) && vertex_pred(nb)) {
+                f(nb, e);
+            }
+        }
+    }
+}
+
+template <typename R>
+template <typename VertexPred, typename EdgePred, typename Visitor>
+void
+CellNetworkCSR<R>::traverseBreadthFirst(
+    uint32_t                start,
+    bool                    directed,
+    VertexPred const       &vertex_pred,
+    EdgePred const         &edge_pred,
+    Visitor const          &visit,
+    Workspace              &ws) const
+{
+    typedef typename Workspace::Item Item;
+
+    ws.reset(this->vertices.size());
+
+    /* items serves as queue: all enqueued items stay in the vector, head is the index of the front item */
+    ws.items.push_back({ start, 0, 0 });
+    ws.mark[start] = ws.epoch;
+
+    for (size_t head = 0; head < ws.items.size(); head++) {
+        Item const x = ws.items[head];
+        if (!visit(x.v, x.depth, x.dist)) {
+            break;
+        }
+
+        this->forEachNeighbour(x.v, directed, vertex_pred, edge_pred,
+            [this, &ws, &x] (uint32_t nb, uint32_t e) -> void
+            {
+                if (ws.mark[nb] != ws.epoch) {
+                    ws.mark[nb] = ws.epoch;
+                    ws.items.push_back({ nb, x.depth + 1, x.dist + this->edges[e].length });
+                }
+            });
+    }
+}
+
+template <typename R>
+template <typename VertexPred, typename EdgePred, typename Visitor>
+void
+CellNetworkCSR<R>::traverseDepthFirst(
+    uint32_t                start,
+    bool                    directed,
+    VertexPred const       &vertex_pred,
+    EdgePred const         &edge_pred,
+    Visitor const          &visit,
+    Workspace              &ws) const
+{
+    typedef typename Workspace::Item Item;
+
+    ws.reset(this->vertices.size());
+
+    /* items serves as stack. vertices are marked when visited, not when pushed, so that the visiting order is a proper
+     * depth-first pre-order even in the presence of cycles. */
+    ws.items.push_back({ start, 0, 0 });
+
+    while (!ws.items.empty()) {
+        Item const x = ws.items.back();
+        ws.items.pop_back();
+
+        if (ws.mark[x.v] == ws.epoch) {
+            continue;
+        }
+        ws.mark[x.v] = ws.epoch;
+
+        if (!visit(x.v, x.depth, x.dist)) {
+            break;
+        }
+
+        /* push unvisited neighbours, then reverse them so that they are popped in ascending edge id order */
+        size_t const top = ws.items.size();
+        this->forEachNeighbour(x.v, directed, vertex_pred, edge_pred,
+            [this, &ws, &x] (uint32_t nb, uint32_t e) -> void
+            {
+                if (ws.mark[nb] != ws.epoch) {
+                    ws.items.push_back({ nb, x.depth + 1, x.dist + this->edges[e].length });
+                }
+            });
+        std::reverse(ws.items.begin() + top, ws.items.end());
+    }
+}
+
+template <typename R>
+template <typename VertexPred, typename EdgePred>
+std::pair<uint32_t, R>
+CellNetworkCSR<R>::getSubTreeDepths(
+    uint32_t                root,
+    VertexPred const       &vertex_pred,
+    EdgePred const         &edge_pred,
+    Workspace              &ws) const
+{
+    uint32_t    integral_depth  = 0;
+    R           chord_depth     = 0;
+
+    this->traverseBreadthFirst(root, true, vertex_pred, edge_pred,
+        [&integral_depth, &chord_depth] (uint32_t v, uint32_t depth, R dist) -> bool
+        {
+            integral_depth  = std::max(integral_depth, depth);
+            chord_depth     = std::max(chord_depth, dist);
+            return true;
+        },
+        ws);
+
+    return std::pair<uint32_t, R>(integral_depth, chord_depth);
+}
+
+template <typename R>
+template <typename VertexPred, typename EdgePred>
+std::pair<uint32_t, R>
+CellNetworkCSR<R>::getFarthestVertex(
+    uint32_t                start,
+    VertexPred const       &vertex_pred,
+    EdgePred const         &edge_pred,
+    Workspace              &ws) const
+{
+    std::pair<uint32_t, R> farthest(start, -Aux::Numbers::inf<R>());
+
+    this->traverseBreadthFirst(start, false, vertex_pred, edge_pred,
+        [&farthest] (uint32_t v, uint32_t depth, R dist) -> bool
+        {
+            if (dist > farthest.second) {
+                farthest = { v, dist };
+            }
+            return true;
+        },
+        ws);
+
+    return farthest;
+}
@@ -271,12 +271,12 @@ R
 CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
 NeuronVertex::getSectionMinRadius() const
 {
-    R max_r = -Aux::Numbers::inf<R>();
+    R min_r = Aux::Numbers::inf<R>();
 
     for (auto &s : this->sections) {
-        max_r = std::max(max_r, s.getRadius());
+        min_r = std::min(min_r, s.radius());
     }
-    return max_r;
+    return min_r;
 }
 
 template <
@@ -287,12 +287,12 @@ R
 CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
 NeuronVertex::getSectionMaxRadius() const
 {
-    R min_r = Aux::Numbers::inf<R>();
+    R max_r = -Aux::Numbers::inf<R>();
 
     for (auto &s : this->sections) {
-        min_r = std::min(min_r, s.getRadius());
+        max_r = std::max(max_r, s.radius());
     }
-    return min_r;
+    return max_r;
 }
 
 template <
@@ -306,7 +306,7 @@ NeuronVertex::getSectionPositionCentroid() const
     Vec3<R> sum(0, 0, 0);
 
     for (auto &s : this->sections) {
-        sum += s.getPosition();
+        sum += s.position();
     }
     return (sum / (R)(this->sections.size()));
 }
@@ -387,7 +387,7 @@ CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
 NeuronVertex::translate(Vec3<R> const &d)
 {
     for (auto &c : this->sections) {
-        c = CellSection(c.getCompartmentId(), c.getPosition() += d, c.getRadius());
+        c.position() += d;
     }
 }
 
@@ -400,7 +400,7 @@ CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
 NeuronVertex::scale(R const &x)
 {
     for (auto &c : this->sections) {
-        c = CellSection(c.getCompartmentId(), c.getPosition(), c.getRadius() * x);
+        c.radius() *= x;
     }
 }
 
@@ -4831,7 +4831,16 @@ template <
     typename Tn, typename Tv, typename Te, typename Tso, typename Tnv, typename Tax, typename Tde,
     typename Tns, typename Tas, typename Tds, typename Tnr, typename Tar, typename Tdr, typename R
 >
-template <typename VertexType, typename EdgeType>
+template <
+    typename VertexType,
+    typename EdgeType,
+    typename VertexPred,
+    typename EdgePred,
+    typename VertexSelectionPred,
+    typename EdgeSelectionPred,
+    typename VertexTerminationPred,
+    typename EdgeTerminationPred
+>
 void
 CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
 traverseBreadthFirst(
@@ -4846,12 +4855,12 @@ traverseBreadthFirst(
             >
         >                                              &reachable_vertices_info,
     std::list<EdgeType *>                              &reachable_edges,
-    std::function<bool(NeuronVertex const &v)> const   &vertex_pred,
-    std::function<bool(NeuronEdge const &e)> const     &edge_pred,
-    std::function<bool(VertexType const &v)> const     &vertex_selection_pred,
-    std::function<bool(EdgeType const &e)> const       &edge_selection_pred,
-    std::function<bool(VertexType const &v)> const     &vertex_termination_pred,
-    std::function<bool(EdgeType const &e)> const       &edge_termination_pred,
+    VertexPred const                                   &vertex_pred,
+    EdgePred const                                     &edge_pred,
+    VertexSelectionPred const                          &vertex_selection_pred,
+    EdgeSelectionPred const                            &edge_selection_pred,
+    VertexTerminationPred const                        &vertex_termination_pred,
+    EdgeTerminationPred const                          &edge_termination_pred,
     int32_t                                             tid_arg)
 {
     debugl(1, "CellNetwork::getConnectedComponent(): starting %s traversal from node %2d.\n",
@@ -4859,7 +4868,8 @@ traverseBreadthFirst(
     debugTabInc();
 
     /* queue consisting of tuples (iterator, path, distance), where iterator identifies the currently visited vertex v,
-     * path is path from vstart to v encoded as a list of NeuronVertex pointers and dist is the d(vstart, v) */
+     * path is path from vstart to v encoded as a list of NeuronVertex pointers and dist is the d(vstart, v). paths are
+     * left empty if return_paths is false, since copying them dominates the traversal of deep trees. */
     std::list<
             std::tuple<
                 neuron_iterator,
@@ -4902,7 +4912,7 @@ traverseBreadthFirst(
     while (!Q.empty()) {
         /* extract info and dequeue front() tuple */
         v_it    = std::get<0>(Q.front());
-        v_path  = std::get<1>(Q.front());
+        v_path.swap(std::get<1>(Q.front()));
         v_dist  = std::get<2>(Q.front());
         Q.pop_front();
 
@@ -4972,19 +4982,21 @@ traverseBreadthFirst(
                     }
                 }
 
-                /* extent path to v to get path to neighbour */
-                std::list<NeuronVertex *> nb_path = v_path;
-                nb_path.push_back(&(*nb_it));
-
                 /* calculate distance to neighbour */
                 nb_dist = v_dist + e->getLength();
 
-                /* if neighbour has not been traversed yet, enqueue it */
+                /* if neighbour has not been traversed yet, enqueue it. if desired, extend path to v to get path to
+                 * neighbour. */
                 if (nb_it->getTraversalState(tid) == this->TRAV_UNSEEN) {
                     Q.push_back(
                         std::tuple<neuron_iterator, std::list<NeuronVertex *>, R>
-                            (nb_it, nb_path, nb_dist)
+                            (nb_it, {}, nb_dist)
                         );
+
+                    if (return_paths) {
+                        std::get<1>(Q.back()) = v_path;
+                        std::get<1>(Q.back()).push_back(&(*nb_it));
+                    }
                 }
             }
         }
@@ -5014,14 +5026,17 @@ traverseBreadthFirst(
                         }
                     }
 
-                    std::list<NeuronVertex *> nb_path = v_path;
-                    nb_path.push_back(&(*nb_it));
                     nb_dist = v_dist + e->getLength();
                     if (nb_it->getTraversalState(tid) == this->TRAV_UNSEEN) {
                         Q.push_back(
                             std::tuple<neuron_iterator, std::list<NeuronVertex *>, R>
-                                (nb_it, nb_path, nb_dist)
+                                (nb_it, {}, nb_dist)
                             );
+
+                        if (return_paths) {
+                            std::get<1>(Q.back()) = v_path;
+                            std::get<1>(Q.back()).push_back(&(*nb_it));
+                        }
                     }
                 }
             }
@@ -5036,6 +5051,104 @@ traverseBreadthFirst(
         (directed) ? "directed" : "undirected", vstart_it->id());
 }
 
+template <
+    typename Tn, typename Tv, typename Te, typename Tso, typename Tnv, typename Tax, typename Tde,
+    typename Tns, typename Tas, typename Tds, typename Tnr, typename Tar, typename Tdr, typename R
+>
+template <typename VertexType, typename EdgeType>
+void
+CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
+traverseBreadthFirst(
+    neuron_iterator                                     vstart_it,
+    bool const                                         &directed,
+    bool const                                         &return_paths,
+    std::list<
+            std::tuple<
+                VertexType *,
+                std::list<NeuronVertex *>,
+                R
+            >
+        >                                              &reachable_vertices_info,
+    std::list<EdgeType *>                              &reachable_edges,
+    std::function<bool(NeuronVertex const &v)> const   &vertex_pred,
+    std::function<bool(NeuronEdge const &e)> const     &edge_pred,
+    std::function<bool(VertexType const &v)> const     &vertex_selection_pred,
+    std::function<bool(EdgeType const &e)> const       &edge_selection_pred,
+    std::function<bool(VertexType const &v)> const     &vertex_termination_pred,
+    std::function<bool(EdgeType const &e)> const       &edge_termination_pred,
+    int32_t                                             tid_arg)
+{
+    this->template traverseBreadthFirst<
+            VertexType,
+            EdgeType,
+            std::function<bool(NeuronVertex const &v)>,
+            std::function<bool(NeuronEdge const &e)>,
+            std::function<bool(VertexType const &v)>,
+            std::function<bool(EdgeType const &e)>,
+            std::function<bool(VertexType const &v)>,
+            std::function<bool(EdgeType const &e)>
+        >(
+            vstart_it,
+            directed,
+            return_paths,
+            reachable_vertices_info,
+            reachable_edges,
+            vertex_pred,
+            edge_pred,
+            vertex_selection_pred,
+            edge_selection_pred,
+            vertex_termination_pred,
+            edge_termination_pred,
+            tid_arg);
+}
+
+template <
+    typename Tn, typename Tv, typename Te, typename Tso, typename Tnv, typename Tax, typename Tde,
+    typename Tns, typename Tas, typename Tds, typename Tnr, typename Tar, typename Tdr, typename R
+>
+CellNetworkCSR<R>
+CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
+getCSRSnapshot() const
+{
+    typedef typename CellNetworkCSR<R>::Vertex  CSRVertex;
+    typedef typename CellNetworkCSR<R>::Edge    CSREdge;
+
+    std::vector<CSRVertex>  vertices;
+    std::vector<CSREdge>    edges;
+
+    vertices.reserve(this->neuron_vertices.size());
+    edges.reserve(this->neuron_edges.size());
+
+    /* neuron vertices / edges are iterated in ascending id order, as required by the CellNetworkCSR constructor. */
+    for (auto &v : this->neuron_vertices) {
+        vertices.push_back({ v.id(), (uint32_t)v.getType(), v.getSinglePointPosition() });
+    }
+
+    /* vertices are sorted by id, the index of an endpoint can hence be found by binary search */
+    auto index = [&vertices] (uint32_t id) -> uint32_t
+        {
+            return std::lower_bound(
+                    vertices.begin(),
+                    vertices.end(),
+                    id,
+                    [] (CSRVertex const &v, uint32_t id) -> bool
+                    {
+                        return (v.id < id);
+                    }) - vertices.begin();
+        };
+
+    for (auto &e : this->neuron_edges) {
+        edges.push_back({
+            e.id(),
+            (uint32_t)e.getType(),
+            index(e.getSourceVertex()->id()),
+            index(e.getDestinationVertex()->id()),
+            e.getLength() });
+    }
+
+    return CellNetworkCSR<R>(std::move(vertices), std::move(edges));
+}
+
 template <
     typename Tn, typename Tv, typename Te, typename Tso, typename Tnv, typename Tax, typename Tde,
     typename Tns, typename Tas, typename Tds, typename Tnr, typename Tar, typename Tdr, typename R
@@ -5046,43 +5159,33 @@ getNeuriteSubTreeDepths(neurite_iterator n_it)
 {
     /* compute depth from directed traversal of sub-tree rooted in n_it. first, retrieve all reachable neurite leafs
      * along with paths to them. then the depth is given as the number of edges in the longest returned path. */
-    auto neurite_vertex_pred    = std::function<bool(NeuronVertex const &v)>(
-            [] (NeuronVertex const &v) -> bool
-            {
-                return (v.getType() == SOMA_VERTEX ||
-                        v.getType() == AXON_VERTEX ||
-                        v.getType() == DENDRITE_VERTEX);
-            }
-        );
+    auto neurite_vertex_pred    = [] (NeuronVertex const &v) -> bool
+        {
+            return (v.getType() == SOMA_VERTEX ||
+                    v.getType() == AXON_VERTEX ||
+                    v.getType() == DENDRITE_VERTEX);
+        };
 
-    auto neurite_segment_pred   = std::function<bool(NeuronEdge const &e)>(
-            [] (NeuronEdge const &e) -> bool
-            {
-                return (e.getType() == AXON_SEGMENT ||
-                        e.getType() == DENDRITE_SEGMENT);
-            }
-        );
+    auto neurite_segment_pred   = [] (NeuronEdge const &e) -> bool
+        {
+            return (e.getType() == AXON_SEGMENT ||
+                    e.getType() == DENDRITE_SEGMENT);
+        };
 
-    auto neurite_leaf_pred      = std::function<bool(NeuriteVertex const &v)>(
-            [] (NeuriteVertex const &v) -> bool
-            {
-                return (v.template getFilteredOutNeighbours<NeuriteVertex>().size() == 0);
-            }
-        );
+    auto neurite_leaf_pred      = [] (NeuriteVertex const &v) -> bool
+        {
+            return (v.template getFilteredOutNeighbours<NeuriteVertex>().size() == 0);
+        };
 
-    auto vertex_false_pred      = std::function<bool(NeuriteVertex const &v)>(
-            [] (NeuriteVertex const &v) -> bool
-            {
-                return false;
-            }
-        );
+    auto vertex_false_pred      = [] (NeuriteVertex const &v) -> bool
+        {
+            return false;
+        };
 
-    auto edge_false_pred        = std::function<bool(NeuriteSegment const &e)>(
-            [] (NeuriteSegment const &e) -> bool
-            {
-                return false;
-            }
-        );
+    auto edge_false_pred        = [] (NeuriteSegment const &e) -> bool
+        {
+            return false;
+        };
 
     std::list<std::tuple<NeuriteVertex *, std::list<NeuronVertex *>, R>>    reachable_vertices_info;
     std::list<NeuriteSegment *>                                             reachable_edges;
@@ -5136,41 +5239,31 @@ getDirectedPath(
     std::list<NeuronVertex *>  &path,
     R                          &pathlen)
 {
-    auto neuron_vertex_true_pred    = std::function<bool(NeuronVertex const &v)>(
-            [] (NeuronVertex const &v) -> bool
-            {
-                return true;
-            }
-        );
+    auto neuron_vertex_true_pred    = [] (NeuronVertex const &v) -> bool
+        {
+            return true;
+        };
 
-    auto neuron_vertex_false_pred   = std::function<bool(NeuronVertex const &v)>(
-            [] (NeuronVertex const &v) -> bool
-            {
-                return false;
-            }
-        );
+    auto neuron_vertex_false_pred   = [] (NeuronVertex const &v) -> bool
+        {
+            return false;
+        };
 
-    auto neuron_edge_true_pred  = std::function<bool(NeuronEdge const &e)>(
-            [] (NeuronEdge const &e) -> bool
-            {
-                return true;
-            }
-        );
+    auto neuron_edge_true_pred  = [] (NeuronEdge const &e) -> bool
+        {
+            return true;
+        };
     
-    auto neuron_edge_false_pred = std::function<bool(NeuronEdge const &e)>(
-            [] (NeuronEdge const &e) -> bool
-            {
-                return false;
-            }
-        );
+    auto neuron_edge_false_pred = [] (NeuronEdge const &e) -> bool
+        {
+            return false;
+        };
 
 
-    auto v_pred                     = std::function<bool(NeuronVertex const &v)> (
-            [u_it] (NeuronVertex const &v) -> bool
-            {
-                return (neuron_const_iterator(u_it) == v.iterator());
-            }
-        );
+    auto v_pred                     = [u_it] (NeuronVertex const &v) -> bool
+        {
+            return (neuron_const_iterator(u_it) == v.iterator());
+        };
 
     std::list<std::tuple<NeuronVertex *, std::list<NeuronVertex *>, R>>     reachable_vertices_info;
     std::list<NeuronEdge *>                                                 reachable_edges;
@@ -5214,47 +5307,35 @@ getNeuriteConnectedComponent(
     std::list<NeuriteVertex *>     &reachable_neurite_vertices,
     std::list<NeuriteSegment *>    &reachable_neurite_segments)
 {
-    auto neurite_vertex_pred        = std::function<bool(NeuronVertex const &v)>(
-            [] (NeuronVertex const &v) -> bool
-            {
-                return (v.getType() == AXON_VERTEX || v.getType() == DENDRITE_VERTEX);
-            }
-        );
+    auto neurite_vertex_pred        = [] (NeuronVertex const &v) -> bool
+        {
+            return (v.getType() == AXON_VERTEX || v.getType() == DENDRITE_VERTEX);
+        };
 
-    auto neurite_segment_pred       = std::function<bool(NeuronEdge const &e)>(
-            [] (NeuronEdge const &e) -> bool
-            {
-                return (e.getType() == AXON_SEGMENT || e.getType() == DENDRITE_SEGMENT);
-            }
-        );
+    auto neurite_segment_pred       = [] (NeuronEdge const &e) -> bool
+        {
+            return (e.getType() == AXON_SEGMENT || e.getType() == DENDRITE_SEGMENT);
+        };
 
-    auto neurite_segment_true_pred  = std::function<bool(NeuriteSegment const &e)>(
-            [] (NeuriteSegment const &e) -> bool
-            {
-                return true;
-            }
-        );
+    auto neurite_segment_true_pred  = [] (NeuriteSegment const &e) -> bool
+        {
+            return true;
+        };
 
-    auto neurite_segment_false_pred = std::function<bool(NeuriteSegment const &e)>(
-            [] (NeuriteSegment const &e) -> bool
-            {
-                return false;
-            }
-        );
+    auto neurite_segment_false_pred = [] (NeuriteSegment const &e) -> bool
+        {
+            return false;
+        };
 
-    auto neurite_vertex_true_pred   = std::function<bool(NeuriteVertex const &v)>(
-            [] (NeuriteVertex const &v) -> bool
-            {
-                return true;
-            }
-        );
+    auto neurite_vertex_true_pred   = [] (NeuriteVertex const &v) -> bool
+        {
+            return true;
+        };
 
-    auto neurite_vertex_false_pred  = std::function<bool(NeuriteVertex const &v)>(
-            [] (NeuriteVertex const &v) -> bool
-            {
-                return false;
-            }
-        );
+    auto neurite_vertex_false_pred  = [] (NeuriteVertex const &v) -> bool
+        {
+            return false;
+        };
     
 
     std::list<std::tuple<NeuriteVertex *, std::list<NeuronVertex *>, R>>    reachable_vertices_info;
@@ -5304,6 +5385,12 @@ computeStatistics() const
         stat.neuron_vertices_dist_avg,
         stat.neuron_vertices_dist_sigma);
 
+    this->getNeuronVerticesNearestNeighbourStat(
+        stat.neuron_vertices_nn_dist_min,
+        stat.neuron_vertices_nn_dist_max,
+        stat.neuron_vertices_nn_dist_avg,
+        stat.neuron_vertices_nn_dist_sigma);
+
     this->getNeuronVerticesCoordinateStat(
         stat.neuron_vertices_xmin,
         stat.neuron_vertices_xmax,
@@ -5373,127 +5460,134 @@ getMorphologicalDiameter(soma_iterator s_it)
      * with this restriction in place, the morphological diameter of the cell with the given soma is simply the diameter
      * of the soma / neurite vertex sub-tree, i.e. the longest path between any two vertices in said tree. */
 
-    /* find diameter of cell rooted in soma referred to by soma_it */
-    auto cell_vertex_pred   = std::function<bool(NeuronVertex const &v)>(
-            [] (NeuronVertex const &v) -> bool
-            {
-                return (v.getType() == SOMA_VERTEX ||
-                        v.getType() == AXON_VERTEX ||
-                        v.getType() == DENDRITE_VERTEX);
-            }
-        );
+    /* find diameter of cell rooted in soma referred to by soma_it on a CSR snapshot of the network */
+    CellNetworkCSR<R> const                     csr = this->getCSRSnapshot();
+    typename CellNetworkCSR<R>::Workspace       ws;
 
-    auto cell_edge_pred     = std::function<bool(NeuronEdge const &e)>(
-            [] (NeuronEdge const &e) -> bool
-            {
-                return (e.getType() == AXON_ROOT_EDGE ||
-                        e.getType() == DENDRITE_ROOT_EDGE ||
-                        e.getType() == AXON_SEGMENT ||
-                        e.getType() == DENDRITE_SEGMENT);
-            }
-        );
+    auto cell_vertex_pred   = [&csr] (uint32_t v) -> bool
+        {
+            uint32_t const t = csr.vertex(v).type;
+            return (t == SOMA_VERTEX || t == AXON_VERTEX || t == DENDRITE_VERTEX);
+        };
 
-    auto neuron_vertex_true_pred    = std::function<bool(NeuronVertex const &v)>(
-            [] (NeuronVertex const &v) -> bool
-            {
-                return true;
-            }
-        );
+    auto cell_edge_pred     = [&csr] (uint32_t e) -> bool
+        {
+            uint32_t const t = csr.edge(e).type;
+            return (t == AXON_ROOT_EDGE || t == DENDRITE_ROOT_EDGE || t == AXON_SEGMENT || t == DENDRITE_SEGMENT);
+        };
 
-    auto neuron_vertex_false_pred   = std::function<bool(NeuronVertex const &v)>(
-            [] (NeuronVertex const &v) -> bool
-            {
-                return false;
-            }
-        );
+    /* find vertex u of maximum distance to s */
+    uint32_t const          s_idx   = csr.getVertexIndex(s_it->id());
+    std::pair<uint32_t, R>  su      = csr.getFarthestVertex(s_idx, cell_vertex_pred, cell_edge_pred, ws);
+    debugl(1, "neuron vertex of maximum distance to soma s (%d): vertex u (%d) with d(s,u) %10.5f\n", s_it->id(),
+        csr.vertex(su.first).id, su.second);
 
-    auto neuron_edge_true_pred  = std::function<bool(NeuronEdge const &e)>(
-            [] (NeuronEdge const &e) -> bool
-            {
-                return true;
-            }
-        );
-    
-    auto neuron_edge_false_pred = std::function<bool(NeuronEdge const &e)>(
-            [] (NeuronEdge const &e) -> bool
-            {
-                return false;
-            }
-        );
+    /* start traversal from u, find vertex v of maximum distance to u. d(u, v) is the diameter of the cell tree, i.e.
+     * the morphological diameter of the cell rooted in s */
+    std::pair<uint32_t, R>  uv      = csr.getFarthestVertex(su.first, cell_vertex_pred, cell_edge_pred, ws);
+    debugl(1, "neuron vertex of maximum distance to u (%d): vertex v(%d) with d(u, v) = %10.5f\n",
+        csr.vertex(su.first).id, csr.vertex(uv.first).id, uv.second);
+    debugl(1, "<=> diameter of cell tree, i.e. the morphological diameter, is %10.5f\n", uv.second);
 
-    std::list<std::tuple<NeuronVertex *, std::list<NeuronVertex *>, R>> reachable_vertices_info;
-    std::list<NeuronEdge *>                                             reachable_edges;
+    debugTabDec();
+    debugl(1, "CellNetwork::getMorphologicalDiameter(): done.\n");
 
-    this->traverseBreadthFirst<NeuronVertex, NeuronEdge>(
-        /* start traversal from soma s */
-        s_it,
-        /* undirected traversal, don't return paths */
-        false, false,
-        /* addresses of return lists */
-        reachable_vertices_info, reachable_edges,
-        /* predicates for cell veritces / edges */
-        cell_vertex_pred, cell_edge_pred,
-        /* trivial selection predicates always returning true */
-        neuron_vertex_true_pred, neuron_edge_true_pred,
-        /* trivial termination predicates always returning false */
-        neuron_vertex_false_pred, neuron_edge_false_pred);
+    return uv.second;
+}
 
-    debugl(1, "reachable_vertices_info.size(): %zu.\n", reachable_vertices_info.size());
-    debugl(1, "reachable_edges.size(): %zu.\n", reachable_edges.size());
+template <
+    typename Tn, typename Tv, typename Te, typename Tso, typename Tnv, typename Tax, typename Tde,
+    typename Tns, typename Tas, typename Tds, typename Tnr, typename Tar, typename Tdr, typename R
+>
+void
+CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
+getNeuronVerticesDistanceStat(
+    R  &v_dist_min,
+    R  &v_dist_max,
+    R  &v_dist_avg,
+    R  &v_dist_sigma) const
+{
+    /* statistics of the distances of all n(n-1)/2 pairs of neuron vertices without storing them: minimum and
+     * maximum are the closest / farthest pair found with a k-d tree in O(n log n). average and standard deviation
+     * are accumulated over all pairs for up to exact_max_vertices vertices, and estimated from sample_npairs
+     * uniformly drawn pairs beyond that, in blocks of exact_max_vertices samples. the sample is drawn with a fixed
+     * seed, the result is thus reproducible. */
+    static uint32_t const   exact_max_vertices  = 4096;
+    static uint32_t const   sample_npairs       = 1u << 22;
 
-    if (!reachable_vertices_info.empty()) {
-        /* find vertex u of maximum distance to s */
-        R               su_dist = -Aux::Numbers::inf<R>();
-        neuron_iterator u_it;
+    std::vector<Vec3<R>> p;
+    p.reserve(this->neuron_vertices.size());
+    for (auto &v : this->neuron_vertices) {
+        p.push_back(v.getSinglePointPosition());
+    }
 
-        for (auto &vi_tuple : reachable_vertices_info) {
-            if (std::get<2>(vi_tuple) > su_dist) {
-                su_dist = std::get<2>(vi_tuple);
-                u_it    = std::get<0>(vi_tuple)->iterator();
+    uint32_t const n = p.size();
+    if (n < 2) {
+        v_dist_min      = Aux::Numbers::inf<R>();
+        v_dist_max      = -Aux::Numbers::inf<R>();
+        v_dist_avg      = std::numeric_limits<R>::quiet_NaN();
+        v_dist_sigma    = std::numeric_limits<R>::quiet_NaN();
+        return;
+    }
+
+    KdTree<R> T(p);
+    v_dist_min = std::sqrt(T.closestPairDistance2());
+    v_dist_max = std::sqrt(T.farthestPairDistance2());
+
+    /* sums of shifted distances d - K and their squares, where K is the average distance of the first vertex to all
+     * others. shifting avoids cancellation when computing the variance from the sums. every row (block of samples)
+     * is summed separately before being added to the totals to limit the accumulation of rounding errors. */
+    R K = 0;
+    for (uint32_t j = 1; j < n; j++) {
+        K += (p[j] - p[0]).len2();
+    }
+    K /= (R)(n - 1);
+
+    R sum = 0, sum_sq = 0, npairs;
+    if (n <= exact_max_vertices) {
+        for (uint32_t i = 0; i < n; i++) {
+            R row_sum = 0, row_sum_sq = 0;
+            for (uint32_t j = i + 1; j < n; j++) {
+                R const x   = (p[j] - p[i]).len2() - K;
+                row_sum    += x;
+                row_sum_sq += x * x;
             }
+            sum    += row_sum;
+            sum_sq += row_sum_sq;
         }
-        debugl(1, "neuron vertex of maximum distance to soma s (%d): vertex u (%d) with d(s,u) %10.5f\n", s_it->id(), u_it->id(), su_dist);
-
-        /* start traversal from u, find vertex v of maximum distance to u. d(u, v) is the diameter of the cell tree, i.e.
-         * the morphological diameter of the cell rooted in s */
-        reachable_vertices_info.clear();
-        reachable_edges.clear();
-        this->traverseBreadthFirst<NeuronVertex, NeuronEdge>(
-            /* start traversal from soma iterator sit */
-            u_it,
-            /* undirected traversal, don't return paths */
-            false, false,
-            /* addresses of return lists */
-            reachable_vertices_info, reachable_edges,
-            /* predicates for cell veritces / edges */
-            cell_vertex_pred, cell_edge_pred,
-            /* trivial selection predicates always returning true */
-            neuron_vertex_true_pred, neuron_edge_true_pred,
-            /* trivial termination predicates always returning false */
-            neuron_vertex_false_pred, neuron_edge_false_pred);
-
-        /* find vertex u of maximum distance to s */
-        R               uv_dist = -Aux::Numbers::inf<R>();
-        neuron_iterator v_it;
+        npairs = (R)n * ((R)n - 1.0) / 2.0;
+    }
+    else {
+        /* i uniform in [0, n), j uniform in [0, n) \ {i}, which gives every unordered pair the same probability. the
+         * standard error of the average is v_dist_sigma / 2048, i.e. about 0.05% of the standard deviation. */
+        std::mt19937                            rng(n);
+        std::uniform_int_distribution<uint32_t> first(0, n - 1), second(0, n - 2);
+
+        for (uint32_t k = 0; k < sample_npairs; k += exact_max_vertices) {
+            R block_sum = 0, block_sum_sq = 0;
+            for (uint32_t l = 0; l < exact_max_vertices; l++) {
+                uint32_t const i = first(rng);
+                uint32_t       j = second(rng);
+                if (j >= i) {
+                    j++;
+                }
 
-        for (auto &vi_tuple : reachable_vertices_info) {
-            if (std::get<2>(vi_tuple) > uv_dist) {
-                uv_dist = std::get<2>(vi_tuple);
-                v_it    = std::get<0>(vi_tuple)->iterator();
+                R const x       = (p[j] - p[i]).len2() - K;
+                block_sum      += x;
+                block_sum_sq   += x * x;
             }
+            sum    += block_sum;
+            sum_sq += block_sum_sq;
         }
-        debugl(1, "neuron vertex of maximum distance to u (%d): vertex v(%d) with d(u, v) = %10.5f\n", u_it->id(), v_it->id(), uv_dist);
-        debugl(1, "<=> diameter of cell tree, i.e. the morphological diameter, is %10.5f\n", uv_dist);
+        npairs = (R)sample_npairs;
+    }
 
-        debugTabDec();
-        debugl(1, "CellNetwork::getMorphologicalDiameter(): done.\n");
+    R const mean    = sum / npairs;
 
-        return uv_dist;
-    }
-    /* no neuron vertex reachable from s => return 0 */
-    else {
-        return 0;
-    }
+    v_dist_avg      = K + mean;
+
+    /* sigma with bessel correction as in Aux::Stat::computeMinMaxAvgSigma() */
+    v_dist_sigma    = std::sqrt( std::max(sum_sq - npairs * mean * mean, (R)0) / (npairs - 1.0) );
 }
 
 template <
@@ -5502,30 +5596,39 @@ template <
 >
 void
 CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
-getNeuronVerticesDistanceStat(
-    R  &v_dist_min,
-    R  &v_dist_max,
-    R  &v_dist_avg,
-    R  &v_dist_sigma) const
+getNeuronVerticesNearestNeighbourStat(
+    R  &nn_dist_min,
+    R  &nn_dist_max,
+    R  &nn_dist_avg,
+    R  &nn_dist_sigma) const
 {
-    std::vector<R>  distances;
-    R               d;
+    std::vector<Vec3<R>> p;
+    p.reserve(this->neuron_vertices.size());
+    for (auto &v : this->neuron_vertices) {
+        p.push_back(v.getSinglePointPosition());
+    }
 
-    for (auto vit = this->neuron_vertices.begin(); vit != this->neuron_vertices.end(); ++vit) {
-        auto vit_next = vit;
-        ++vit_next;
-        for (auto wit = vit_next; wit != this->neuron_vertices.end(); ++wit) {
-            d = (wit->getSinglePointPosition() - vit->getSinglePointPosition()).len2();
-            distances.push_back(d);
-        }
+    if (p.size() < 2) {
+        nn_dist_min     = Aux::Numbers::inf<R>();
+        nn_dist_max     = -Aux::Numbers::inf<R>();
+        nn_dist_avg     = std::numeric_limits<R>::quiet_NaN();
+        nn_dist_sigma   = std::numeric_limits<R>::quiet_NaN();
+        return;
+    }
+
+    /* one k-d tree query per vertex, O(n log n) for the point distributions of typical morphologies */
+    KdTree<R>       T(p);
+    std::vector<R>  nn_dist(p.size());
+    for (uint32_t i = 0; i < p.size(); i++) {
+        nn_dist[i] = std::sqrt(T.nearestNeighbourDistance2(i));
     }
 
     Aux::Stat::computeMinMaxAvgSigma(
-        distances,
-        v_dist_min,
-        v_dist_max,
-        v_dist_avg,
-        v_dist_sigma);
+        nn_dist,
+        nn_dist_min,
+        nn_dist_max,
+        nn_dist_avg,
+        nn_dist_sigma);
 }
 
 template <
@@ -5765,7 +5868,8 @@ void
 CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
 readFromNeuroMorphoSWCFile(
         std::string     filename,
-        bool const     &check_coincident_positions)
+        bool const     &check_coincident_positions,
+        uint32_t        nthreads)
 {
     using Common::UnitType;
     using Aux::Alg::listContains;
@@ -5773,109 +5877,64 @@ readFromNeuroMorphoSWCFile(
     debugl(1, "CellNetwork::readFromNeuroMorphoSWCFile():\n");
     debugTabInc();
 
-    /* define sorting function as lambda */
-    auto sort_id = [] (SWCNode const &a, SWCNode const &b) -> bool {
-        return (a.compartment_id < b.compartment_id);
-    };
-
     /* try to open input file */
-    std::ifstream           f;
-    std::string             line_string;
-    char                   *line;
-    char                   *linestart;
-    std::vector<SWCNode>    swc_nodes;
-    std::vector<bool>       node_traversed;
-    Vec3<R>                 p;
-    R                       r;
-    uint32_t                compartment_id, compartment_type;
-    int32_t                 parent_id;
-    uint32_t                nmatch;
+    SWCReader::MappedFile               f;
+    std::vector<SWCReader::Record<R>>   records;
+    std::vector<SWCNode>                swc_nodes;
+    std::vector<bool>                   node_traversed;
 
     debugl(2, "trying to open input file \"%s\". \n", filename.c_str() );
 
-    f.open(filename, std::ifstream::in);
-    if ( !f.is_open() ) {
+    if ( !f.open(filename) ) {
         //printf("CellNetwork::readFromNeuroMorphoSWCFile(): cannot open SWC file \"%s\" for reading.\n", filename.c_str() );
         throw("CellNetwork::readFromNeuroMorphoSWCFile(): unable to open SWC file for reading.");
     }
-    debugl(2, "successfully opened. parsing input file one line at a time..\n");
-
-    debugTabInc();
-    while ( f.good() ) {
-        std::getline(f, line_string);
-        if (line_string.size() == 0) {
-            debugl(4, "empty line..\n");
-            continue;
-        }
-
-        line        = new char [ line_string.size() + 1];
-        linestart   = line;
-        std::strcpy(line, line_string.c_str() );
+    debugl(2, "successfully opened. parsing input file with %d threads..\n", nthreads);
 
-        while (isspace(*linestart)) {
-            ++linestart;
-        }
-
-        /* skip comments */
-        if (*linestart == '#') {
-            debugl(4, "comment found.. ignoring.\n");
-            delete[] line;
-            continue;
-        }
-        else {
-            debugl(4, "line: \"%s\".\n", line);
-        }
+    {
+        Profiling::ScopedStage parse_stage("read_swc/parse");
 
-        if (std::is_same<double, R>::value) {
-            nmatch = sscanf(linestart, "%u %u %lf %lf %lf %lf %d\n", &compartment_id, &compartment_type, &p[0], &p[1], &p[2], &r, &parent_id);
-        }
-        if (std::is_same<float, R>::value) {
-            nmatch = sscanf(linestart, "%u %u %f %f %f %f %d\n", &compartment_id, &compartment_type, &p[0], &p[1], &p[2], &r, &parent_id);
-        }
-        else {
-            nmatch = sscanf(linestart, "%u %u %lf %lf %lf %lf %d\n", &compartment_id, &compartment_type, &p[0], &p[1], &p[2], &r, &parent_id);
+        if (SWCReader::parse(f, nthreads, records)) {
+            throw("CellNetwork::readFromNeuroMorphoSWCFile(): line is not a comment, yet necessary information could not be matched. syntax error..");
         }
+    }
+    f.close();
+    debugl(2, "input file parsed into %zu records.\n", records.size());
 
-        if (nmatch != 7) {
-            throw("CellNetwork::readFromNeuroMorphoSWCFile(): line is not a comment, yet necessary information could not be matched. syntax error..");
+    debugl(2, "checking for consecutive ids.\n");
+    /* place records by compartment id, counting from 0. all ids are consecutive and hence also pairwise distinct iff
+     * they form a permutation of 0, .., n - 1, so no sorting is required. */
+    uint32_t const          nrecords = records.size();
+    std::vector<uint32_t>   record_of_id(nrecords, std::numeric_limits<uint32_t>::max());
+    for (uint32_t i = 0; i < nrecords; i++) {
+        uint32_t const compartment_id = records[i].compartment_id - 1;
+        if (compartment_id >= nrecords || record_of_id[compartment_id] != std::numeric_limits<uint32_t>::max()) {
+            throw("CellNetwork::readFromNeuroMorphoSWCFile(): compartment ids not consecutive. semantic error.\n");
         }
+        record_of_id[compartment_id] = i;
+    }
 
-        /* decrement indices, we count fromt 0 */
-        compartment_id--;
+    swc_nodes.reserve(nrecords);
+    for (uint32_t compartment_id = 0; compartment_id < nrecords; compartment_id++) {
+        auto const &rec         = records[record_of_id[compartment_id]];
         /* if parent_id is not -1 (soma), decrement as well */
-        if (parent_id != -1) {
-            parent_id--;
-        }
-        //printf("(%u,%u,%f,%f,%f,%f,%d)\n", section_idx, section_type, x, y, z, r, parent_idx);
+        int32_t     parent_id   = (rec.parent_id != -1) ? rec.parent_id - 1 : -1;
 
         swc_nodes.push_back(
                 SWCNode(
                     compartment_id,
-                    compartment_type,
+                    rec.compartment_type,
                     parent_id,
-                    { { compartment_id, p, r } }
+                    { { compartment_id, rec.p, rec.r } }
                 )
             );
-
-        delete [] line;
     }
-    debugTabDec();
-    debugl(2, "input file parsed into SWCNode array.\n");
-    
-    /* sort nodes by compartment id. */
-    std::sort(swc_nodes.begin(), swc_nodes.end(), sort_id);
+    records.clear();
+    records.shrink_to_fit();
 
     /* resize and init traversal flag array */
     node_traversed.assign(swc_nodes.size(), false);
 
-    debugl(2, "checking for consecutive ids.\n");
-    /* check whether all ids are consecutive and hence also pairwise distinct */
-    for (uint32_t i = 0; i < swc_nodes.size(); i++) {
-        if (swc_nodes[i].compartment_id != i) {
-            throw("CellNetwork::readFromNeuroMorphoSWCFile(): compartment ids not consecutive. semantic error.\n");
-        }
-    }
-
     debugl(2, "computing preliminary tree structure.\n");
     /* compute tree structure among nodes and get all soma nodes, that is: all nodes with parent_id -1. other nodes may
      * refer encode information for the same soma and will be merged below */
@@ -6404,3 +6463,467 @@ readFromNeuroMorphoSWCFile(
     debugTabDec();
     debugl(1, "CellNetwork::readFromNeuroMorphoSWCFile(): done.\n");
 }
+
+template <
+    typename Tn, typename Tv, typename Te, typename Tso, typename Tnv, typename Tax, typename Tde,
+    typename Tns, typename Tas, typename Tds, typename Tnr, typename Tar, typename Tdr, typename R
+>
+void
+CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
+writeBinaryCache(
+    std::string     filename,
+    uint64_t        key) const
+{
+    using namespace CellNetworkCache;
+
+    debugl(1, "CellNetwork::writeBinaryCache(): writing to filename \"%s\".\n", filename.c_str() );
+    debugTabInc();
+
+    Header                              header;
+    std::vector<VertexRecord>           vertices;
+    std::vector<EdgeRecord>             edges;
+    std::vector<SectionRecord<R>>       sections;
+    std::vector<SectionEdgeRecord>      section_edges;
+
+    std::unordered_map<uint32_t, uint32_t> vertex_index, edge_index;
+
+    auto append_section = [&sections] (CellSection const &x) -> void {
+        SectionRecord<R> rec;
+        rec.compartment_id  = x.compartment_id();
+        rec.padding         = 0;
+        rec.pos[0]          = x.position()[0];
+        rec.pos[1]          = x.position()[1];
+        rec.pos[2]          = x.position()[2];
+        rec.radius          = x.radius();
+        sections.push_back(rec);
+    };
+
+    /* all vertices in ascending id order with their sections */
+    for (auto &v : this->neuron_vertices) {
+        VertexRecord rec;
+        std::memset(&rec, 0, sizeof(rec));
+        rec.type                = v.getType();
+        rec.soma                = invalid_index;
+        rec.neurite             = invalid_index;
+        rec.sections_begin      = sections.size();
+        rec.nsections           = v.sections.size();
+
+        for (auto &x : v.sections) {
+            append_section(x);
+        }
+
+        vertex_index[v.id()] = vertices.size();
+        vertices.push_back(rec);
+    }
+
+    /* all edges in ascending id order */
+    for (auto &e : this->neuron_edges) {
+        EdgeRecord rec;
+        std::memset(&rec, 0, sizeof(rec));
+        rec.type                = e.getType();
+        rec.src                 = vertex_index.at(e.getSourceVertex()->id());
+        rec.dst                 = vertex_index.at(e.getDestinationVertex()->id());
+        rec.soma                = invalid_index;
+        rec.neurite             = invalid_index;
+
+        edge_index[e.id()] = edges.size();
+        edges.push_back(rec);
+    }
+
+    /* soma section graphs */
+    for (auto &s : this->soma_vertices) {
+        VertexRecord                       &rec = vertices[vertex_index.at(s.id())];
+        std::unordered_map<uint32_t, uint32_t> sg_index;
+
+        rec.section_graph_begin         = sections.size();
+        rec.section_graph_edges_begin   = section_edges.size();
+        for (auto &x : s.section_graph.vertices) {
+            sg_index[x.id()] = sections.size() - rec.section_graph_begin;
+            append_section(*x);
+        }
+        for (auto &f : s.section_graph.edges) {
+            section_edges.push_back({ sg_index.at(f.getSourceVertex()->id()), sg_index.at(f.getDestinationVertex()->id()) });
+        }
+        rec.section_graph_nvertices     = sections.size() - rec.section_graph_begin;
+        rec.section_graph_nedges        = section_edges.size() - rec.section_graph_edges_begin;
+        rec.section_graph_root          = sg_index.at(s.section_graph.data());
+    }
+
+    for (auto &d : this->dendrite_vertices) {
+        vertices[vertex_index.at(d.id())].apical_dendrite = d.isApicalDendrite();
+    }
+
+    /* soma / neurite information of neurite vertices and segments */
+    if (this->network_info_initialized) {
+        for (auto &nv : this->neurite_vertices) {
+            VertexRecord &rec   = vertices[vertex_index.at(nv.id())];
+            rec.soma            = vertex_index.at(nv.soma->id());
+            rec.neurite         = edge_index.at(nv.neurite->id());
+        }
+
+        for (auto &ns : this->neurite_segments) {
+            EdgeRecord &rec     = edges[edge_index.at(ns.id())];
+            rec.soma            = vertex_index.at(ns.soma->id());
+            rec.neurite         = edge_index.at(ns.neurite->id());
+        }
+    }
+
+    std::memset(&header, 0, sizeof(header));
+    header.magic                            = CellNetworkCache::magic;
+    header.version                          = CellNetworkCache::version;
+    header.real_size                        = sizeof(R);
+    header.network_info_initialized         = this->network_info_initialized;
+    header.key                              = key;
+    header.nvertices                        = vertices.size();
+    header.nedges                           = edges.size();
+    header.nsections                        = sections.size();
+    header.nsection_edges                   = section_edges.size();
+    header.global_coordinate_displacement[0]= this->global_coordinate_displacement[0];
+    header.global_coordinate_displacement[1]= this->global_coordinate_displacement[1];
+    header.global_coordinate_displacement[2]= this->global_coordinate_displacement[2];
+    header.global_coordinate_scaling_factor = this->global_coordinate_scaling_factor;
+
+    /* checksum over all records in file order, checked by readBinaryCache() before anything is restored */
+    uint64_t checksum   = CellNetworkCache::hash_seed;
+    checksum            = CellNetworkCache::hash(checksum, vertices.data(), vertices.size() * sizeof(VertexRecord));
+    checksum            = CellNetworkCache::hash(checksum, edges.data(), edges.size() * sizeof(EdgeRecord));
+    checksum            = CellNetworkCache::hash(checksum, sections.data(), sections.size() * sizeof(SectionRecord<R>));
+    checksum            = CellNetworkCache::hash(checksum, section_edges.data(), section_edges.size() * sizeof(SectionEdgeRecord));
+    header.checksum     = checksum;
+
+    debugl(2, "%zu vertices, %zu edges, %zu sections, %zu section edges.\n", vertices.size(), edges.size(),
+        sections.size(), section_edges.size());
+
+    /* write to temporary file and rename, so that concurrent readers never see a partially written cache */
+    std::string tmp_filename = filename + ".tmp";
+    FILE *f = fopen(tmp_filename.c_str(), "wb");
+    if (!f) {
+        throw("CellNetwork::writeBinaryCache(): can't open output filename.");
+    }
+
+    bool ok =
+        fwrite(&header, sizeof(header), 1, f) == 1 &&
+        fwrite(vertices.data(), sizeof(VertexRecord), vertices.size(), f) == vertices.size() &&
+        fwrite(edges.data(), sizeof(EdgeRecord), edges.size(), f) == edges.size() &&
+        fwrite(sections.data(), sizeof(SectionRecord<R>), sections.size(), f) == sections.size() &&
+        fwrite(section_edges.data(), sizeof(SectionEdgeRecord), section_edges.size(), f) == section_edges.size();
+
+    if (fclose(f) != 0 || !ok || rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        remove(tmp_filename.c_str());
+        throw("CellNetwork::writeBinaryCache(): failed to write cache file.");
+    }
+
+    debugTabDec();
+    debugl(1, "CellNetwork::writeBinaryCache(): done.\n");
+}
+
+template <
+    typename Tn, typename Tv, typename Te, typename Tso, typename Tnv, typename Tax, typename Tde,
+    typename Tns, typename Tas, typename Tds, typename Tnr, typename Tar, typename Tdr, typename R
+>
+bool
+CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
+readBinaryCache(
+    std::string     filename,
+    uint64_t        key)
+{
+    using namespace CellNetworkCache;
+
+    if (this->neuron_vertices.size() > 0) {
+        throw("CellNetwork::readBinaryCache(): network is not empty.");
+    }
+
+    debugl(1, "CellNetwork::readBinaryCache(): reading from filename \"%s\".\n", filename.c_str() );
+    debugTabInc();
+
+    SWCReader::MappedFile f;
+    if (!f.open(filename) || f.size() < sizeof(Header)) {
+        debugTabDec();
+        debugl(1, "CellNetwork::readBinaryCache(): can't open file or file too small.\n");
+        return false;
+    }
+
+    /* the file is accessed in place. all records are 8-byte aligned relative to the start of the mapping, which
+     * itself is page-aligned (or allocated by new[] in the fallback case). */
+    Header const &header = *reinterpret_cast<Header const *>(f.data());
+
+    size_t const expected_size =
+        sizeof(Header) +
+        (size_t)header.nvertices        * sizeof(VertexRecord) +
+        (size_t)header.nedges           * sizeof(EdgeRecord) +
+        (size_t)header.nsections        * sizeof(SectionRecord<R>) +
+        (size_t)header.nsection_edges   * sizeof(SectionEdgeRecord);
+
+    if (header.magic != CellNetworkCache::magic || header.version != CellNetworkCache::version ||
+        header.real_size != sizeof(R) || header.key != key || f.size() != expected_size)
+    {
+        debugTabDec();
+        debugl(1, "CellNetwork::readBinaryCache(): stale or malformed cache.\n");
+        return false;
+    }
+
+    if (CellNetworkCache::hash(CellNetworkCache::hash_seed, f.data() + sizeof(Header), f.size() - sizeof(Header)) != header.checksum) {
+        debugTabDec();
+        debugl(1, "CellNetwork::readBinaryCache(): checksum mismatch, corrupted cache.\n");
+        return false;
+    }
+
+    /* any malformed record leaves the network partially filled => clear it, so that the caller can fall back to
+     * reading the SWC file into the same network. */
+    try {
+        this->readBinaryCacheRecords(f.data(), header);
+    }
+    catch (const char *msg) {
+        this->clear();
+        debugTabDec();
+        debugl(1, "CellNetwork::readBinaryCache(): %s\n", msg);
+        return false;
+    }
+    catch (std::exception const &e) {
+        this->clear();
+        debugTabDec();
+        debugl(1, "CellNetwork::readBinaryCache(): %s\n", e.what());
+        return false;
+    }
+
+    debugTabDec();
+    debugl(1, "CellNetwork::readBinaryCache(): done.\n");
+
+    return true;
+}
+
+template <
+    typename Tn, typename Tv, typename Te, typename Tso, typename Tnv, typename Tax, typename Tde,
+    typename Tns, typename Tas, typename Tds, typename Tnr, typename Tar, typename Tdr, typename R
+>
+void
+CellNetwork<Tn, Tv, Te, Tso, Tnv, Tax, Tde, Tns, Tas, Tds, Tnr, Tar, Tdr, R>::
+readBinaryCacheRecords(
+    char const                     *data,
+    CellNetworkCache::Header const &header)
+{
+    using namespace CellNetworkCache;
+    using Common::UnitType;
+
+    VertexRecord const         *vertices        = reinterpret_cast<VertexRecord const *>(data + sizeof(Header));
+    EdgeRecord const           *edges           = reinterpret_cast<EdgeRecord const *>(vertices + header.nvertices);
+    SectionRecord<R> const     *sections        = reinterpret_cast<SectionRecord<R> const *>(edges + header.nedges);
+    SectionEdgeRecord const    *section_edges   = reinterpret_cast<SectionEdgeRecord const *>(sections + header.nsections);
+
+    auto get_section = [&] (uint32_t i) -> CellSection {
+        if (i >= header.nsections) {
+            throw("CellNetwork::readBinaryCacheRecords(): section index out of range. malformed cache.");
+        }
+        return CellSection(sections[i].compartment_id, Vec3<R>(sections[i].pos[0], sections[i].pos[1], sections[i].pos[2]), sections[i].radius);
+    };
+
+    /* insert vertices in the original id order. ids of a fresh network are consecutive, so the vertex with index i
+     * receives id i and the relative order of all ids (which determines iteration order and thus the order of all
+     * subsequent computations) is that of the original network. */
+    std::vector<soma_iterator>      somas(header.nvertices);
+    std::vector<axon_iterator>      axons(header.nvertices);
+    std::vector<dendrite_iterator>  dendrites(header.nvertices);
+    std::vector<uint32_t>           vertex_types(header.nvertices);
+    std::list<CellSection>          v_sections;
+
+    /* edges and neurite information refer to vertices by index => check the type of the referenced vertex before
+     * using the iterator stored for that type, which is default-constructed for all other types. */
+    auto check_vertex = [&] (uint32_t i, uint32_t type) -> void {
+        if (i >= header.nvertices || vertex_types[i] != type) {
+            throw("CellNetwork::readBinaryCacheRecords(): reference to vertex of wrong type. malformed cache.");
+        }
+    };
+
+    debugl(2, "inserting %d vertices..\n", header.nvertices);
+    for (uint32_t i = 0; i < header.nvertices; i++) {
+        VertexRecord const &rec = vertices[i];
+        uint32_t            id;
+
+        v_sections.clear();
+        for (uint32_t k = 0; k < rec.nsections; k++) {
+            v_sections.push_back(get_section(rec.sections_begin + k));
+        }
+
+        switch (rec.type) {
+            case SOMA_VERTEX:
+            {
+                Graph<uint32_t, CellSection, UnitType>                                  section_graph;
+                std::vector<typename Graph<uint32_t, CellSection, UnitType>::vertex_iterator> sg_vertices;
+
+                for (uint32_t k = 0; k < rec.section_graph_nvertices; k++) {
+                    sg_vertices.push_back(section_graph.vertices.insert(get_section(rec.section_graph_begin + k)));
+                }
+                for (uint32_t k = 0; k < rec.section_graph_nedges; k++) {
+                    if (rec.section_graph_edges_begin + k >= header.nsection_edges) {
+                        throw("CellNetwork::readBinaryCacheRecords(): section edge index out of range. malformed cache.");
+                    }
+                    SectionEdgeRecord const &se = section_edges[rec.section_graph_edges_begin + k];
+                    section_graph.edges.insert(sg_vertices.at(se.src), sg_vertices.at(se.dst));
+                }
+                section_graph.data() = sg_vertices.at(rec.section_graph_root)->id();
+
+                somas[i]            = this->soma_vertices.insert(section_graph);
+                somas[i]->sections  = v_sections;
+                id                  = somas[i]->id();
+                break;
+            }
+
+            case AXON_VERTEX:
+                if (v_sections.size() != 1) {
+                    throw("CellNetwork::readBinaryCacheRecords(): axon vertex containing not exactly one CellSection. malformed cache.");
+                }
+                axons[i]            = this->axon_vertices.insert(v_sections.front());
+                id                  = axons[i]->id();
+                break;
+
+            case DENDRITE_VERTEX:
+                if (v_sections.size() != 1) {
+                    throw("CellNetwork::readBinaryCacheRecords(): dendrite vertex containing not exactly one CellSection. malformed cache.");
+                }
+                dendrites[i]        = this->dendrite_vertices.insert(v_sections.front(), rec.apical_dendrite);
+                id                  = dendrites[i]->id();
+                break;
+
+            default:
+                throw("CellNetwork::readBinaryCacheRecords(): unknown vertex type. malformed cache.");
+        }
+
+        if (id != i) {
+            throw("CellNetwork::readBinaryCacheRecords(): vertex ids of fresh network not consecutive. internal logic error.");
+        }
+        vertex_types[i] = rec.type;
+    }
+
+    debugl(2, "inserting %d edges..\n", header.nedges);
+    for (uint32_t i = 0; i < header.nedges; i++) {
+        EdgeRecord const   &rec = edges[i];
+        uint32_t            id;
+
+        if (rec.src >= header.nvertices || rec.dst >= header.nvertices) {
+            throw("CellNetwork::readBinaryCacheRecords(): vertex index out of range. malformed cache.");
+        }
+
+        switch (rec.type) {
+            case AXON_ROOT_EDGE:
+            {
+                check_vertex(rec.src, SOMA_VERTEX);
+                check_vertex(rec.dst, AXON_VERTEX);
+
+                auto rpair = this->axon_root_edges.insert(somas[rec.src], axons[rec.dst]);
+                if (!rpair.second) {
+                    throw("CellNetwork::readBinaryCacheRecords(): failed to insert axon root edge. malformed cache.");
+                }
+                id = rpair.first->id();
+                break;
+            }
+
+            case DENDRITE_ROOT_EDGE:
+            {
+                check_vertex(rec.src, SOMA_VERTEX);
+                check_vertex(rec.dst, DENDRITE_VERTEX);
+
+                auto rpair = this->dendrite_root_edges.insert(somas[rec.src], dendrites[rec.dst]);
+                if (!rpair.second) {
+                    throw("CellNetwork::readBinaryCacheRecords(): failed to insert dendrite root edge. malformed cache.");
+                }
+                id = rpair.first->id();
+                break;
+            }
+
+            case AXON_SEGMENT:
+            {
+                check_vertex(rec.src, AXON_VERTEX);
+                check_vertex(rec.dst, AXON_VERTEX);
+
+                auto rpair = this->axon_segments.insert(axons[rec.src], axons[rec.dst]);
+                if (!rpair.second) {
+                    throw("CellNetwork::readBinaryCacheRecords(): failed to insert axon segment. malformed cache.");
+                }
+                id = rpair.first->id();
+                break;
+            }
+
+            case DENDRITE_SEGMENT:
+            {
+                check_vertex(rec.src, DENDRITE_VERTEX);
+                check_vertex(rec.dst, DENDRITE_VERTEX);
+
+                auto rpair = this->dendrite_segments.insert(dendrites[rec.src], dendrites[rec.dst]);
+                if (!rpair.second) {
+                    throw("CellNetwork::readBinaryCacheRecords(): failed to insert dendrite segment. malformed cache.");
+                }
+                id = rpair.first->id();
+                break;
+            }
+
+            default:
+                throw("CellNetwork::readBinaryCacheRecords(): unknown edge type. malformed cache.");
+        }
+
+        if (id != i) {
+            throw("CellNetwork::readBinaryCacheRecords(): edge ids of fresh network not consecutive. internal logic error.");
+        }
+    }
+
+    this->global_coordinate_displacement    = Vec3<R>(
+                                                header.global_coordinate_displacement[0],
+                                                header.global_coordinate_displacement[1],
+                                                header.global_coordinate_displacement[2]);
+    this->global_coordinate_scaling_factor  = header.global_coordinate_scaling_factor;
+
+    /* restore soma / neurite information directly instead of traversing all neurites in initializeNetworkInfo() */
+    if (header.network_info_initialized) {
+        debugl(2, "restoring network info..\n");
+        std::vector<neurite_rootedge_iterator> neurites(header.nedges);
+        for (auto &nre : this->neurite_root_edges) {
+            neurites[nre.id()] = nre.iterator();
+        }
+
+        /* neurites are stored as the index of their root edge */
+        auto is_neurite = [&] (uint32_t i) -> bool {
+            return (i < header.nedges && (edges[i].type == AXON_ROOT_EDGE || edges[i].type == DENDRITE_ROOT_EDGE));
+        };
+
+        for (auto &nv : this->neurite_vertices) {
+            VertexRecord const &rec = vertices[nv.id()];
+            if (rec.soma >= header.nvertices || vertex_types[rec.soma] != SOMA_VERTEX || !is_neurite(rec.neurite)) {
+                throw("CellNetwork::readBinaryCacheRecords(): neurite vertex without valid soma / neurite. malformed cache.");
+            }
+            nv.soma     = somas[rec.soma];
+            nv.neurite  = neurites[rec.neurite];
+        }
+
+        for (auto &ns : this->neurite_segments) {
+            EdgeRecord const &rec = edges[ns.id()];
+            if (rec.soma >= header.nvertices || vertex_types[rec.soma] != SOMA_VERTEX || !is_neurite(rec.neurite)) {
+                throw("CellNetwork::readBinaryCacheRecords(): neurite segment without valid soma / neurite. malformed cache.");
+            }
+            ns.soma     = somas[rec.soma];
+            ns.neurite  = neurites[rec.neurite];
+        }
+
+        /* the restored assignment must be the one initializeNetworkInfo() would compute: every neurite root edge
+         * starts its neurite, and both end points of every neurite segment belong to the segment's soma / neurite. */
+        for (auto &nre : this->neurite_root_edges) {
+            neurite_iterator r = nre.getDestinationVertex();
+            if (r->soma->id() != nre.getSourceVertex()->id() || r->neurite->id() != nre.id()) {
+                throw("CellNetwork::readBinaryCacheRecords(): neurite root vertex not assigned to its root edge. malformed cache.");
+            }
+        }
+
+        for (auto &ns : this->neurite_segments) {
+            neurite_iterator u = ns.getSourceVertex();
+            neurite_iterator v = ns.getDestinationVertex();
+            if (u->soma->id() != ns.soma->id() || v->soma->id() != ns.soma->id() ||
+                u->neurite->id() != ns.neurite->id() || v->neurite->id() != ns.neurite->id())
+            {
+                throw("CellNetwork::readBinaryCacheRecords(): soma / neurite of neurite segment inconsistent with its end points. malformed cache.");
+            }
+        }
+
+        this->network_info_initialized = true;
+    }
+    else {
+        this->network_info_initialized = false;
+    }
+}
@@ -0,0 +1,281 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+template <typename R>
+KdTree<R>::KdTree(std::vector<Vec3<R>> const &points)
+:
+    points(points)
+{
+    this->index.resize(this->points.size());
+    std::iota(this->index.begin(), this->index.end(), 0);
+
+    if (!this->points.empty()) {
+        this->nodes.reserve(2 * (this->points.size() / leaf_size + 1));
+        this->build(0, this->points.size());
+    }
+}
+
+template <typename R>
+uint32_t
+KdTree<R>::build(
+    uint32_t begin,
+    uint32_t end)
+{
+    uint32_t const node = this->nodes.size();
+    this->nodes.push_back(Node());
+
+    BoundingBox<R> bb;
+    for (uint32_t k = begin; k < end; k++) {
+        bb.update(BoundingBox<R>(this->points[this->index[k]], this->points[this->index[k]]));
+    }
+
+    uint32_t left = 0, right = 0;
+    if (end - begin > leaf_size) {
+        /* split at the median along the axis of largest extent */
+        Vec3<R> const   ext     = bb.max() - bb.min();
+        uint32_t const  axis    = (ext[0] >= ext[1] && ext[0] >= ext[2]) ? 0 : (ext[1] >= ext[2] ? 1 : 2);
+        uint32_t const  mid     = begin + (end - begin) / 2;
+
+        std::nth_element(
+            this->index.begin() + begin,
+            this->index.begin() + mid,
+            this->index.begin() + end,
+            [this, axis] (uint32_t x, uint32_t y) -> bool
+            {
+                return (this->points[x][axis] < this->points[y][axis]);
+            });
+
+        left    = this->build(begin, mid);
+        right   = this->build(mid, end);
+    }
+
+    /* nodes may have been reallocated by the recursive calls */
+    Node &n     = this->nodes[node];
+    n.bb        = bb;
+    n.begin     = begin;
+    n.end       = end;
+    n.left      = left;
+    n.right     = right;
+
+    return node;
+}
+
+template <typename R>
+R
+KdTree<R>::minDist2(
+    BoundingBox<R> const   &bb,
+    Vec3<R> const          &p)
+{
+    R d2 = 0;
+    for (uint32_t j = 0; j < 3; j++) {
+        R const d = std::max(std::max(bb.min()[j] - p[j], p[j] - bb.max()[j]), (R)0);
+        d2 += d * d;
+    }
+    return d2;
+}
+
+template <typename R>
+R
+KdTree<R>::maxDist2(
+    BoundingBox<R> const   &a,
+    BoundingBox<R> const   &b)
+{
+    R d2 = 0;
+    for (uint32_t j = 0; j < 3; j++) {
+        R const d = std::max(a.max()[j] - b.min()[j], b.max()[j] - a.min()[j]);
+        d2 += d * d;
+    }
+    return d2;
+}
+
+template <typename R>
+size_t
+KdTree<R>::size() const
+{
+    return (this->points.size());
+}
+
+template <typename R>
+void
+KdTree<R>::nearestNeighbour(
+    uint32_t        node,
+    uint32_t        i,
+    R              &best) const
+{
+    Node const     &n = this->nodes[node];
+    Vec3<R> const  &p = this->points[i];
+
+    if (n.left == 0) {
+        for (uint32_t k = n.begin; k < n.end; k++) {
+            uint32_t const j = this->index[k];
+            if (j != i) {
+                best = std::min(best, (this->points[j] - p).len2squared());
+            }
+        }
+        return;
+    }
+
+    /* descend into the closer child first to tighten the bound early */
+    R const d_left  = minDist2(this->nodes[n.left].bb, p);
+    R const d_right = minDist2(this->nodes[n.right].bb, p);
+
+    if (d_left <= d_right) {
+        if (d_left < best)  this->nearestNeighbour(n.left, i, best);
+        if (d_right < best) this->nearestNeighbour(n.right, i, best);
+    }
+    else {
+        if (d_right < best) this->nearestNeighbour(n.right, i, best);
+        if (d_left < best)  this->nearestNeighbour(n.left, i, best);
+    }
+}
+
+template <typename R>
+R
+KdTree<R>::nearestNeighbourDistance2(
+    uint32_t        i,
+    R               bound) const
+{
+    R best = bound;
+    if (!this->nodes.empty() && minDist2(this->nodes[0].bb, this->points[i]) < best) {
+        this->nearestNeighbour(0, i, best);
+    }
+    return best;
+}
+
+template <typename R>
+R
+KdTree<R>::closestPairDistance2() const
+{
+    /* the current minimum bounds all subsequent nearest neighbour queries */
+    R best = Aux::Numbers::inf<R>();
+    for (uint32_t i = 0; i < this->points.size() && best > 0; i++) {
+        best = this->nearestNeighbourDistance2(i, best);
+    }
+    return best;
+}
+
+template <typename R>
+void
+KdTree<R>::farthestPair(
+    uint32_t        a,
+    uint32_t        b,
+    R              &best) const
+{
+    Node const &na = this->nodes[a];
+    Node const &nb = this->nodes[b];
+
+    if (maxDist2(na.bb, nb.bb) <= best) {
+        return;
+    }
+
+    /* two leaves: compare all pairs, only pairs with k < l if both are the same leaf */
+    if (na.left == 0 && nb.left == 0) {
+        for (uint32_t k = na.begin; k < na.end; k++) {
+            Vec3<R> const &p = this->points[this->index[k]];
+            for (uint32_t l = (a == b ? k + 1 : nb.begin); l < nb.end; l++) {
+                best = std::max(best, (this->points[this->index[l]] - p).len2squared());
+            }
+        }
+        return;
+    }
+
+    /* pair of a node with itself: the two children with themselves and with each other */
+    if (a == b) {
+        this->farthestPair(na.left, na.right, best);
+        this->farthestPair(na.left, na.left, best);
+        this->farthestPair(na.right, na.right, best);
+        return;
+    }
+
+    /* split the node with more points (or the only inner node), visit the more promising child pair first */
+    uint32_t split, other;
+    if (nb.left == 0 || (na.left != 0 && na.end - na.begin >= nb.end - nb.begin)) {
+        split = a;
+        other = b;
+    }
+    else {
+        split = b;
+        other = a;
+    }
+
+    uint32_t const  c0  = this->nodes[split].left;
+    uint32_t const  c1  = this->nodes[split].right;
+    R const         d0  = maxDist2(this->nodes[c0].bb, this->nodes[other].bb);
+    R const         d1  = maxDist2(this->nodes[c1].bb, this->nodes[other].bb);
+
+    if (d0 >= d1) {
+        this->farthestPair(c0, other, best);
+        this->farthestPair(c1, other, best);
+    }
+    else {
+        this->farthestPair(c1, other, best);
+        this->farthestPair(c0, other, best);
+    }
+}
+
+template <typename R>
+R
+KdTree<R>::farthestPairDistance2() const
+{
+    R best = -Aux::Numbers::inf<R>();
+    if (this->points.size() < 2) {
+        return best;
+    }
+
+    /* seed the bound with the pairs of extreme points along every axis */
+    for (uint32_t j = 0; j < 3; j++) {
+        auto cmp = [this, j] (uint32_t x, uint32_t y) -> bool
+        {
+            return (this->points[x][j] < this->points[y][j]);
+        };
+        auto minmax = std::minmax_element(this->index.begin(), this->index.end(), cmp);
+        best = std::max(best, (this->points[*minmax.second] - this->points[*minmax.first]).len2squared());
+    }
+
+    this->farthestPair(0, 0, best);
+    return best;
+}
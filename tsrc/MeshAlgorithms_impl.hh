@@ -151,17 +151,11 @@ refineTriangularUnitSphereApproximation(Mesh<Tm, Tv, Tf, R> &S)
     }
 }
 
+/* add the 6 vertices and 8 faces of the octahedron inscribed into the unit sphere to S */
 template <typename Tm, typename Tv, typename Tf, typename R>
 void
-MeshAlg::generateOctSphere(
-    Vec3<R>                 c,
-    R const                &r,
-    uint32_t                tessellation_depth,
-    Mesh<Tm, Tv, Tf, R>    &S)
+insertUnitOctahedron(Mesh<Tm, Tv, Tf, R> &S)
 {
-    /* clear input mesh */
-    S.clear();
-
     R const                                         one_over_sqrt2 = (R)1.0 / std::sqrt((R)2.0);
     typename Mesh<Tm, Tv, Tf, R>::vertex_iterator   sqrt_00, sqrt_01, sqrt_10, sqrt_11, top, bottom;
 
@@ -182,29 +176,13 @@ MeshAlg::generateOctSphere(
     S.faces.insert(sqrt_10,   sqrt_00,    bottom);
     S.faces.insert(sqrt_11,   sqrt_01,    top);
     S.faces.insert(sqrt_11,   bottom,     sqrt_01);
-
-    /* refine tessellation_depth times */
-    for (uint32_t i = 0; i < tessellation_depth; i++) {
-        refineTriangularUnitSphereApproximation(S);
-    }
-
-    /* scale all vertices with radius r and translate origin to centre c */
-    S.scale(r);
-    S.translate(c);
 }
 
-/* ico sphere */
+/* add the 12 vertices and 20 faces of the icosahedron inscribed into the unit sphere to S */
 template <typename Tm, typename Tv, typename Tf, typename R>
 void
-MeshAlg::generateIcoSphere(
-    Vec3<R>                 c,
-    R const                &r,
-    uint32_t                tessellation_depth,
-    Mesh<Tm, Tv, Tf, R>    &S)
+insertUnitIcosahedron(Mesh<Tm, Tv, Tf, R> &S)
 {
-    /* clear input mesh */
-    S.clear();
-
     R const                                         phi     = (1.0 + std::sqrt((R)5.0)) / 2.0;
     R const                                         norm    = std::sqrt((R)2.0 + phi);
     typename Mesh<Tm, Tv, Tf, R>::vertex_iterator   vits[12];
@@ -246,15 +224,113 @@ MeshAlg::generateIcoSphere(
     S.faces.insert( vits[10], vits[ 8], vits[ 0]);
     S.faces.insert( vits[10], vits[ 0], vits[ 6]);
     S.faces.insert( vits[10], vits[ 6], vits[ 7]);
+}
+
+template <typename R>
+MeshAlg::UnitSphereTemplate<R> const &
+MeshAlg::getUnitSphereTemplate(
+    UnitSphereType          type,
+    uint32_t                tessellation_depth)
+{
+    static std::mutex                                   templates_mutex;
+    static std::map<
+            std::pair<int, uint32_t>,
+            std::unique_ptr<UnitSphereTemplate<R>>
+        >                                               templates;
+
+    std::lock_guard<std::mutex> lock(templates_mutex);
+
+    std::unique_ptr<UnitSphereTemplate<R>> &T = templates[ { (int)type, tessellation_depth } ];
+    if (T) {
+        return (*T);
+    }
+
+    debugl(2, "MeshAlg::getUnitSphereTemplate(): building unit sphere template. type: %d, depth: %d.\n", type, tessellation_depth);
+
+    /* refine base polyhedron as usual. the mesh has never been modified otherwise, so vertex and face ids are
+     * consecutive and reflect insertion order. */
+    Mesh<bool, bool, bool, R> S;
+    if (type == UNIT_SPHERE_OCT) {
+        insertUnitOctahedron(S);
+    }
+    else {
+        insertUnitIcosahedron(S);
+    }
 
-    /* refine tessellation_depth times */
     for (uint32_t i = 0; i < tessellation_depth; i++) {
         refineTriangularUnitSphereApproximation(S);
     }
 
-    /* scale all vertices with radius r and translate origin to centre c */
-    S.scale(r);
-    S.translate(c);
+    /* flatten */
+    std::unique_ptr<UnitSphereTemplate<R>> T_new(new UnitSphereTemplate<R>());
+    uint32_t v0_id, v1_id, v2_id;
+
+    T_new->vertices.reserve(S.numVertices());
+    for (auto &v : S.vertices) {
+        if (v.id() != T_new->vertices.size()) {
+            throw("MeshAlg::getUnitSphereTemplate(): vertex ids of refined unit sphere not consecutive. internal logic error.");
+        }
+        T_new->vertices.push_back(v.pos());
+    }
+
+    T_new->triangles.reserve(S.numFaces());
+    for (auto &f : S.faces) {
+        f.getTriIndices(v0_id, v1_id, v2_id);
+        T_new->triangles.push_back( { { v0_id, v1_id, v2_id } } );
+    }
+
+    T = std::move(T_new);
+    return (*T);
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+MeshAlg::instantiateUnitSphereTemplate(
+    UnitSphereTemplate<R> const    &T,
+    Vec3<R>                         c,
+    R const                        &r,
+    Mesh<Tm, Tv, Tf, R>            &S)
+{
+    /* clear input mesh */
+    S.clear();
+
+    std::vector<
+            typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
+        >                                                   vits;
+
+    /* scale all vertices with radius r and translate origin to centre c, in the same order as Mesh::scale() and
+     * Mesh::translate() would */
+    vits.reserve(T.vertices.size());
+    for (auto &x : T.vertices) {
+        vits.push_back(S.vertices.insert(x*r + c));
+    }
+
+    for (auto &t : T.triangles) {
+        S.faces.insert(vits[t[0]], vits[t[1]], vits[t[2]]);
+    }
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+MeshAlg::generateOctSphere(
+    Vec3<R>                 c,
+    R const                &r,
+    uint32_t                tessellation_depth,
+    Mesh<Tm, Tv, Tf, R>    &S)
+{
+    instantiateUnitSphereTemplate(getUnitSphereTemplate<R>(UNIT_SPHERE_OCT, tessellation_depth), c, r, S);
+}
+
+/* ico sphere */
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+MeshAlg::generateIcoSphere(
+    Vec3<R>                 c,
+    R const                &r,
+    uint32_t                tessellation_depth,
+    Mesh<Tm, Tv, Tf, R>    &S)
+{
+    instantiateUnitSphereTemplate(getUnitSphereTemplate<R>(UNIT_SPHERE_ICO, tessellation_depth), c, r, S);
 }
 
 template <typename Tm, typename Tv, typename Tf, typename R>
@@ -271,14 +347,20 @@ MeshAlg::appendHalfSphereToCanalSurfaceMesh(
             typename Mesh<Tm, Tv, Tf, R>
                 ::vertex_iterator
         >                                           start_circle_its,
-    typename Mesh<Tm, Tv, Tf, R>::vertex_iterator   closing_vertex_it)
+    typename Mesh<Tm, Tv, Tf, R>::vertex_iterator   closing_vertex_it,
+    CanalSurfaceRingCache<R>                       *ring_cache)
 {
-    using Common::twopi;
-
     uint32_t    i, j;
     uint32_t    ntsegments;
     Vec3<R>     p, px, py, pz;
-    R           t, phi, r, alpha, dalpha;
+    R           t, r, alpha, dalpha;
+
+    /* the half-sphere continues the canal surface rings with the same unit-circle offsets */
+    std::unique_ptr<CanalSurfaceRingCache<R>> local_ring_cache;
+    if (!ring_cache || !ring_cache->matches(nphisegments, phi_offset)) {
+        local_ring_cache.reset(new CanalSurfaceRingCache<R>(nphisegments, phi_offset));
+        ring_cache = local_ring_cache.get();
+    }
 
     /* vectors storing vertex iterators of current and last circle */
     std::vector<typename Mesh<Tm, Tv, Tf, R>::vertex_iterator>  last_circle;
@@ -305,6 +387,15 @@ MeshAlg::appendHalfSphereToCanalSurfaceMesh(
      * */
     direction.normalize();
 
+    /* get orthonormal base, which is the same for all circles. direction is the x vector */
+    px = direction;
+    px.normalize();
+
+    py = render_vector.cross(px);
+    py.normalize();
+
+    pz = px.cross(py);
+
     /* the "start" circle already exists and needs not be created again. the "end" circle of the
      * half-sphere coincides with a single point, which is specially connected to the second to last
      * circle, i.e. the last "real" non-degenerate circle, wiht a triangle fan */
@@ -312,15 +403,6 @@ MeshAlg::appendHalfSphereToCanalSurfaceMesh(
         /* shift circle ids */
         last_circle = current_circle;
 
-        /* get orthonormal base. direction is the x vector */
-        px = direction;
-        px.normalize();
-
-        py = render_vector.cross(px);
-        py.normalize();
-
-        pz = px.cross(py);
-
         /* t = cos(alpha), where alpha = pi/2 - i*dalpha */
         alpha   = (M_PI / 2.0) - i*dalpha;
         t       = std::cos(alpha);
@@ -331,10 +413,7 @@ MeshAlg::appendHalfSphereToCanalSurfaceMesh(
         /* the point p: start + (t*r)*direction */
         p   = start + direction*(t*radius);
 
-        for (j = 0; j < nphisegments; j++) {
-            phi                 = ( (R)j * twopi) / (R)nphisegments;
-            current_circle[j]   = M.vertices.insert( p + py*(r*std::cos(phi + phi_offset)) + pz*(r*std::sin(phi + phi_offset)) );
-        }
+        ring_cache->appendRing(M, p, py, pz, r, false, current_circle);
 
         /* generate quad faces between last_circle and current_circle */
         for (j = 0; j < nphisegments - 1; j++) {
@@ -343,6 +422,7 @@ MeshAlg::appendHalfSphereToCanalSurfaceMesh(
 
         /* closing quad at index warp around */
         M.faces.insert(last_circle[nphisegments - 1], last_circle[0], current_circle[0], current_circle[nphisegments - 1]);
+        ring_cache->countTriangles(2*nphisegments);
     }
 
     /* final point and closing triangle fan */
@@ -353,6 +433,7 @@ MeshAlg::appendHalfSphereToCanalSurfaceMesh(
     for (j = 0; j < nphisegments - 1; j++) {
         M.faces.insert(end_closing_vertex_it, current_circle[j], current_circle[j + 1] );
     }
+    ring_cache->countTriangles(nphisegments);
 }
 
 
@@ -379,18 +460,42 @@ MeshAlg::getPotentiallyIntersectingEdgeFacePairs(
     debugl(2, "MeshAlg::getPotentialEdgeFacePairs(): max_components: %5d, max_recursion_depth: %5d.\n", max_components, max_recursion_depth);
     debugTabInc();
 
-    /* get bounding box surrounding both X and Y */
-    auto XY_bb  = (X.getBoundingBox()).update(Y.getBoundingBox());
-
     /* store lists of all faces of X and Y in root lists for recursive top-down Octree-like algorithm 
      * Common::Geometry::computeSpatialIntersectionCandidatePairs() */
     std::vector<std::pair<FaceType*, BoundingBox<R> > > X_face_info_list, Y_face_info_list;
-    X_face_info_list.reserve(X.numFaces());
+    BoundingBox<R>                                      XY_bb, Y_bb;
+
     Y_face_info_list.reserve(Y.numFaces());
-    for (auto &f : X.faces)
-        X_face_info_list.push_back({&f, f.getBoundingBox()});
-    for (auto &f : Y.faces)
+    for (auto &f : Y.faces) {
         Y_face_info_list.push_back({&f, f.getBoundingBox()});
+        Y_bb.update(Y_face_info_list.back().second);
+    }
+
+    /* if X maintains a face index, only faces of X whose bounding box intersects the one of Y can be part of any
+     * candidate pair: query them from the index, so that the cost does not depend on the size of X. */
+    if (X.faceIndexEnabled()) {
+        std::vector<FaceType *> X_faces;
+        X.findFacesIndexed(Y_bb, X_faces);
+
+        X_face_info_list.reserve(X_faces.size());
+        for (auto f : X_faces)
+            X_face_info_list.push_back({f, f->getBoundingBox()});
+    }
+    else {
+        X_face_info_list.reserve(X.numFaces());
+        for (auto &f : X.faces)
+            X_face_info_list.push_back({&f, f.getBoundingBox()});
+    }
+
+    /* get bounding box surrounding both X and Y (or the part of X near Y) */
+    if (X.faceIndexEnabled()) {
+        XY_bb = Y_bb;
+        for (auto &X_info : X_face_info_list)
+            XY_bb.update(X_info.second);
+    }
+    else {
+        XY_bb = (X.getBoundingBox()).update(Y.getBoundingBox());
+    }
 
     std::vector<std::pair<FaceType*, FaceType*> > candidate_pairs;
 
@@ -1050,6 +1155,8 @@ MeshAlg::RedBlueUnion(
     debugl(1, "MeshAlg::RedBlueUnion()\n");
     debugTabInc();
 
+    TRACE_SCOPE_ARG("RedBlueUnion", "red_faces", R.numFaces());
+
     /* simple forward to RedBlueAlgorithm: keeping both OUTSIDE parts creates the union mesh */
     try {MeshAlg::RedBlueAlgorithm(R, B, true, true, blue_update_its);}
     catch (RedBlue_Ex&) {debugTabDec(); throw;}
@@ -2488,9 +2595,8 @@ MeshAlg::HCLaplacianSmoothing(
 
 template <typename Tm, typename Tv, typename Tf, typename R>
 void
-MeshAlg::partialFlushToObjFile(
+MeshAlg::partialFlushExtract(
     Mesh<Tm, Tv, Tf, R>                                        &M,
-    std::pair<FILE **, std::string> const                      &obj_file_info,
     std::list<typename Mesh<Tm, Tv, Tf, R>::Face *>            &face_list,
     std::list<
             std::pair<
@@ -2505,7 +2611,9 @@ MeshAlg::partialFlushToObjFile(
                 uint32_t          
             >
         >                                                      &out_boundary_vertices,
-    uint32_t                                                   &out_last_flush_vertex_id)
+    uint32_t                                                   &out_last_flush_vertex_id,
+    std::string                                                &vertex_lines,
+    std::string                                                &face_lines)
 {
     debugl(1, "MeshAlg::partialFlush().\n");
     debugTabInc();
@@ -2682,8 +2790,123 @@ MeshAlg::partialFlushToObjFile(
     }
     debugTabDec();
 
-    /* write new isolated vertices (with correct id) and all NEW boundary vertices to obj file. as part of the
-     * invariant, all old boundary vertices had already been written to the obj file when the call started. */
+    /* format new isolated vertices (with correct id) and all NEW boundary vertices, followed by the flushed faces. as
+     * part of the invariant, all old boundary vertices had already been written to the obj file when the call
+     * started. */
+    debugl(1, "formatting flushed vertices and faces..\n");
+
+    char    line[128];
+    Vec3<R> vpos;
+
+    vertex_lines.clear();
+    vertex_lines.reserve(48 * (new_isolated_vertices.size() + new_boundary_vertices.size() + 1));
+    snprintf(line, sizeof(line), "# %5zu flushed vertices\n", new_isolated_vertices.size() + new_boundary_vertices.size());
+    vertex_lines += line;
+    for (auto &vp : new_isolated_vertices) {
+        vpos = vp.first->pos();
+        snprintf(line, sizeof(line), "v %+.10e %+.10e %+.10e\n", vpos[0], vpos[1], vpos[2]);
+        vertex_lines += line;
+    }
+    for (auto &vp : new_boundary_vertices) {
+        vpos = vp.first->pos();
+        snprintf(line, sizeof(line), "v %+.10e %+.10e %+.10e\n", vpos[0], vpos[1], vpos[2]);
+        vertex_lines += line;
+    }
+
+    face_lines.clear();
+    face_lines.reserve(24 * (flush_face_list.size() + 1));
+    snprintf(line, sizeof(line), "# %5zu flushed faces.\n", flush_face_list.size());
+    face_lines += line;
+    for (auto &f : flush_face_list) {
+        if (f.quad) {
+            snprintf(line, sizeof(line), "f %d %d %d %d\n",
+                    f.v_ids[0] + 1,
+                    f.v_ids[1] + 1,
+                    f.v_ids[2] + 1,
+                    f.v_ids[3] + 1);
+        }
+        else {
+            snprintf(line, sizeof(line), "f %d %d %d\n",
+                    f.v_ids[0] + 1,
+                    f.v_ids[1] + 1,
+                    f.v_ids[2] + 1 );
+        }
+        face_lines += line;
+    }
+
+    debugl(2, "finishing invariants ..\n");
+
+    /* write out_boundary_vertices for the caller: out_boundary_vertices is the union of new_boundary_vertices and all
+     * old boundary vertices that have not become isolated. since a boundary vertex can either stay a boundary vertex or
+     * become isolated (losing the boundary status) and no vertices have yet been deleted (and thus all pointers are
+     * still intact), it's possible to simply iterate over in_boundary_vertices and extract all vertices that have not
+     * become isolated.  note that the correct ids are copied as well: these are contained in in_boundary_vertices from
+     * the beginning of the call. */
+
+    /* copy in_boundary_vertices so as to enable the caller to use the same list for both references
+     * in_boundary_vertices and out_boundary_vertices */
+    auto in_boundary_vertices_copy = in_boundary_vertices;
+
+    /* initialize (and overwrite) out_boundary_vertices with new_boundary_vertices. this might also overwrite
+     * in_boundary_vertices if both references are identical. */
+    out_boundary_vertices = new_boundary_vertices;
+
+    /* handle input boundary vertices via copy. */
+    for (auto &ibv : in_boundary_vertices_copy) {
+        if (!ibv.first->isIsolated()) {
+            out_boundary_vertices.push_back(ibv);
+        }
+    }
+
+    /* sort */
+    out_boundary_vertices.sort(cmp);
+
+    /* delete all isolated vertices, old and new, from M. note that only old boundary vertices, which have become
+     * isolated during the call, are thereby deleted. no other boundary vertex is deleted, but they have been written to
+     * the obj file already to guarantee the invariant for the next flushing or the finalizing call. */
+    debugl(2, "deleting all new isolated vertices.\n");
+    debugTabInc();
+    for (auto &vp : isolated_vertices) {
+        debugl(3, "deleting isolated vertex %d.\n", vp.first->id());
+        M.vertices.erase(vp.first->iterator());
+    }
+    debugTabDec();
+
+    debugTabDec();
+    debugl(1, "MeshAlg::partialFlush(): done.\n");
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+MeshAlg::partialFlushToObjFile(
+    Mesh<Tm, Tv, Tf, R>                                        &M,
+    std::pair<FILE **, std::string> const                      &obj_file_info,
+    std::list<typename Mesh<Tm, Tv, Tf, R>::Face *>            &face_list,
+    std::list<
+            std::pair<
+                typename Mesh<Tm, Tv, Tf, R>::Vertex *,
+                uint32_t
+            >
+        >                                                      &in_boundary_vertices,
+    uint32_t const                                             &in_last_flush_vertex_id,
+    std::list<
+            std::pair<
+                typename Mesh<Tm, Tv, Tf, R>::Vertex *,
+                uint32_t          
+            >
+        >                                                      &out_boundary_vertices,
+    uint32_t                                                   &out_last_flush_vertex_id)
+{
+    std::string vertex_lines, face_lines;
+    MeshAlg::partialFlushExtract<Tm, Tv, Tf, R>(
+        M,
+        face_list,
+        in_boundary_vertices,
+        in_last_flush_vertex_id,
+        out_boundary_vertices,
+        out_last_flush_vertex_id,
+        vertex_lines,
+        face_lines);
 
     /* since vertices should be the first block and the face definition block (which use vertex indices) should be
      * below, it is necessary to insert new vertex definition lines in the middle of obj_file, an operation that is
@@ -2702,11 +2925,10 @@ MeshAlg::partialFlushToObjFile(
     std::string const &filename     = obj_file_info.second;
     std::string swap_filename       = filename + "_swap";
     FILE *swap_file                 = fopen( (swap_filename + ".obj").c_str(), "w");
-    const char v_delim[]            = "# ____~V____";
+    const char *v_delim             = MeshObjFlushWriter::vertexDelimiter();
     char line[1024];
 
     if (!swap_file) {
-        debugTabDec();
         throw("MeshAlg::partialFlush(): can't open swap file for writing.");
     }
 
@@ -2714,16 +2936,7 @@ MeshAlg::partialFlushToObjFile(
     if (Aux::File::isEmpty(obj_file)) {
         debugl(1, "given obj file empty..\n");
 
-        fprintf(swap_file, "# %5zu flushed vertices\n", new_isolated_vertices.size() + new_boundary_vertices.size());
-        Vec3<R> vpos;
-        for (auto &vp : new_isolated_vertices) {
-            vpos = vp.first->pos();
-            fprintf(swap_file, "v %+.10e %+.10e %+.10e\n", vpos[0], vpos[1], vpos[2]);
-        }
-        for (auto &vp : new_boundary_vertices) {
-            vpos = vp.first->pos();
-            fprintf(swap_file, "v %+.10e %+.10e %+.10e\n", vpos[0], vpos[1], vpos[2]);
-        }
+        fputs(vertex_lines.c_str(), swap_file);
 
         /* and write delimiter again */
         fprintf(swap_file, "%s\n", v_delim);
@@ -2740,20 +2953,11 @@ MeshAlg::partialFlushToObjFile(
                 /* overwrite newline with zero-termination */
                 line[strlen(line) - 1] = '\0';
                 debugl(2, "line from original file: \"%s\".\n", line);
-                if (strncmp(line, v_delim, sizeof(v_delim)) == 0) {
+                if (strcmp(line, v_delim) == 0) {
                     debugl(3, "writing new vertices and delimiter.\n");
 
                     /* delimiter found. write new vertices */
-                    fprintf(swap_file, "# %5zu flushed vertices\n", new_isolated_vertices.size() + new_boundary_vertices.size());
-                    Vec3<R> vpos;
-                    for (auto &vp : new_isolated_vertices) {
-                        vpos = vp.first->pos();
-                        fprintf(swap_file, "v %+.10e %+.10e %+.10e\n", vpos[0], vpos[1], vpos[2]);
-                    }
-                    for (auto &vp : new_boundary_vertices) {
-                        vpos = vp.first->pos();
-                        fprintf(swap_file, "v %+.10e %+.10e %+.10e\n", vpos[0], vpos[1], vpos[2]);
-                    }
+                    fputs(vertex_lines.c_str(), swap_file);
 
                     /* and write delimiter again */
                     fprintf(swap_file, "%s\n", v_delim);
@@ -2766,7 +2970,7 @@ MeshAlg::partialFlushToObjFile(
                 }
             }
             else {
-                debugTabDec(); debugTabDec();
+                debugTabDec();
                 throw("MeshAlg::partialFlush(): obj line longer than 1024 characters. please limit comments to reasonable line width.");
             }
         }
@@ -2774,43 +2978,7 @@ MeshAlg::partialFlushToObjFile(
     }
 
     /* append all faces to swap file */
-    fprintf(swap_file, "# %5zu flushed faces.\n", flush_face_list.size());
-    for (auto &f : flush_face_list) {
-        if (f.quad) {
-            /*
-            fprintf(swap_file, "f %d//%d %d//%d %d//%d %d//%d\n",
-                    f.v_ids[0] + 1, 
-                    f.v_ids[0] + 1, 
-                    f.v_ids[1] + 1,
-                    f.v_ids[1] + 1,
-                    f.v_ids[2] + 1,
-                    f.v_ids[2] + 1,
-                    f.v_ids[3] + 1,
-                    f.v_ids[3] + 1);
-             */
-            fprintf(swap_file, "f %d %d %d %d\n",
-                    f.v_ids[0] + 1,
-                    f.v_ids[1] + 1,
-                    f.v_ids[2] + 1,
-                    f.v_ids[3] + 1);
-
-        }
-        else {
-            /*
-            fprintf(swap_file, "f %d//%d %d//%d %d//%d\n",
-                    f.v_ids[0] + 1, 
-                    f.v_ids[0] + 1, 
-                    f.v_ids[1] + 1,
-                    f.v_ids[1] + 1,
-                    f.v_ids[2] + 1,
-                    f.v_ids[2] + 1);
-            */
-            fprintf(swap_file, "f %d %d %d\n",
-                    f.v_ids[0] + 1,
-                    f.v_ids[1] + 1,
-                    f.v_ids[2] + 1 );
-        }
-    }
+    fputs(face_lines.c_str(), swap_file);
 
     debugl(2, "flushing / synching / closing obj_file\n");
 
@@ -2827,11 +2995,9 @@ MeshAlg::partialFlushToObjFile(
 
     /* remove original file, rename swap_file to original file, adjust FILE * reference in file_info */
     if ( remove( (filename + ".obj").c_str() ) != 0) {
-        debugTabDec();
         throw("MeshAlg::partialFlush(): can't remove old obj file before overwriting with swap file.");
     }
     if (rename( (swap_filename + ".obj").c_str(), (filename + ".obj").c_str() ) != 0) {
-        debugTabDec();
         throw("MeshAlg::partialFlush(): can't rename swap file to filename of obj file.");
     }
 
@@ -2839,54 +3005,12 @@ MeshAlg::partialFlushToObjFile(
     /* update file pointer in obj_file_info: reopen new obj file (moved swap file) in append mode and rewind() */
     FILE *tmp = fopen( (filename + ".obj").c_str(), "r+");
     if (!tmp) {
-        debugTabDec();
         throw("MeshAlg::partialFlush(): can't re-open obj file after having removed and overwritten old one with swap file.");
     }
     else {
         rewind(tmp);
         *(obj_file_info).first = tmp;
     }
-    
-    debugl(2, "finishing invariants ..\n");
-
-    /* write out_boundary_vertices for the caller: out_boundary_vertices is the union of new_boundary_vertices and all
-     * old boundary vertices that have not become isolated. since a boundary vertex can either stay a boundary vertex or
-     * become isolated (losing the boundary status) and no vertices have yet been deleted (and thus all pointers are
-     * still intact), it's possible to simply iterate over in_boundary_vertices and extract all vertices that have not
-     * become isolated.  note that the correct ids are copied as well: these are contained in in_boundary_vertices from
-     * the beginning of the call. */
-
-    /* copy in_boundary_vertices so as to enable the caller to use the same list for both references
-     * in_boundary_vertices and out_boundary_vertices */
-    auto in_boundary_vertices_copy = in_boundary_vertices;
-
-    /* initialize (and overwrite) out_boundary_vertices with new_boundary_vertices. this might also overwrite
-     * in_boundary_vertices if both references are identical. */
-    out_boundary_vertices = new_boundary_vertices;
-
-    /* handle input boundary vertices via copy. */
-    for (auto &ibv : in_boundary_vertices_copy) {
-        if (!ibv.first->isIsolated()) {
-            out_boundary_vertices.push_back(ibv);
-        }
-    }
-
-    /* sort */
-    out_boundary_vertices.sort(cmp);
-
-    /* delete all isolated vertices, old and new, from M. note that only old boundary vertices, which have become
-     * isolated during the call, are thereby deleted. no other boundary vertex is deleted, but they have been written to
-     * the obj file already to guarantee the invariant for the next flushing or the finalizing call. */
-    debugl(2, "deleting all new isolated vertices.\n");
-    debugTabInc();
-    for (auto &vp : isolated_vertices) {
-        debugl(3, "deleting isolated vertex %d.\n", vp.first->id());
-        M.vertices.erase(vp.first->iterator());
-    }
-    debugTabDec();
-
-    debugTabDec();
-    debugl(1, "MeshAlg::partialFlush(): done.\n");
 }
 
 template <typename Tm, typename Tv, typename Tf, typename R>
@@ -2897,17 +3021,22 @@ MeshAlg::partialFlushToObjFile(
     std::list<typename Mesh<Tm, Tv, Tf, R>::Face *>            &face_list)
 {
     /* check if info has been prepared */
-    if (!M_flush_info.obj_file) {
-        throw("MeshAlg::partialFlushToObjFile(): given obj flush info struct not properly initialized. file handle is NULL.");
+    if (!M_flush_info.writer) {
+        throw("MeshAlg::partialFlushToObjFile(): given obj flush info struct not properly initialized. writer is NULL.");
     }
 
-    /* call above overload version with full parameter list */
-    MeshAlg::partialFlushToObjFile<Tm, Tv, Tf, R>(
+    /* update the mesh and format the flushed part synchronously, then hand the lines to the background writer. the
+     * next neurite path can be merged while they are written. */
+    std::string vertex_lines, face_lines;
+    MeshAlg::partialFlushExtract<Tm, Tv, Tf, R>(
         M,
-        { &M_flush_info.obj_file, M_flush_info.filename },
         face_list,
         M_flush_info.last_boundary_vertices,
         M_flush_info.last_flush_vertex_id,
         M_flush_info.last_boundary_vertices,
-        M_flush_info.last_flush_vertex_id);
+        M_flush_info.last_flush_vertex_id,
+        vertex_lines,
+        face_lines);
+
+    M_flush_info.writer->push(std::move(vertex_lines), std::move(face_lines));
 }
@@ -60,7 +60,7 @@ template <typename Tm, typename Tv, typename Tf, typename R>
 Mesh<Tm, Tv, Tf, R>::Vertex::Vertex()
 {
     this->mesh                  = NULL;
-    this->position              = Aux::VecMat::nullvec<R>;
+    this->position              = Aux::VecMat::nullvec<R>();
     this->current_traversal_id  = 0;
     this->traversal_state       = TRAV_UNSEEN;
 }
@@ -141,6 +141,7 @@ Mesh<Tm, Tv, Tf, R>::Vertex::replaceAdjacentVertices(const std::map<Vertex *, Ve
     typename std::list<Vertex *>::iterator                   nbit;
     typename std::map<Vertex *, Vertex *>::const_iterator    mit;
 
+    this->mesh->checkpointTouch(this);
     for (nbit = this->adjacent_vertices.begin(); nbit != this->adjacent_vertices.end(); ++nbit) {
         /* if nb is is found in index change map, replace it */
         if ( (mit = replace_map.find(*nbit)) != replace_map.end() ) {
@@ -163,6 +164,7 @@ template <typename Tm, typename Tv, typename Tf, typename R>
 void
 Mesh<Tm, Tv, Tf, R>::Vertex::insertAdjacentVertex(Vertex *v)
 {
+    this->mesh->checkpointTouch(this);
     Aux::Alg::listSortedInsert(this->adjacent_vertices, v, true);
 }
 
@@ -170,6 +172,7 @@ template <typename Tm, typename Tv, typename Tf, typename R>
 bool
 Mesh<Tm, Tv, Tf, R>::Vertex::eraseAdjacentVertex(Vertex *v)
 {
+    this->mesh->checkpointTouch(this);
     return Aux::Alg::removeFirstOccurrenceFromList(this->adjacent_vertices, v);
 }
 
@@ -177,6 +180,7 @@ template <typename Tm, typename Tv, typename Tf, typename R>
 void
 Mesh<Tm, Tv, Tf, R>::Vertex::insertIncidentFace(Face *f)
 {
+    this->mesh->checkpointTouch(this);
     Aux::Alg::listSortedInsert(this->incident_faces, f, false);
 }
 
@@ -184,6 +188,7 @@ template <typename Tm, typename Tv, typename Tf, typename R>
 bool
 Mesh<Tm, Tv, Tf, R>::Vertex::eraseIncidentFace(Face *f)
 {
+    this->mesh->checkpointTouch(this);
     return Aux::Alg::removeFirstOccurrenceFromList(this->incident_faces, f);
 }
 
@@ -422,6 +427,9 @@ Mesh<Tm, Tv, Tf, R>::Face::replaceVertices(const std::map<Vertex *, Vertex*> &re
 {
     typename std::map<Vertex *, Vertex *>::const_iterator mit;
 
+    this->mesh->checkpointTouch(this);
+    this->mesh->faceIndexMarkDirty(this);
+
     /* for all four vertex pointers: if not NULL, search in replace_map and replace if found */
     for (int i = 0; i < 4; i++) {
         if (this->vertices[i]) {
@@ -1059,6 +1067,7 @@ void
 Mesh<Tm, Tv, Tf, R>::Face::invertOrientation()
 {
     this->checkTriQuad("Mesh::Face::invertOrientation()");
+    this->mesh->checkpointTouch(this);
 
     /* for triangles, vertices[3] contains NULL, reverse only first three elements of array */
     if (this->isTri()) {
@@ -1643,7 +1652,7 @@ Mesh<Tm, Tv, Tf, R>::Face::getTwoTrianglesCommonVertexAndRemainingVertices(
 
     auto vrtCmp = [] (const Vertex* x, const Vertex* y) -> bool {return (x->id() < y->id());};
     std::sort(A_vertices.begin(), A_vertices.end(), vrtCmp);
-    std::sort(B_vertices.begin(), B_vertices.end()), vrtCmp;
+    std::sort(B_vertices.begin(), B_vertices.end(), vrtCmp);
     std::set_intersection(
             A_vertices.begin(),
             A_vertices.end(),
@@ -1755,6 +1764,8 @@ Mesh<Tm, Tv, Tf, R>::Mesh() : vertices(*this) , faces(*this)
 {
     this->O                 = NULL;
     this->octree_updated    = false;
+    this->checkpoint        = NULL;
+    this->face_index        = NULL;
 }
 
 /* copy ctor */
@@ -1763,6 +1774,8 @@ Mesh<Tm, Tv, Tf, R>::Mesh(const Mesh &X) : vertices(*this), faces(*this) {
     /* default init */
     this->O                 = NULL;
     this->octree_updated    = false;
+    this->checkpoint        = NULL;
+    this->face_index        = NULL;
 
     /* use assignment operator. although this initializes all members with the default ctor and
      * immediately overwrites them again, this was deemed preferable to copying the code of
@@ -1867,6 +1880,10 @@ Mesh<Tm, Tv, Tf, R>::~Mesh()
         delete this->O;
     }
 
+    /* free vertices and faces kept alive by an active checkpoint */
+    this->discardCheckpoint();
+    this->disableFaceIndex();
+
     /* delete all allocated vertices */
     for (auto &v : this->vertices) {
         delete (&v);
@@ -1882,6 +1899,9 @@ template <typename Tm, typename Tv, typename Tf, typename R>
 void
 Mesh<Tm, Tv, Tf, R>::clear()
 {
+    /* implicitly commit an active checkpoint */
+    this->discardCheckpoint();
+
     /* delete all allocated vertices */
     for (auto &v : this->vertices) {
         delete (&v);
@@ -1907,12 +1927,27 @@ Mesh<Tm, Tv, Tf, R>::clear()
     }
     this->O                 = NULL;
     this->octree_updated    = false;
+
+    /* empty face index, which stays enabled */
+    if (this->face_index) {
+        this->face_index->cells.clear();
+        this->face_index->face_cells.clear();
+        this->face_index->dirty_faces.clear();
+    }
 }
 
 template <typename Tm, typename Tv, typename Tf, typename R>
 void
 Mesh<Tm, Tv, Tf, R>::clearFaces()
 {
+    this->discardCheckpoint();
+
+    if (this->face_index) {
+        this->face_index->cells.clear();
+        this->face_index->face_cells.clear();
+        this->face_index->dirty_faces.clear();
+    }
+
     /* delete all allocated faces */
     for (auto &f : this->faces) {
         delete (&f);
@@ -1941,6 +1976,9 @@ Mesh<Tm, Tv, Tf, R>::renumberConsecutively(
     debugl(2, "Mesh::renumberConsecutively(): vertex_start_id: %5d, face_start_id: %5d.\n", vertex_start_id, face_start_id);
     debugTabInc();
 
+    /* ids change, an active checkpoint could not be rolled back any more */
+    this->discardCheckpoint();
+
     /* renumber indices of vertices and faces in a consecutive fashion. since the internal maps
      * Mesh::V and Mesh::E store pointers to the data, the data itself is not touched by
      * manipulation of these maps and hence all topological information inside Vertex and Face
@@ -2132,6 +2170,32 @@ Mesh<Tm, Tv, Tf, R>::getBoundingBox() const
     }
 }
 
+template <typename Tm, typename Tv, typename Tf, typename R>
+size_t
+Mesh<Tm, Tv, Tf, R>::estimateMemoryUsage() const
+{
+    /* node sizes of std::map<uint32_t, T *>, std::list<T *> and std::unordered_map<Face *, ..> (libstdc++) */
+    size_t const map_node       = 4 * sizeof(void *) + sizeof(std::pair<uint32_t, void *>);
+    size_t const list_node      = 3 * sizeof(void *);
+    size_t const hash_node      = 2 * sizeof(void *) + sizeof(std::pair<Face *, std::array<int32_t, 6>>);
+
+    size_t const nv             = this->V.size();
+    size_t const nf             = this->F.size();
+
+    /* every edge appears in two adjacency lists, every face in at most four incidence lists */
+    size_t bytes =
+        nv * (sizeof(Vertex) + map_node) +
+        nf * (sizeof(Face) + map_node) +
+        2 * (nv + nf) * list_node +
+        4 * nf * list_node;
+
+    if (this->face_index) {
+        bytes += nf * (hash_node + 2 * sizeof(Face *));
+    }
+
+    return bytes;
+}
+
 template <typename Tm, typename Tv, typename Tf, typename R>
 void
 Mesh<Tm, Tv, Tf, R>::invertOrientation()
@@ -2251,6 +2315,7 @@ Mesh<Tm, Tv, Tf, R>::moveAppend(
             v           = v_newit->second;
             v->mesh     = this;
             v->m_vit    = v_newit;
+            this->checkpointCreated(v);
 
             /* erase B_vit from B.V */
             B_vit       = B.V.erase(B_vit); 
@@ -2285,6 +2350,8 @@ Mesh<Tm, Tv, Tf, R>::moveAppend(
             f           = f_newit->second;
             f->mesh     = this;
             f->m_fit    = f_newit;
+            this->checkpointCreated(f);
+            this->faceIndexMarkDirty(f);
             B_fit       = B.F.erase(B_fit); 
         }
     }
@@ -2314,6 +2381,55 @@ Mesh<Tm, Tv, Tf, R>::moveAppend(
     debugTabDec();
 }
 
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::moveAppend(std::vector<Mesh<Tm, Tv, Tf, R>> &Bs)
+{
+    debugl(2, "Mesh::moveAppend(): bulk append of %zu meshes.\n", Bs.size());
+    debugTabInc();
+
+    size_t nv = 0, nf = 0;
+    for (auto &B : Bs) {
+        if (&B == this) {
+            debugTabDec();
+            throw MeshEx(MESH_LOGIC_ERROR, "Mesh::moveAppend(): attempting to append mesh to itself.");
+        }
+        nv += B.V.size();
+        nf += B.F.size();
+    }
+
+    /* reserve one block of fresh ids for all vertices and faces. all ids in the blocks are larger than any id
+     * currently in use, hence every insertion below happens at the end of the respective map. */
+    uint32_t v_id = this->V_idq.getIdBlock(nv);
+    uint32_t f_id = this->F_idq.getIdBlock(nf);
+
+    for (auto &B : Bs) {
+        for (auto &B_v : B.V) {
+            Vertex *v   = B_v.second;
+            v->mesh     = this;
+            v->m_vit    = this->V.insert(this->V.end(), { v_id++, VertexPointerType(v) });
+            this->checkpointCreated(v);
+        }
+        for (auto &B_f : B.F) {
+            Face *f     = B_f.second;
+            f->mesh     = this;
+            f->m_fit    = this->F.insert(this->F.end(), { f_id++, FacePointerType(f) });
+            this->checkpointCreated(f);
+            this->faceIndexMarkDirty(f);
+        }
+
+        /* all pointers have been moved to (this) mesh. drop them from B before clearing it, which would otherwise
+         * delete the moved vertices and faces. */
+        B.V.clear();
+        B.F.clear();
+        B.clear();
+    }
+
+    this->octree_updated    = false;
+
+    debugTabDec();
+}
+
 template <typename Tm, typename Tv, typename Tf, typename R>
 void
 Mesh<Tm, Tv, Tf, R>::deleteConnectedComponent(vertex_iterator vstart_it)
@@ -2828,7 +2944,7 @@ Mesh<Tm, Tv, Tf, R>::find(
         }
 
         face_list->sort([] (const Face* x, const Face* y) -> bool {return (x->id() < y->id());});
-        face_list->unique([] (const Vertex* x, const Vertex* y) -> bool {return (x->id() == y->id());});
+        face_list->unique([] (const Face* x, const Face* y) -> bool {return (x->id() == y->id());});
 
         /* delete faces whose bounding box does not intersect the given search box */
         for (auto it = face_list->begin(); it != face_list->end(); ) {
@@ -3113,7 +3229,7 @@ Mesh<Tm, Tv, Tf, R>::getOctreeLeafCubes(
 
 template <typename Tm, typename Tv, typename Tf, typename R>
 void
-Mesh<Tm, Tv, Tf, R>::selectNonManifoldVertices(std::list<Vertex *> &vlist) const
+Mesh<Tm, Tv, Tf, R>::selectNonManifoldVertices(std::list<Vertex *> &vlist)
 {
     for (auto &v : this->vertices) {
         if (!v.isManifold()) {
@@ -3124,10 +3240,10 @@ Mesh<Tm, Tv, Tf, R>::selectNonManifoldVertices(std::list<Vertex *> &vlist) const
 
 template <typename Tm, typename Tv, typename Tf, typename R>
 void
-Mesh<Tm, Tv, Tf, R>::selectIsolatedVertices(std::list<Vertex *> &vlist) const
+Mesh<Tm, Tv, Tf, R>::selectIsolatedVertices(std::list<Vertex *> &vlist)
 {
     for (auto &v : this->vertices) {
-        if (!v.isIsolated()) {
+        if (v.isIsolated()) {
             vlist.push_back(&v);
         }
     }
@@ -3558,13 +3674,425 @@ Mesh<Tm, Tv, Tf, R>::getSharedTri(
     else return f->iterator();
 }
 
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::checkpointTouch(Vertex *v)
+{
+    /* store state of pre-existing vertex on first modification only */
+    if (this->checkpoint && this->checkpoint->created_vertices.find(v) == this->checkpoint->created_vertices.end()) {
+        auto &touched   = this->checkpoint->touched_vertices;
+        auto tit        = touched.lower_bound(v);
+        if (tit == touched.end() || tit->first != v) {
+            touched.insert(tit, { v, { v->position, v->adjacent_vertices, v->incident_faces } });
+        }
+    }
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::checkpointTouch(Face *f)
+{
+    if (this->checkpoint && this->checkpoint->created_faces.find(f) == this->checkpoint->created_faces.end()) {
+        auto &touched   = this->checkpoint->touched_faces;
+        auto tit        = touched.lower_bound(f);
+        if (tit == touched.end() || tit->first != f) {
+            touched.insert(tit, { f, { f->vertices, (bool)f->quad } });
+        }
+    }
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::checkpointCreated(Vertex *v)
+{
+    if (this->checkpoint) {
+        this->checkpoint->created_vertices.insert(v);
+    }
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::checkpointCreated(Face *f)
+{
+    if (this->checkpoint) {
+        this->checkpoint->created_faces.insert(f);
+    }
+}
+
+/* NOTE: must be called while the vertex is still contained in this->V, since its id is recorded. */
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::checkpointErased(Vertex *v)
+{
+    /* vertices created and erased again during the checkpoint are simply deallocated on commit /
+     * rollback, pre-existing ones are re-inserted with their original id on rollback. */
+    if (this->checkpoint->created_vertices.erase(v)) {
+        this->checkpoint->dead_vertices.push_back(v);
+    }
+    else {
+        this->checkpoint->erased_vertices.push_back( { v->id(), v } );
+    }
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::checkpointErased(Face *f)
+{
+    if (this->checkpoint->created_faces.erase(f)) {
+        this->checkpoint->dead_faces.push_back(f);
+    }
+    else {
+        this->checkpoint->erased_faces.push_back( { f->id(), f } );
+    }
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::discardCheckpoint()
+{
+    if (!this->checkpoint) {
+        return;
+    }
+
+    /* deallocate all vertices / faces that have been erased during the checkpoint */
+    for (auto v : this->checkpoint->dead_vertices) {
+        delete v;
+    }
+    for (auto &vp : this->checkpoint->erased_vertices) {
+        delete vp.second;
+    }
+    for (auto f : this->checkpoint->dead_faces) {
+        delete f;
+    }
+    for (auto &fp : this->checkpoint->erased_faces) {
+        delete fp.second;
+    }
+
+    delete this->checkpoint;
+    this->checkpoint = NULL;
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::beginCheckpoint()
+{
+    if (this->checkpoint) {
+        throw MeshEx(MESH_LOGIC_ERROR, "Mesh::beginCheckpoint(): checkpoint already active.");
+    }
+
+    this->checkpoint        = new Mesh_Checkpoint();
+    this->checkpoint->V_idq = this->V_idq;
+    this->checkpoint->F_idq = this->F_idq;
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::commitCheckpoint()
+{
+    if (!this->checkpoint) {
+        throw MeshEx(MESH_LOGIC_ERROR, "Mesh::commitCheckpoint(): no active checkpoint.");
+    }
+    this->discardCheckpoint();
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::rollbackCheckpoint()
+{
+    if (!this->checkpoint) {
+        throw MeshEx(MESH_LOGIC_ERROR, "Mesh::rollbackCheckpoint(): no active checkpoint.");
+    }
+
+    debugl(2, "Mesh::rollbackCheckpoint(): created: %d vertices, %d faces. erased: %d vertices, %d faces. modified: %d vertices, %d faces.\n",
+        this->checkpoint->created_vertices.size(), this->checkpoint->created_faces.size(),
+        this->checkpoint->erased_vertices.size(), this->checkpoint->erased_faces.size(),
+        this->checkpoint->touched_vertices.size(), this->checkpoint->touched_faces.size());
+    debugTabInc();
+
+    /* detach undo log, so that no hooks fire during restoration */
+    Mesh_Checkpoint *cp = this->checkpoint;
+    this->checkpoint    = NULL;
+
+    /* remove all vertices / faces created during the checkpoint that are still contained in the
+     * mesh and deallocate them together with the ones that have already been erased again. */
+    for (auto f : cp->created_faces) {
+        this->faceIndexErase(f);
+        this->F.erase(f->m_fit);
+        delete f;
+    }
+    for (auto f : cp->dead_faces) {
+        delete f;
+    }
+    for (auto v : cp->created_vertices) {
+        this->V.erase(v->m_vit);
+        delete v;
+    }
+    for (auto v : cp->dead_vertices) {
+        delete v;
+    }
+
+    /* re-insert erased pre-existing vertices / faces with their original ids */
+    for (auto &vp : cp->erased_vertices) {
+        auto rpair = this->V.insert( { vp.first, VertexPointerType(vp.second) } );
+        if (!rpair.second) {
+            debugTabDec();
+            throw MeshEx(MESH_LOGIC_ERROR, "Mesh::rollbackCheckpoint(): id of erased vertex already taken. internal logic error.");
+        }
+        vp.second->m_vit = rpair.first;
+    }
+    for (auto &fp : cp->erased_faces) {
+        auto rpair = this->F.insert( { fp.first, FacePointerType(fp.second) } );
+        if (!rpair.second) {
+            debugTabDec();
+            throw MeshEx(MESH_LOGIC_ERROR, "Mesh::rollbackCheckpoint(): id of erased face already taken. internal logic error.");
+        }
+        fp.second->m_fit = rpair.first;
+        this->faceIndexMarkDirty(fp.second);
+    }
+
+    /* restore state of all modified pre-existing vertices / faces */
+    for (auto &vs : cp->touched_vertices) {
+        Vertex *v   = vs.first;
+        bool moved  = (v->position != vs.second.position);
+        v->position = vs.second.position;
+        v->adjacent_vertices.swap(vs.second.adjacent_vertices);
+        v->incident_faces.swap(vs.second.incident_faces);
+        if (moved) {
+            for (auto f : v->incident_faces) {
+                this->faceIndexMarkDirty(f);
+            }
+        }
+    }
+    for (auto &fs : cp->touched_faces) {
+        Face *f     = fs.first;
+        f->vertices = fs.second.vertices;
+        f->quad     = fs.second.quad;
+        this->faceIndexMarkDirty(f);
+    }
+
+    /* restore id queues */
+    this->V_idq             = cp->V_idq;
+    this->F_idq             = cp->F_idq;
+
+    delete cp;
+
+    /* mesh octree needs update */
+    this->octree_updated    = false;
+
+    debugTabDec();
+    debugl(2, "Mesh::rollbackCheckpoint(): done.\n");
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+bool
+Mesh<Tm, Tv, Tf, R>::checkpointActive() const
+{
+    return (this->checkpoint != NULL);
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::faceIndexMarkDirty(Face *f)
+{
+    if (this->face_index) {
+        this->face_index->dirty_faces.insert(f);
+    }
+}
+
+/* NOTE: must be called before f is deallocated, since it is removed from all registered cells. */
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::faceIndexErase(Face *f)
+{
+    if (!this->face_index) {
+        return;
+    }
+
+    this->face_index->dirty_faces.erase(f);
+
+    auto fcit = this->face_index->face_cells.find(f);
+    if (fcit != this->face_index->face_cells.end()) {
+        std::array<int32_t, 6> const &r = fcit->second;
+        for (int32_t i = r[0]; i <= r[3]; i++) {
+            for (int32_t j = r[1]; j <= r[4]; j++) {
+                for (int32_t k = r[2]; k <= r[5]; k++) {
+                    auto cell_it = this->face_index->cells.find(this->faceIndexKey(i, j, k));
+                    if (cell_it != this->face_index->cells.end()) {
+                        std::vector<Face *> &cell = cell_it->second;
+                        auto cit = std::find(cell.begin(), cell.end(), f);
+                        if (cit != cell.end()) {
+                            *cit = cell.back();
+                            cell.pop_back();
+                        }
+                        if (cell.empty()) {
+                            this->face_index->cells.erase(cell_it);
+                        }
+                    }
+                }
+            }
+        }
+        this->face_index->face_cells.erase(fcit);
+    }
+}
+
+/* (re-)register all dirty faces */
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::faceIndexUpdate()
+{
+    std::vector<Face *> dirty(this->face_index->dirty_faces.begin(), this->face_index->dirty_faces.end());
+
+    for (auto f : dirty) {
+        this->faceIndexErase(f);
+
+        std::array<int32_t, 6> r = this->faceIndexCellRange(f->getBoundingBox());
+        for (int32_t i = r[0]; i <= r[3]; i++) {
+            for (int32_t j = r[1]; j <= r[4]; j++) {
+                for (int32_t k = r[2]; k <= r[5]; k++) {
+                    this->face_index->cells[this->faceIndexKey(i, j, k)].push_back(f);
+                }
+            }
+        }
+        this->face_index->face_cells[f] = r;
+    }
+    this->face_index->dirty_faces.clear();
+}
+
+/* pack integral cell coordinates, which are offset into [0, 2^21[, into one 64 bit key. */
+template <typename Tm, typename Tv, typename Tf, typename R>
+uint64_t
+Mesh<Tm, Tv, Tf, R>::faceIndexKey(int32_t i, int32_t j, int32_t k) const
+{
+    uint64_t const  offset  = 1u << 20;
+    uint64_t const  mask    = (1u << 21) - 1;
+
+    return ( (((uint64_t)i + offset) & mask) << 42 ) | ( (((uint64_t)j + offset) & mask) << 21 ) | (((uint64_t)k + offset) & mask);
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+std::array<int32_t, 6>
+Mesh<Tm, Tv, Tf, R>::faceIndexCellRange(BoundingBox<R> const &box) const
+{
+    /* clamp to the range representable in faceIndexKey() */
+    R const lim = (R)((1 << 20) - 1);
+    auto cellCoord = [&] (R x) -> int32_t {
+        return (int32_t)std::max(-lim, std::min(lim, std::floor(x / this->face_index->cell_len)));
+    };
+
+    Vec3<R> const bmin = box.min(), bmax = box.max();
+    return {{ cellCoord(bmin[0]), cellCoord(bmin[1]), cellCoord(bmin[2]),
+              cellCoord(bmax[0]), cellCoord(bmax[1]), cellCoord(bmax[2]) }};
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::enableFaceIndex(R cell_len)
+{
+    if (cell_len <= 0) {
+        R       ext_sum = 0;
+        for (auto &f : this->faces) {
+            auto f_bb   = f.getBoundingBox();
+            Vec3<R> d   = f_bb.max() - f_bb.min();
+            ext_sum    += std::max(d[0], std::max(d[1], d[2]));
+        }
+        cell_len = (this->numFaces() > 0 && ext_sum > 0) ? 2.0 * ext_sum / (R)this->numFaces() : 1.0;
+    }
+
+    this->disableFaceIndex();
+    this->face_index            = new Mesh_FaceIndex();
+    this->face_index->cell_len  = cell_len;
+    this->invalidateFaceIndex();
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::disableFaceIndex()
+{
+    if (this->face_index) {
+        delete this->face_index;
+        this->face_index = NULL;
+    }
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+bool
+Mesh<Tm, Tv, Tf, R>::faceIndexEnabled() const
+{
+    return (this->face_index != NULL);
+}
+
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::invalidateFaceIndex()
+{
+    if (this->face_index) {
+        this->face_index->cells.clear();
+        this->face_index->face_cells.clear();
+        this->face_index->dirty_faces.clear();
+        for (auto &f : this->faces) {
+            this->face_index->dirty_faces.insert(&f);
+        }
+    }
+}
+
+/* find all faces whose bounding box intersects search_box, sorted by id. */
+template <typename Tm, typename Tv, typename Tf, typename R>
+void
+Mesh<Tm, Tv, Tf, R>::findFacesIndexed(
+    BoundingBox<R> const   &search_box,
+    std::vector<Face *>    &face_list)
+{
+    if (!this->face_index) {
+        throw MeshEx(MESH_LOGIC_ERROR, "Mesh::findFacesIndexed(): face index not enabled.");
+    }
+
+    face_list.clear();
+    this->faceIndexUpdate();
+
+    /* visit all cells in range, unless there are fewer non-empty cells in total */
+    std::array<int32_t, 6> r    = this->faceIndexCellRange(search_box);
+    uint64_t range_cells        = (uint64_t)(r[3] - r[0] + 1) * (uint64_t)(r[4] - r[1] + 1) * (uint64_t)(r[5] - r[2] + 1);
+
+    if (range_cells <= this->face_index->cells.size()) {
+        for (int32_t i = r[0]; i <= r[3]; i++) {
+            for (int32_t j = r[1]; j <= r[4]; j++) {
+                for (int32_t k = r[2]; k <= r[5]; k++) {
+                    auto cit = this->face_index->cells.find(this->faceIndexKey(i, j, k));
+                    if (cit != this->face_index->cells.end()) {
+                        face_list.insert(face_list.end(), cit->second.begin(), cit->second.end());
+                    }
+                }
+            }
+        }
+    }
+    else {
+        for (auto &fc : this->face_index->face_cells) {
+            std::array<int32_t, 6> const &fr = fc.second;
+            if (fr[0] <= r[3] && fr[3] >= r[0] && fr[1] <= r[4] && fr[4] >= r[1] && fr[2] <= r[5] && fr[5] >= r[2]) {
+                face_list.push_back(fc.first);
+            }
+        }
+    }
+
+    auto byId = [] (const Face *x, const Face *y) -> bool { return (x->id() < y->id()); };
+    std::sort(face_list.begin(), face_list.end(), byId);
+    face_list.erase(std::unique(face_list.begin(), face_list.end()), face_list.end());
+
+    /* drop faces from the cells in range whose bounding box does not intersect the search box */
+    face_list.erase(
+        std::remove_if(face_list.begin(), face_list.end(), [&] (const Face *f) -> bool { return !(search_box && f->getBoundingBox()); }),
+        face_list.end());
+}
+
 template <typename Tm, typename Tv, typename Tf, typename R>
 void
 Mesh<Tm, Tv, Tf, R>::scale(R const &r)
 {
     for (auto &v : this->vertices) {
+        this->checkpointTouch(&v);
         v.pos() *= r;
     }
+    this->invalidateFaceIndex();
 }
 
 template <typename Tm, typename Tv, typename Tf, typename R>
@@ -3572,8 +4100,10 @@ void
 Mesh<Tm, Tv, Tf, R>::translate(Vec3<R> const &d)
 {
     for (auto &v : this->vertices) {
+        this->checkpointTouch(&v);
         v.pos() += d;
     }
+    this->invalidateFaceIndex();
 }
 
 template <typename Tm, typename Tv, typename Tf, typename R>
@@ -3991,6 +4521,10 @@ Mesh<Tm, Tv, Tf, R>::collapseTriEdge(
         debugl(3, "created new vertex w with id %5d and pos (%5.4f, %5.4f, %5.4f)\n",
                 w_it->id(), w_pos[0], w_pos[1], w_pos[2]);
 
+        /* adjacency / incidence lists of u and v are modified directly below */
+        this->checkpointTouch(&(*u_it));
+        this->checkpointTouch(&(*v_it));
+
         /* the new vertex w is incident to all faces that u and v were incident to, excluding the
          * two deleted ones, which have already been deleted. similarly, as adjacent vertices, w has
          * all neighbours of u and v combined, again excluding the neighbour relations from the old
@@ -4120,6 +4654,10 @@ Mesh<Tm, Tv, Tf, R>::mergeUnrelatedVertices(
 
     Mesh::vertex_iterator w_it = this->vertices.insert(w_pos);
 
+    /* adjacency / incidence lists of u and v are modified directly below */
+    this->checkpointTouch(&(*u_it));
+    this->checkpointTouch(&(*v_it));
+
     /* manually copy adjacent_vertices and incident from both u and v to w and clear info inside u
      * and v. */
     w_it->adjacent_vertices = u_it->adjacent_vertices;
@@ -4754,7 +5292,9 @@ Mesh<Tm, Tv, Tf, R>::readFromObjFile(const char *filename)
 
 template <typename Tm, typename Tv, typename Tf, typename R>
 void
-Mesh<Tm, Tv, Tf, R>::writeObjFile(const char *jobname)
+Mesh<Tm, Tv, Tf, R>::writeObjFile(
+    const char     *jobname,
+    uint32_t        nthreads)
 {
     debugl(4, "Mesh::writeObjFile(): writing mesh as obj to outfile \"%s\".\n", jobname);
     debugTabInc();
@@ -4762,6 +5302,23 @@ Mesh<Tm, Tv, Tf, R>::writeObjFile(const char *jobname)
     /* renumber vertices */
     this->renumberConsecutively();
 
+    /* collect vertices and faces for random access. faces are checked here, since formatting may happen on worker
+     * threads, which must not throw. */
+    std::vector<Vertex const *> vs;
+    std::vector<Face const *>   fs;
+    vs.reserve(this->V.size());
+    fs.reserve(this->F.size());
+    for (auto &v : this->vertices) {
+        vs.push_back(&v);
+    }
+    for (auto &f : this->faces) {
+        if (!f.isQuad() && !f.isTri()) {
+            debugTabDec();
+            throw MeshEx(MESH_LOGIC_ERROR, "Mesh::writeObjFile(): discovered face that is neither triangle nor quad. internal logic error.");
+        }
+        fs.push_back(&f);
+    }
+
     char obj_filename[512];
     snprintf(obj_filename, 512, "%s.obj", jobname);
     FILE *outfile = fopen(obj_filename, "w");
@@ -4771,6 +5328,39 @@ Mesh<Tm, Tv, Tf, R>::writeObjFile(const char *jobname)
         throw("Mesh::writeObjFile(): can't open output file for writing.");
     }
 
+    /* write the lines of a section of n elements: the section is split into chunks of lines, which are formatted
+     * into separate buffers on nthreads threads and written to outfile in order. at most a fixed number of chunks per
+     * thread is buffered at any time. */
+    nthreads = std::max(nthreads, 1u);
+    auto writeSection = [&] (size_t n, std::function<int(size_t, char *, size_t)> const &formatLine) -> void {
+        size_t const    chunk_size      = 8192;
+        size_t const    nchunks         = (n + chunk_size - 1) / chunk_size;
+        size_t const    round_chunks    = 4 * nthreads;
+
+        std::vector<std::string> buffers(std::min(nchunks, round_chunks));
+
+        for (size_t round_begin = 0; round_begin < nchunks; round_begin += round_chunks) {
+            size_t const round_end = std::min(nchunks, round_begin + round_chunks);
+
+            Aux::Parallel::forEachIndex(round_end - round_begin, nthreads,
+                [&] (size_t k, uint32_t) -> void {
+                    char            line[256];
+                    size_t const    c   = round_begin + k;
+                    std::string    &buf = buffers[k];
+
+                    buf.clear();
+                    for (size_t i = c * chunk_size; i < std::min(n, (c + 1) * chunk_size); i++) {
+                        buf.append(line, formatLine(i, line, sizeof(line)));
+                    }
+                });
+
+            for (size_t c = round_begin; c < round_end; c++) {
+                std::string const &buf = buffers[c - round_begin];
+                fwrite(buf.data(), 1, buf.size(), outfile);
+            }
+        }
+    };
+
     fprintf(outfile, "# obj file automatically generated by AnaMorph for jobname: \"%s\".\n", jobname);
     fprintf(outfile, "o %s\n", jobname);
 
@@ -4778,17 +5368,11 @@ Mesh<Tm, Tv, Tf, R>::writeObjFile(const char *jobname)
     fprintf(outfile, "\n# %15ld vertices.\n", this->V.size());
 
     debugl(4, "writing %15ld vertices..\n", this->vertices.size());
-    debugTabInc();
-
-    Vec3<R> vpos;
-    for (auto &v : this->vertices) {
-        vpos = v.pos();
-        debugl(5, "writing vertex %5d..\n", v.id());
-        vpos.print_debugl(5);
-        fprintf(outfile, "v %+.10e %+.10e %+.10e\n", vpos[0], vpos[1], vpos[2]);
-    }
 
-    debugTabDec();
+    writeSection(vs.size(), [&] (size_t i, char *line, size_t len) -> int {
+            Vec3<R> vpos = vs[i]->pos();
+            return snprintf(line, len, "v %+.10e %+.10e %+.10e\n", vpos[0], vpos[1], vpos[2]);
+        });
 
     /* write a dummy texture coordinate to increase compatability with the somewhat ill-defined
      * wavefront format. some readers don't accept empty texture coordinates */
@@ -4799,69 +5383,47 @@ Mesh<Tm, Tv, Tf, R>::writeObjFile(const char *jobname)
     //fprintf(outfile, "\n# %15ld face normals.\n", this->faces.size());
 
     debugl(4, "writing %15ld face normals..\n", this->faces.size());
-    debugTabInc();
 
     // vertex normals, for whatever reason they may be needed
-    Vec3<R> n;
-    for (auto &v : this->vertices) {
-        debugl(5, "writing vertex normal %5d..\n", v.id());
-        const std::list<typename Mesh<Tm, Tv, Tf, R>::Face*>& faceStar = v.getFaceStar();
-        n.assign((R)0);
-        for (auto f : faceStar)
-            n += f->getNormal();
-        n.normalize();
-        fprintf(outfile, "vn %+.10e %+.10e %+.10e\n", n[0], n[1], n[2]);
-    }
-
-    debugTabDec();
+    writeSection(vs.size(), [&] (size_t i, char *line, size_t len) -> int {
+            Vec3<R> n;
+            n.assign((R)0);
+            for (auto f : vs[i]->getFaceStar())
+                n += f->getNormal();
+            n.normalize();
+            return snprintf(line, len, "vn %+.10e %+.10e %+.10e\n", n[0], n[1], n[2]);
+        });
 
     /* newline, comment and then all faces */
     fprintf(outfile, "\n# %15ld faces.\n", this->F.size() );
 
     debugl(4, "writing %15ld faces..\n", this->faces.size());
-    debugTabInc();
 
-    uint32_t v0_id, v1_id, v2_id, v3_id;
-    for (auto &f: this->faces) {
-        if (f.isQuad()) {
-            f.getQuadIndices(v0_id, v1_id, v2_id, v3_id);
-            fprintf(outfile, "f %u//%u %u//%u %u//%u %u//%u\n",
-                    v0_id + 1, 
-                    v0_id + 1, 
-                    v1_id + 1,
-                    v1_id + 1,
-                    v2_id + 1,
-                    v2_id + 1,
-                    v3_id + 1,
-                    v3_id + 1);
-
-            debugl(5, "quad  %u/%u/%u/%u\n",
-                    v0_id, 
-                    v1_id,
-                    v2_id,
-                    v3_id);
-        }
-        else if (f.isTri()) {
-            f.getTriIndices(v0_id, v1_id, v2_id);
-            fprintf(outfile, "f %u//%u %u//%u %u//%u\n",
-                    v0_id + 1, 
-                    v0_id + 1, 
-                    v1_id + 1,
-                    v1_id + 1,
-                    v2_id + 1,
-                    v2_id + 1);
-
-            debugl(5, "tri  %u/%u/%u/\n",
-                    v0_id, 
-                    v1_id,
-                    v2_id);
-        }
-        else {
-            fclose(outfile);
-            throw MeshEx(MESH_LOGIC_ERROR, "Mesh::writeObjFile(): discovered face that is neither triangle nor quad. internal logic error.");
-        }
-    }
-    debugTabDec();
+    writeSection(fs.size(), [&] (size_t i, char *line, size_t len) -> int {
+            uint32_t v0_id, v1_id, v2_id, v3_id;
+            if (fs[i]->isQuad()) {
+                fs[i]->getQuadIndices(v0_id, v1_id, v2_id, v3_id);
+                return snprintf(line, len, "f %u//%u %u//%u %u//%u %u//%u\n",
+                        v0_id + 1, 
+                        v0_id + 1, 
+                        v1_id + 1,
+                        v1_id + 1,
+                        v2_id + 1,
+                        v2_id + 1,
+                        v3_id + 1,
+                        v3_id + 1);
+            }
+            else {
+                fs[i]->getTriIndices(v0_id, v1_id, v2_id);
+                return snprintf(line, len, "f %u//%u %u//%u %u//%u\n",
+                        v0_id + 1, 
+                        v0_id + 1, 
+                        v1_id + 1,
+                        v1_id + 1,
+                        v2_id + 1,
+                        v2_id + 1);
+            }
+        });
 
     fclose(outfile);
 
@@ -4961,6 +5523,7 @@ Mesh<Tm, Tv, Tf, R>::VertexAccessor::insert(const Vec3<R> &vpos)
          * vertex into a consistent state. */
         vit                         = pair.first;
         v->m_vit                    = vit;
+        this->mesh.checkpointCreated(v);
 
         /* mesh octree needs update */
         this->mesh.octree_updated   = false;
@@ -5001,8 +5564,14 @@ Mesh<Tm, Tv, Tf, R>::VertexAccessor::erase(vertex_iterator it)
     this->mesh.V_idq.freeId(it->id());
 
     debugl(4, "deleting (deallocating) vertex object..\n");
-    /* delete allocated vertex object */
-    delete &(*it);
+    /* delete allocated vertex object. if a checkpoint is active, the undo log takes ownership
+     * instead. */
+    if (this->mesh.checkpoint) {
+        this->mesh.checkpointErased(&(*it));
+    }
+    else {
+        delete &(*it);
+    }
 
     /* mesh octree needs update */
     this->mesh.octree_updated = false;
@@ -5190,6 +5759,8 @@ Mesh<Tm, Tv, Tf, R>::FaceAccessor::insert(
     /* set Face::m_fit iterator, which is required for Face to be in a consistent state and has not
      * been set by the (private) Face ctor, just as for Mesh::Vertex */
     tri->m_fit  = rpair.first;
+    this->mesh.checkpointCreated(tri);
+    this->mesh.faceIndexMarkDirty(tri);
 
     /* vertex ids can be in adjacent_vertices multiple times, for two vertices can be an edge of two
      * incident faces. when getAdjacentIndices/Vertices() is called, the unique() list is computed.
@@ -5282,6 +5853,8 @@ Mesh<Tm, Tv, Tf, R>::FaceAccessor::insert(
     /* set Face::m_fit iterator, which is required for Face to be in a consistent state and has not
      * been set by the (private) Face ctor, just as for Mesh::Vertex */
     quad->m_fit = rpair.first;
+    this->mesh.checkpointCreated(quad);
+    this->mesh.faceIndexMarkDirty(quad);
 
     /* topology information update */
     v0->insertAdjacentVertex(v3);
@@ -5417,8 +5990,15 @@ Mesh<Tm, Tv, Tf, R>::FaceAccessor::erase(face_iterator it)
     /* free face_id */
     this->mesh.F_idq.freeId( it->id() );
 
-    /* delete allocated face object */
-    delete &(*it);
+    this->mesh.faceIndexErase(f);
+
+    /* delete allocated face object, unless owned by the undo log of an active checkpoint */
+    if (this->mesh.checkpoint) {
+        this->mesh.checkpointErased(f);
+    }
+    else {
+        delete &(*it);
+    }
 
     /* mesh octree needs update */
     this->mesh.octree_updated = false;
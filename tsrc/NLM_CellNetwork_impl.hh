@@ -280,7 +280,9 @@ namespace NLM {
                     std::vector<R>,
                     R
                 >(NLM::NeuritePath<R> const &P)
-            >  const                       &parametrization_algorithm)
+            >  const                       &parametrization_algorithm,
+        Aux::Numerics::SplineSystemWorkspace<R, 3>
+                                           *spline_ws)
     {
         using Aux::Numbers::inf;
         using Aux::VecMat::onesVec3;
@@ -292,25 +294,25 @@ namespace NLM {
         /* set m to the number of segments on the path */
         uint32_t const m = this->neurite_segments.size();
 
-        /* to compute all neurite canal segments, solve the spline system for all three space components {x,y,z}, the data
-         * for which is extracted from all neurite vertices into the vectors {x,y,z}_components. */
-        std::vector<R> vertex_position_components[3], result_powercoeff[3];
-        for (uint32_t j = 0; j < 3; j++) {
-            vertex_position_components[j].assign(m + 1, 0);
-        }
+        /* to compute all neurite canal segments, solve the spline systems for all three space components {x,y,z} at
+         * once. the data is extracted from all neurite vertices into ws.x, interleaved by component. */
+        Aux::Numerics::SplineSystemWorkspace<R, 3>  local_ws;
+        Aux::Numerics::SplineSystemWorkspace<R, 3> &ws = spline_ws ? *spline_ws : local_ws;
+
+        ws.x.resize(3*(m + 1));
 
         /* store coordinates of source vertex of first neurite segments */
         Vec3<R> npos = this->neurite_segments.front()->getSourceVertex()->getPosition();
-        vertex_position_components[0][0] = npos[0];
-        vertex_position_components[1][0] = npos[1];
-        vertex_position_components[2][0] = npos[2];
+        ws.x[0] = npos[0];
+        ws.x[1] = npos[1];
+        ws.x[2] = npos[2];
 
         /* iterator over all neurite segments and handle destination vertices */
         for (uint32_t i = 1; i < m + 1; i++) {
             npos = this->neurite_segments[i - 1]->getDestinationVertex()->getPosition();
-            vertex_position_components[0][i] = npos[0];
-            vertex_position_components[1][i] = npos[1];
-            vertex_position_components[2][i] = npos[2];
+            ws.x[3*i    ] = npos[0];
+            ws.x[3*i + 1] = npos[1];
+            ws.x[3*i + 2] = npos[2];
         }
 
         debugl(2, "computing hermite boundary condition vectors..\n");
@@ -356,18 +358,17 @@ namespace NLM {
         dsn                            *= std::get<2>(para_algo_tuple);
 
         debugl(1, "calling Thomson linear solver for spline system for three component splines ({x, y, z})..\n");
-        /* get three result vectors for {x, y, z}-coefficient interpolation polynomial, each consisting of the 4n power
-         * coefficients of the interpolating cubic spline with hermite boundary condition (ds0, dsn) for the respective
-         * component {x,y,z}. for all (n-1) segments of the implicitly defined space curve, convert the component functions
-         * to BernsteinPolynomials and init BezierCanalSurface of the respective neurite segment */
-        for (uint32_t j = 0; j < 3; j++) {
-            Aux::Numerics::solveSplineCoefficientSystem<R>(
-                this->neurite_vertex_parameters,
-                vertex_position_components[j],
-                ds0[j],
-                dsn[j],
-                result_powercoeff[j]);
-        }
+        /* get the 4n power coefficients of the interpolating cubic splines with hermite boundary condition (ds0, dsn)
+         * for all three components {x,y,z}. for all (n-1) segments of the implicitly defined space curve, convert the
+         * component functions to BernsteinPolynomials and init BezierCanalSurface of the respective neurite segment */
+        R const ds0_components[3] = { ds0[0], ds0[1], ds0[2] };
+        R const dsn_components[3] = { dsn[0], dsn[1], dsn[2] };
+
+        Aux::Numerics::solveSplineCoefficientSystems<R, 3>(
+            this->neurite_vertex_parameters,
+            ds0_components,
+            dsn_components,
+            ws);
 
         debugl(1, "systems solved. generating neurite segment curves and neurite canal segments..\n");
         /* for all n segments, assemble spine curve segment in power basis, convert to BezierCurve by converting
@@ -397,10 +398,10 @@ namespace NLM {
             for (uint32_t j = 0; j < 3; j++) {
                 /* read in result power coefficients for j-th component polynomial of segment i "backwards.." for historical
                  * reasons o_O */
-                powercoeff_tmp[3] = result_powercoeff[j][coeff_index    ];
-                powercoeff_tmp[2] = result_powercoeff[j][coeff_index + 1];
-                powercoeff_tmp[1] = result_powercoeff[j][coeff_index + 2];
-                powercoeff_tmp[0] = result_powercoeff[j][coeff_index + 3];
+                powercoeff_tmp[3] = ws.coeffs[3*(coeff_index    ) + j];
+                powercoeff_tmp[2] = ws.coeffs[3*(coeff_index + 1) + j];
+                powercoeff_tmp[1] = ws.coeffs[3*(coeff_index + 2) + j];
+                powercoeff_tmp[0] = ws.coeffs[3*(coeff_index + 3) + j];
 
                 /* create temporary power polynomial for component j of segment i */
                 powerpoly_tmp = PowerPolynomial<3u, R, R>(powercoeff_tmp);
@@ -585,7 +586,8 @@ namespace NLM {
             >                                                  &end_circle_its,
         typename Mesh<Tm, Tv, Tf, R>::vertex_iterator          &closing_vertex_it,
         R const                                                &radius_reduction_factor,
-		bool                                                    preserve_crease_edges) const
+		bool                                                    preserve_crease_edges,
+        CanalSurfaceRingCache<R>                               *ring_cache) const
     {
         debugl(1, "NeuritePath::generateInitialSegmentMesh().\n");
         debugTabInc();
@@ -630,7 +632,8 @@ namespace NLM {
                 &end_circle_offset,
                 &end_circle_its,
                 &closing_vertex_it,
-				preserve_crease_edges);
+				preserve_crease_edges,
+                ring_cache);
 
             debugl(2, "mesh generated.\n");
         }
@@ -664,7 +667,8 @@ namespace NLM {
                     &end_circle_offset,
                     &end_circle_its,
                     &closing_vertex_it,
-					preserve_crease_edges);
+					preserve_crease_edges,
+                ring_cache);
 
                 /* erase the closing vertex to reopen the mesh */
                 M.vertices.erase(closing_vertex_it);
@@ -690,7 +694,8 @@ namespace NLM {
                     &end_circle_its,
                     /* save iterator to closing vertex */
                     &closing_vertex_it,
-					preserve_crease_edges);
+					preserve_crease_edges,
+                ring_cache);
             }
             else {
                 throw("NeuritePath::generateMesh(): (this) is a neurite root path whose first vertex not incident to "\
@@ -726,7 +731,8 @@ namespace NLM {
         bool& circle_offset_inOut,
         std::vector<typename Mesh<Tm, Tv, Tf, R>::vertex_iterator>& circle_its_inOut,
         typename Mesh<Tm, Tv, Tf, R>::vertex_iterator& circle_closing_vertex_it_inOut,
-        bool preserve_crease_edges
+        bool preserve_crease_edges,
+        CanalSurfaceRingCache<R>* ring_cache
     ) const
     {
         debugl(2, "generating mesh for neurite canal segment %d\n", segmentIndex);
@@ -748,7 +754,8 @@ namespace NLM {
             &circle_offset_inOut,
             &circle_its_inOut,
             &circle_closing_vertex_it_inOut,
-            preserve_crease_edges
+            preserve_crease_edges,
+            ring_cache
         );
 
         debugl(2, "done with mesh for neurite canal segment %d\n", segmentIndex);
@@ -776,7 +783,8 @@ namespace NLM {
                 typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
             >                                                  *end_circle_its,
         typename Mesh<Tm, Tv, Tf, R>::vertex_iterator          *closing_vertex_it,
-		bool                                                    preserve_crease_edges) const
+		bool                                                    preserve_crease_edges,
+        CanalSurfaceRingCache<R>                               *ring_cache) const
     {
         debugl(1, "NeuritePath::appendTailMesh().\n");
         debugTabInc();
@@ -827,7 +835,8 @@ namespace NLM {
                 &segment_i_start_circle_its,
                 /* same scheme to update iterator to closing vertex */
                 &segment_i_start_circle_closing_vertex_it,
-				preserve_crease_edges);
+				preserve_crease_edges,
+                ring_cache);
 
             debugl(2, "done with mesh for neurite canal segment %d\n", i);
         }
@@ -878,6 +887,7 @@ NLM_CellNetwork<R>::NLM_CellNetwork(std::string network_name)
     >(network_name)
 {
     this->nlm_neurite_root_vertices_adjusted        = false;
+    this->partition_csr_valid                       = false;
     this->nlm_network_info_updated                  = false;
 
     /* default settings for analysis and mesh generation */
@@ -895,6 +905,8 @@ NLM_CellNetwork<R>::NLM_CellNetwork(std::string network_name)
 
     this->meshing_flush                             = true;
     this->meshing_flush_face_limit                  = 100000;
+    this->meshing_mem_budget                        = 0;
+    this->meshing_nthreads                          = 1;
 
     this->meshing_n_soma_refs                       = 3;
     this->meshing_canal_segment_n_phi_segments      = 12;
@@ -930,6 +942,8 @@ NLM_CellNetwork<R>::getSettings() const
 
     s.meshing_flush                             = this->meshing_flush;
     s.meshing_flush_face_limit                  = this->meshing_flush_face_limit;
+    s.meshing_mem_budget                        = this->meshing_mem_budget;
+    s.meshing_nthreads                          = this->meshing_nthreads;
 
     s.meshing_n_soma_refs                       = this->meshing_n_soma_refs;
     s.meshing_canal_segment_n_phi_segments      = this->meshing_canal_segment_n_phi_segments;
@@ -958,6 +972,8 @@ NLM_CellNetwork<R>::updateSettings(Settings const &s)
 
     this->meshing_flush                             = s.meshing_flush;
     this->meshing_flush_face_limit                  = s.meshing_flush_face_limit;
+    this->meshing_mem_budget                        = s.meshing_mem_budget;
+    this->meshing_nthreads                          = s.meshing_nthreads;
 
     this->meshing_n_soma_refs                       = s.meshing_n_soma_refs;
     this->meshing_canal_segment_n_phi_segments      = s.meshing_canal_segment_n_phi_segments;
@@ -977,6 +993,8 @@ NLM_CellNetwork<R>::updateSettings(Settings const &s)
         "\t analysis_bivar_solver_eps:              %5.4e\n"\
         "\t meshing_flush:                          %5d\n"\
         "\t meshing_flush_face_limit:               %5d\n"\
+        "\t meshing_mem_budget (MB):                %5d\n"\
+        "\t meshing_nthreads:                       %5d\n"\
         "\t meshing_n_soma_refs:                    %5d\n"\
         "\t meshing_canal_segment_n_phi_segments:   %5d\n"\
         "\t meshing_outer_loop_maxiter:             %5d\n"\
@@ -989,6 +1007,8 @@ NLM_CellNetwork<R>::updateSettings(Settings const &s)
         this->analysis_bivar_solver_eps,
         this->meshing_flush,
         this->meshing_flush_face_limit,
+        this->meshing_mem_budget,
+        this->meshing_nthreads,
         this->meshing_n_soma_refs,
         this->meshing_canal_segment_n_phi_segments,
         this->meshing_cansurf_triangle_height_factor,
@@ -1295,6 +1315,37 @@ NLM_CellNetwork<R>::updateAllMDVInformation()
     debugl(1, "NLM_CellNetwork::updateAllMDVInformation(): done.\n");
 }
 
+template <typename R>
+std::pair<uint32_t, R>
+NLM_CellNetwork<R>::getPartitionSubTreeDepths(neurite_iterator n_it)
+{
+    if (!this->partition_csr_valid) {
+        return this->getNeuriteSubTreeDepths(n_it);
+    }
+
+    CellNetworkCSR<R> const &csr = this->partition_csr;
+
+    /* one workspace per thread, reused for all sub-trees */
+    static thread_local typename CellNetworkCSR<R>::Workspace ws;
+
+    return csr.getSubTreeDepths(
+        csr.getVertexIndex(n_it->id()),
+        [&csr] (uint32_t v) -> bool
+        {
+            uint32_t const t = csr.vertex(v).type;
+            return (t == NLM_CellNetworkBaseType::SOMA_VERTEX ||
+                    t == NLM_CellNetworkBaseType::AXON_VERTEX ||
+                    t == NLM_CellNetworkBaseType::DENDRITE_VERTEX);
+        },
+        [&csr] (uint32_t e) -> bool
+        {
+            uint32_t const t = csr.edge(e).type;
+            return (t == NLM_CellNetworkBaseType::AXON_SEGMENT ||
+                    t == NLM_CellNetworkBaseType::DENDRITE_SEGMENT);
+        },
+        ws);
+}
+
 template<typename R>
 std::function<
     typename NLM_CellNetwork<R>::neurite_segment_iterator(
@@ -1321,7 +1372,7 @@ NLM_CellNetwork<R>::partition_select_max_chordal_depth(
 
             for (auto &ns : nslist) {
                 /* get chordal depth of neurite sub-tree rooted in destination vertex of ns */
-                tmp     = (C.getNeuriteSubTreeDepths(ns->getDestinationVertex())).second;
+                tmp     = (C.getPartitionSubTreeDepths(ns->getDestinationVertex())).second;
 
                 if (tmp > max_chordal_depth && ns->getAngle() < filter_angle && ns->getRadiusRatio() < max_radius_ratio) {
                     max_chordal_depth   = tmp;
@@ -1765,7 +1816,8 @@ NLM_CellNetwork<R>::updateCellGeometry(
                 std::vector<R>,
                 R
             >(NLM::NeuritePath<R> const &P)
-        >  const                       &parametrization_algorithm)
+        >  const                       &parametrization_algorithm,
+    uint32_t                            nthreads)
 {
 
     /* assumes that cell C_s identified by s has been partitioned. set soma sphere info, iterator over neurite path
@@ -1778,11 +1830,40 @@ NLM_CellNetwork<R>::updateCellGeometry(
     s_info.soma_sphere.radius() = s_it->getSinglePointRadius();
 
     /* update geometry of all neurites */
+    std::vector<NLM::NeuritePath<R> *> paths;
     for (auto &npt : s_info.neurite_path_trees) {
         for (auto &npt_v : npt.vertices) {
-            npt_v->updateGeometry(parametrization_algorithm);
+            paths.push_back(&(*npt_v));
         }
     }
+
+    this->updateNeuritePathGeometry(paths, parametrization_algorithm, nthreads);
+}
+
+template <typename R>
+void
+NLM_CellNetwork<R>::updateNeuritePathGeometry(
+    std::vector<NLM::NeuritePath<R> *> const   &paths,
+    std::function<
+            std::tuple<
+                R,
+                std::vector<R>,
+                R
+            >(NLM::NeuritePath<R> const &P)
+        >  const                               &parametrization_algorithm,
+    uint32_t                                    nthreads)
+{
+    /* NeuritePath::updateGeometry() only writes the path itself, the canal segments stored in the information of its
+     * neurite segments and, for root paths, the initial cylinder of its neurite root edge. paths can hence be updated
+     * concurrently, with one spline solver workspace per worker that is reused for all of its paths. the first error
+     * is re-thrown once all workers have finished. */
+    std::vector<Aux::Numerics::SplineSystemWorkspace<R, 3>> spline_ws(std::max(nthreads, 1u));
+
+    Aux::Parallel::forEachIndex(paths.size(), nthreads,
+        [&] (size_t i, uint32_t t) -> void {
+            paths[i]->updateGeometry(parametrization_algorithm, &spline_ws[t]);
+        },
+        "geometry worker");
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- *
@@ -2449,6 +2530,23 @@ NLM_CellNetwork<R>::startWorkerThread(ThreadInfo *tinfo)
     SONS_Job           *sons_job;
     NSNS_Adj_Job       *nsns_adj_job;
     NSNS_NonAdj_Job    *nsns_nonadj_job;
+
+    /* per job type profiling data of this thread, accumulated locally and reported once after all jobs have been
+     * processed to avoid contention on the profiler. */
+    static char const  *job_stage_names[6] = {
+                            "analysis/solve/REG",
+                            "analysis/solve/LSI",
+                            "analysis/solve/GSI",
+                            "analysis/solve/SONS",
+                            "analysis/solve/NSNS_ADJ",
+                            "analysis/solve/NSNS_NONADJ"
+                        };
+    bool const          profile = Profiling::enabled();
+    double              job_wall[6]     = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    double              job_cpu[6]      = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    uint64_t            job_count[6]    = { 0, 0, 0, 0, 0, 0 };
+    double              job_wall_start  = 0.0;
+    double              job_cpu_start   = 0.0;
    
     /* catch exceptions here */
     try {
@@ -2458,6 +2556,9 @@ NLM_CellNetwork<R>::startWorkerThread(ThreadInfo *tinfo)
         /* measure time */
         tick(tinfo->thread_id + 1);
 
+        TRACE_THREAD_NAME("analysis slot " + std::to_string(tinfo->thread_id));
+        TRACE_SCOPE_ARG("analysis/worker_thread", "njobs", tinfo->job_list.size());
+
         /* loop over all jobs */
         #ifdef __DEBUG__
         uint32_t job_index = 0;
@@ -2475,6 +2576,13 @@ NLM_CellNetwork<R>::startWorkerThread(ThreadInfo *tinfo)
             nsns_adj_job        = NULL;
             nsns_nonadj_job     = NULL;
 
+            if (profile) {
+                job_wall_start  = doubletime();
+                job_cpu_start   = Profiling::threadCpuTime();
+            }
+
+            TRACE_SCOPE(generic_job->type() < 6 ? job_stage_names[generic_job->type()] : "analysis/solve/unknown");
+
             /* depending on the job type, down-cast to specialized job class and call solver with the
              * stored arguments */
             switch (generic_job->type()) {
@@ -2585,10 +2693,26 @@ NLM_CellNetwork<R>::startWorkerThread(ThreadInfo *tinfo)
                 default:
                     throw("NLM_CellNetwork::processIntersectionJobs(): unknown job type encountered.\n");
             }
+
+            if (profile) {
+                uint32_t type    = generic_job->type();
+                job_wall[type]  += doubletime() - job_wall_start;
+                job_cpu[type]   += Profiling::threadCpuTime() - job_cpu_start;
+                job_count[type]++;
+            }
+
             /* set job state */
             generic_job->job_state = JOB_DONE;
         }
 
+        if (profile) {
+            for (uint32_t i = 0; i < 6; i++) {
+                if (job_count[i] > 0) {
+                    Profiling::addStageTime(job_stage_names[i], job_wall[i], job_cpu[i], job_count[i]);
+                }
+            }
+        }
+
         debugl(1, "Thread slot %02d: thread finished after %5.4f seconds.\n", tinfo->thread_id, tack(tinfo->thread_id + 1));
 
         /* set thread state to DONE */
@@ -3019,12 +3143,66 @@ template <typename R>
 void
 NLM_CellNetwork<R>::readFromNeuroMorphoSWCFile(
     std::string     filename,
-    bool const     &check_coincident_positions)
+    bool const     &check_coincident_positions,
+    uint32_t        nthreads)
 {
-    NLM_CellNetworkBaseType::readFromNeuroMorphoSWCFile(filename, check_coincident_positions);
+    NLM_CellNetworkBaseType::readFromNeuroMorphoSWCFile(filename, check_coincident_positions, nthreads);
     this->computeInitialNeuriteRootVertices();
 }
 
+template <typename R>
+bool
+NLM_CellNetwork<R>::readBinaryCache(
+    std::string     filename,
+    uint64_t        key)
+{
+    if (!NLM_CellNetworkBaseType::readBinaryCache(filename, key)) {
+        return false;
+    }
+
+    /* the cache is written after computeInitialNeuriteRootVertices() */
+    this->nlm_neurite_root_vertices_adjusted    = true;
+    this->nlm_network_info_updated              = false;
+
+    /* the NLM network info only depends on which neurite every neurite vertex / segment belongs to, which has been
+     * restored above. build it as updateNLMNetworkInfo() does, but without retrieving the connected component of
+     * every neurite. */
+    if (this->network_info_initialized) {
+        std::unordered_map<uint32_t, NeuritePathTree *> npts;
+
+        for (auto &s : this->soma_vertices) {
+            NLM::SomaInfo<R>               &s_info  = s.soma_data;
+            s_info.soma_sphere                      = NLM::SomaSphere<R>();
+            s_info.neurite_path_trees.clear();
+
+            std::list<NeuriteRootEdge *>    s_neurite_root_edges;
+            s.template getFilteredOutEdges<NeuriteRootEdge>(s_neurite_root_edges);
+
+            for (auto &nre : s_neurite_root_edges) {
+                s_info.neurite_path_trees.push_back(NeuritePathTree(nre->iterator()));
+                npts[nre->id()] = &(s_info.neurite_path_trees.back());
+            }
+        }
+
+        for (auto &nv : this->neurite_vertices) {
+            NLM::NeuriteInfo<R> &nv_info        = nv.neurite_data;
+            nv_info.npt                         = npts.at(nv.getNeurite()->id());
+            nv_info.npt_info.clear();
+        }
+
+        for (auto &ns : this->neurite_segments) {
+            NLM::NeuriteSegmentInfo<R> &ns_info = ns.neurite_segment_data;
+            ns_info.npt                         = npts.at(ns.getNeurite()->id());
+            ns_info.npt_it.explicitlyInvalidate();
+            ns_info.npt_ns_idx                  = 0;
+        }
+
+        this->nlm_network_info_updated = true;
+    }
+
+    return true;
+}
+
 template <typename R>
 void
 NLM_CellNetwork<R>::partitionNetwork()
@@ -3033,9 +3211,36 @@ NLM_CellNetwork<R>::partitionNetwork()
     this->initializeNetworkInfo();
     this->updateNLMNetworkInfo();
 
-    /* partition all cells and update geometry */
+    /* snapshot for the selection algorithms. partitioning does not change the topology of the network. */
+    this->partition_csr         = this->getCSRSnapshot();
+    this->partition_csr_valid   = true;
+
+    /* partition all cells concurrently. partitionCell() only writes the partitioning information attached to the
+     * neurite vertices / segments of the given cell and the neurite path trees of its neurites. the selection
+     * algorithm is called concurrently as well and must hence not modify the network, which holds for the pre-defined
+     * algorithms: sub-tree depths are computed on the snapshot. the first error is re-thrown once all workers have
+     * finished. */
+    std::vector<soma_iterator> somas;
     for (auto &s : this->soma_vertices) {
-        this->partitionCell(s.iterator(), this->partition_algo );
+        somas.push_back(s.iterator());
+    }
+
+    /* the snapshot is released on all paths, including the error path */
+    std::exception_ptr error;
+    try {
+        Aux::Parallel::forEachIndex(somas.size(), this->analysis_nthreads,
+            [&] (size_t i, uint32_t) -> void { this->partitionCell(somas[i], this->partition_algo); },
+            "partitioning worker");
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    this->partition_csr_valid   = false;
+    this->partition_csr         = CellNetworkCSR<R>();
+
+    if (error) {
+        std::rethrow_exception(error);
     }
 }
 
@@ -3043,9 +3248,22 @@ template <typename R>
 void
 NLM_CellNetwork<R>::updateNetworkGeometry()
 {
+    /* update all soma spheres, then the geometry of all neurite paths of all cells concurrently, so that the work is
+     * distributed evenly even for networks consisting of few large cells. */
+    std::vector<NLM::NeuritePath<R> *> paths;
     for (auto &s : this->soma_vertices) {
-        this->updateCellGeometry(s.iterator(), this->parametrization_algo );
+        NLM::SomaInfo<R> &s_info    = s.soma_data;
+        s_info.soma_sphere.centre() = s.getSinglePointPosition();
+        s_info.soma_sphere.radius() = s.getSinglePointRadius();
+
+        for (auto &npt : s_info.neurite_path_trees) {
+            for (auto &npt_v : npt.vertices) {
+                paths.push_back(&(*npt_v));
+            }
+        }
     }
+
+    this->updateNeuritePathGeometry(paths, this->parametrization_algo, this->analysis_nthreads);
 }
 
 /* one full analysis iteration on the entire cell network */
@@ -3075,12 +3293,19 @@ NLM_CellNetwork<R>::performFullAnalysis()
 
 
     /* update mdv information */
-    this->updateAllMDVInformation();
+    {
+        Profiling::ScopedStage stage("analysis/mdv_update");
+        this->updateAllMDVInformation();
+    }
 
     debugl(1, "computing all intersection jobs for one full analysis interation..\n");
     /* compute all intersection jobs */
     std::list<std::shared_ptr<IsecJob>> job_list, intersection_list;
-    this->computeFullAnalysisIntersectionJobs(job_list);
+    {
+        Profiling::ScopedStage stage("analysis/job_generation");
+        this->computeFullAnalysisIntersectionJobs(job_list);
+    }
+    Profiling::addCounter("analysis/jobs", job_list.size());
 
     debugl(1, "got %zu jobs => shuffling..\n", job_list.size());
 
@@ -3099,7 +3324,11 @@ NLM_CellNetwork<R>::performFullAnalysis()
     printf("processing %zu intersection jobs using %d worker threads.\n", job_list.size(), this->analysis_nthreads); 
 
     /* process all jobs multi-threaded */
-    this->processIntersectionJobsMultiThreaded(this->analysis_nthreads, job_list, intersection_list);
+    {
+        Profiling::ScopedStage stage("analysis/solve");
+        this->processIntersectionJobsMultiThreaded(this->analysis_nthreads, job_list, intersection_list);
+    }
+    Profiling::addCounter("analysis/intersections", intersection_list.size());
     bool clean = intersection_list.empty();
 
     if (!clean) {
@@ -3258,236 +3487,348 @@ NLM_CellNetwork<R>::performFullAnalysis()
 #include "MeshAlgorithms.hh"
 
 template <typename R>
-template <typename Tm, typename Tv, typename Tf>
-void
-NLM_CellNetwork<R>::renderCellNetwork(std::string filename)
+uint64_t
+NLM_CellNetwork<R>::MeshingFlushIndex::key(int32_t i, int32_t j, int32_t k) const
 {
-    debugl(1, "NLM_CellNetwork<R>::renderCellNetwork(): \"%s\".\n", filename.c_str());
-    debugTabInc();
+    uint64_t const  offset  = 1u << 20;
+    uint64_t const  mask    = (1u << 21) - 1;
 
-    using namespace RedBlue_ExCodes;
+    return ( (((uint64_t)i + offset) & mask) << 42 ) | ( (((uint64_t)j + offset) & mask) << 21 ) | (((uint64_t)k + offset) & mask);
+}
 
-    std::list<typename NeuritePathTree::vertex_iterator>    npt_vertices_bfs_ordered;
+template <typename R>
+std::array<int32_t, 6>
+NLM_CellNetwork<R>::MeshingFlushIndex::cellRange(BoundingBox<R> const &box) const
+{
+    /* clamp to the range representable in key() */
+    R const lim = (R)((1 << 20) - 1);
+    auto cellCoord = [&] (R x) -> int32_t {
+        return (int32_t)std::max(-lim, std::min(lim, std::floor(x / this->cell_len)));
+    };
+
+    Vec3<R> const bmin = box.min(), bmax = box.max();
+    return {{ cellCoord(bmin[0]), cellCoord(bmin[1]), cellCoord(bmin[2]),
+              cellCoord(bmax[0]), cellCoord(bmax[1]), cellCoord(bmax[2]) }};
+}
 
-    Mesh<Tm, Tv, Tf, R>                                     M_cell, M_cell_backup, M_S, M_P;
+template <typename R>
+void
+NLM_CellNetwork<R>::buildMeshingFlushIndex(
+    std::list<typename NeuritePathTree::vertex_iterator> const     &npt_vertices_bfs_ordered,
+    MeshingFlushIndex                                              &flush_index) const
+{
+    flush_index.entries.clear();
+    flush_index.cells.clear();
+    flush_index.path_order.clear();
+    flush_index.mem_after_flush = 0;
+
+    /* search box of a canal segment: a face of M_cell may be affected by merging the path if its bounding box
+     * intersects this box. */
+    R       ext_sum = 0;
+    uint32_t order  = 0;
+    for (auto &npt_v : npt_vertices_bfs_ordered) {
+        NLM::NeuritePath<R> const &Q = npt_v->vertex_data;
+        flush_index.path_order[&(*npt_v)] = order;
+        for (auto &Gamma : Q.canal_segments_magnified) {
+            auto Gamma_search_bb    = (Gamma->getBoundingBox()).extend(0.1, Vec3<R>(1E-2, 1E-2, 1E-2));
+            Vec3<R> d               = Gamma_search_bb.max() - Gamma_search_bb.min();
+            ext_sum                += std::max(d[0], std::max(d[1], d[2]));
+            flush_index.entries.push_back({ order, Gamma_search_bb });
+        }
+        order++;
+    }
+    flush_index.cell_len = (!flush_index.entries.empty() && ext_sum > 0) ? ext_sum / (R)flush_index.entries.size() : 1.0;
+
+    /* entries are appended in meshing order, hence every cell is sorted by order */
+    for (uint32_t e = 0; e < flush_index.entries.size(); e++) {
+        auto range = flush_index.cellRange(flush_index.entries[e].bb);
+        for (int32_t i = range[0]; i <= range[3]; i++) {
+            for (int32_t j = range[1]; j <= range[4]; j++) {
+                for (int32_t k = range[2]; k <= range[5]; k++) {
+                    flush_index.cells[flush_index.key(i, j, k)].push_back(e);
+                }
+            }
+        }
+    }
 
-    bool                                                    end_circle_offset;
-    std::vector<
-            typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
-        >                                                   end_circle_its, circle_its_update,
-                                                            circle_its_update_original;
-    typename Mesh<Tm, Tv, Tf, R>::vertex_iterator           closing_vertex_it;
+    debugl(1, "meshing flush index: %zu canal segments, %zu cells, cell length %f.\n",
+        flush_index.entries.size(), flush_index.cells.size(), flush_index.cell_len);
+}
 
-    /* initialize the cell mesh to consist of all soma spheres. while iterating over all somas, get breadth-first
-     * ordering of neurite paths for all neurites and append to global list */
-    debugl(1, "initializing soma sphere meshes and computing BFS ordering among neurite paths.\n");
-    for (auto &s : this->soma_vertices) {
-        NLM::SomaInfo<R> &s_info  = s.soma_data;
+template <typename R>
+template <typename Tm, typename Tv, typename Tf>
+void
+NLM_CellNetwork<R>::flushUnaffectedCellMeshFaces(
+    Mesh<Tm, Tv, Tf, R>                                                                &M_cell,
+    MeshAlg::MeshObjFlushInfo<Tm, Tv, Tf, R>                                           &M_cell_flushinfo,
+    MeshingFlushIndex                                                                  &flush_index,
+    typename std::list<typename NeuritePathTree::vertex_iterator>::const_iterator       remaining_begin,
+    typename std::list<typename NeuritePathTree::vertex_iterator>::const_iterator       remaining_end) const
+{
+    /* if the mesh has more than meshing_flush_face_limit faces or, if a memory budget is given, is estimated to use
+     * more than meshing_mem_budget MB, flush all vertices and faces to disk which definitely don't participate in any
+     * merging operation that remains to be done. a face may be affected if its bounding box intersects the generously
+     * extended bounding box of any neurite canal segment yet to be meshed. these boxes are looked up in flush_index
+     * for every face of M_cell, so that the cost depends on the size of M_cell and not on the number of remaining
+     * neurite paths.
+     *
+     * all other faces will never be affected during a merging operation and can safely be flushed to disk. */
+    if (!this->meshing_flush) {
+        return;
+    }
 
-        s_info.soma_sphere.template generateMesh<Tm, Tv, Tf>(M_S, meshing_n_soma_refs);
+    if (this->meshing_mem_budget > 0) {
+        /* if the faces that must be kept already exceed the budget, wait until the mesh has grown by another eighth
+         * of the budget to avoid flushing (almost) nothing after every neurite path. */
+        size_t const budget = (size_t)this->meshing_mem_budget << 20;
+        size_t const mem    = M_cell.estimateMemoryUsage();
+        if (mem <= std::max(budget, flush_index.mem_after_flush + budget / 8)) {
+            return;
+        }
+        printf("\t Partial cell mesh uses ~%8.2f MB > %5u MB (memory budget). Flushing definitely no longer needed parts off to disk.. ",
+                (double)mem / (1 << 20), this->meshing_mem_budget);
+    }
+    else if (M_cell.numFaces() > this->meshing_flush_face_limit) {
+        printf("\t Partial cell mesh has %5d > %5d (flush face limit)) faces. Flushing definitely no longer needed parts off to disk.. ",
+                M_cell.numFaces(), this->meshing_flush_face_limit);
+    }
+    else {
+        return;
+    }
+    fflush(stdout);
 
-        M_cell.moveAppend(M_S);
+    std::list<typename Mesh<Tm, Tv, Tf, R>::Face *> flush_faces;
+    {
+        Profiling::ScopedStage select_stage("meshing/flush_select");
+
+        uint32_t const order = (remaining_begin != remaining_end) ? flush_index.path_order.at(&(**remaining_begin)) : UINT32_MAX;
+
+        /* faces are visited in id order, as the inverted selection of the affected faces would be */
+        for (auto &f : M_cell.faces) {
+            auto f_bb       = f.getBoundingBox();
+            auto range      = flush_index.cellRange(f_bb);
+            bool affected   = false;
+
+            for (int32_t i = range[0]; i <= range[3] && !affected; i++) {
+                for (int32_t j = range[1]; j <= range[4] && !affected; j++) {
+                    for (int32_t k = range[2]; k <= range[5] && !affected; k++) {
+                        auto cit = flush_index.cells.find(flush_index.key(i, j, k));
+                        if (cit == flush_index.cells.end()) {
+                            continue;
+                        }
 
-        /* iterate over all neurite path trees, i.e. all neurites, of the soma. */
-        for (NeuritePathTree &npt : s_info.neurite_path_trees) {
-            std::list<typename NeuritePathTree::Vertex const *>  source_vertices;
-            for (auto &v : npt.vertices) {
-                if (v.indeg() == 0) {
-                    source_vertices.push_back(&v);
+                        /* only the tail of the cell belongs to remaining paths */
+                        auto const &cell = cit->second;
+                        for (auto eit = cell.rbegin(); eit != cell.rend() && flush_index.entries[*eit].order >= order; ++eit) {
+                            if (flush_index.entries[*eit].bb && f_bb) {
+                                affected = true;
+                                break;
+                            }
+                        }
+                    }
                 }
             }
 
-            for (auto &sv : source_vertices) {
-                /* get connected component of source vertex in breadth-first order and append corresponding
-                 * NeuritePath pointers to neurite path list. */
-                std::list<typename NeuritePathTree::Vertex *> sv_cc;  
-
-                uint32_t tid = npt.getFreshTraversalId();
-
-                npt.getConnectedComponentBreadthFirst(
-                    sv->iterator(),
-                    tid,
-                    &sv_cc,
-                    NULL);
-
-                for (auto &u : sv_cc) {
-                    npt_vertices_bfs_ordered.push_back(u->iterator());
-                }
+            if (!affected) {
+                flush_faces.push_back(&f);
             }
         }
     }
 
-    /* initialize flush info */
-    MeshAlg::MeshObjFlushInfo<Tm, Tv, Tf, R>    M_cell_flushinfo(filename);
-    std::list<uint32_t>                         M_cell_flush_last_boundary_vertices_ids_backup;                          
+    /* .. and perform the flush */
+    Profiling::ScopedStage flush_stage("meshing/flush");
+    Profiling::addCounter("meshing/flushed_faces", flush_faces.size());
 
-    /* in the computed bread-first ordering, inductively append neurite path meshes */
-    debugl(1, "processing neurite paths in BFS order.\n");
-    debugTabInc();
-    uint32_t np_idx = 1;
-    for (auto npt_vit = npt_vertices_bfs_ordered.begin(); npt_vit != npt_vertices_bfs_ordered.end(); ++npt_vit) {
-        debugl(2, "processing neurite path %d\n", (*npt_vit)->id());
-        printf("\t meshing neurite path %5u of %5zu.\n", np_idx, npt_vertices_bfs_ordered.size() );
-
-        /* get reference to neurite path */
-        NLM::NeuritePath<R> const &P    = (*npt_vit)->vertex_data;
-
-        /* find permissible render vector for neurite path */
-        Vec3<R> render_vector;
-        render_vector = P.findPermissibleRenderVector();
-
-        /* variables for angular offset */
-        R           phi_0;
-
-        /* merge neurite path initial mesh segment with RedBlueUnion, catch exceptions, re-randomize / decrease radius
-         * factor / handle errors as required */
-        uint32_t    outer_loop_iter             = 0;
-        uint32_t    inner_loop_iter             = 0;
-        bool        done                        = false;
-        bool        restore_M_cell              = false;
-        bool        new_outer_iteration         = false;
-        bool        break_inner_meshing_loop    = true;
-
-        R           complex_edge_growth_factor  = 0.0;
-        uint32_t    complex_edge_initial_count  = 0;
-
-        // compute a good initial guess for the radius reduction factor of the initial segment:
-        // to that end, compute the radius of the in-circle of the cross-section polygon of the
-        // parent section
-        R radius_factor = cos(M_PI / meshing_canal_segment_n_phi_segments);
-
-        /* compute a radius factor the corresponds to a generous lower bound on a safe radius, which can be obtained
-         * by analysing the local neighbourhood of P's start vertex. */
-        NeuriteVertex const &P_vstart       = *(P.neurite_segments[0]->getSourceVertex());
-        R           P_vstart_radius         = P_vstart.getRadius();
-        auto        P_vstart_vertex_nbs     = P_vstart.template getFilteredNeighbours<NeuriteVertex>();
-        R           radius_factor_safe_lb   = 0.5;
-
-        for (auto &x : P_vstart_vertex_nbs) {
-            radius_factor_safe_lb = std::min(radius_factor_safe_lb, x->getRadius() / (2.0 * P_vstart_radius));
-        }
-        debugl(1, "radius_factor_safe_lb = %5.4f\n", radius_factor_safe_lb);
-
-        /* if mesh has more than meshing_flush_face_limit faces, flush all vertices and faces to disk which
-         * definitely don't participate in any merging operation that remains to be done. the set of respective
-         * faces is computed as follows: for every remaining neurite path and all neurite canal segments of this
-         * path, get the bounding box, extend it generously and locate all faces of M_cell that properly intersect
-         * that bounding box. compute the union of all such sets of faces (over all neurite canal segments yet to be
-         * meshed) and invert the set of resulting faces.
-         *
-         * all faces in the obtained set (list) will never be affected during a merging operation and can safely be
-         * flushed to disk. */
-        if (this->meshing_flush && M_cell.numFaces() > this->meshing_flush_face_limit) {
-            printf("\t Partial cell mesh has %5d > %5d (flush face limit)) faces. Flushing definitely no longer needed parts off to disk.. ",
-                    M_cell.numFaces(), this->meshing_flush_face_limit);
-            fflush(stdout);
-
-            std::list<typename Mesh<Tm, Tv, Tf, R>::Face *>  flush_faces, tmp;
-            for (auto npt_wit = npt_vit; npt_wit != npt_vertices_bfs_ordered.end(); ++npt_wit) {
-                NLM::NeuritePath<R> const &Q = (*npt_wit)->vertex_data;
-                for (auto &Gamma : Q.canal_segments_magnified) {
-                    auto Gamma_search_bb = (Gamma->getBoundingBox()).extend(0.1, Vec3<R>(1E-2, 1E-2, 1E-2));
-                    M_cell.findFaces(Gamma_search_bb, tmp);
-                    flush_faces.insert(flush_faces.end(), tmp.begin(), tmp.end());
-                }
-            }
+    try {MeshAlg::partialFlushToObjFile(M_cell, M_cell_flushinfo, flush_faces);}
+    catch (...) {debugTabDec(); debugTabDec(); throw;}
 
-            auto sortFct = [] (const typename Mesh<Tm, Tv, Tf, R>::Face* x, const typename Mesh<Tm, Tv, Tf, R>::Face* y) -> bool {return (x->id() < y->id());};
-            auto uniqueFct = [] (const typename Mesh<Tm, Tv, Tf, R>::Face* x, const typename Mesh<Tm, Tv, Tf, R>::Face* y) -> bool {return (x->id() == y->id());};
-            flush_faces.sort(sortFct);
-            flush_faces.unique(uniqueFct);
+    flush_index.mem_after_flush = M_cell.estimateMemoryUsage();
+
+    printf("done.\n");
+}
 
-            /* invert face selection to get set of definitely not affected faces for all merging operations yet to
-             * be performed. */
-            M_cell.invertFaceSelection(flush_faces);
+template <typename R>
+template <typename Tm, typename Tv, typename Tf>
+void
+NLM_CellNetwork<R>::splitComplexEdges(
+    Mesh<Tm, Tv, Tf, R>                    &M_red,
+    Mesh<Tm, Tv, Tf, R>                    &M_blue,
+    RedBlue_Ex_ComplexEdges<R> const       &complex_ex)
+{
+    for (auto e_info : complex_ex.edge_isec_info) {
+        debugl(2, "complex edge: e = (%d, %d)\n", e_info.u_id, e_info.v_id);
 
-            /* .. and perform the flush */
-            try {MeshAlg::partialFlushToObjFile(M_cell, M_cell_flushinfo, flush_faces);}
-            catch (...) {debugTabDec(); debugTabDec(); throw;}
+        /* sort and check lambdas */
+        std::vector<R>& lambdas = e_info.edge_lambdas;
+        const uint32_t n = lambdas.size();
 
-            printf("done.\n");
+        debugl(2, "sorting complex exception edge lambdas. size(): %zu..\n", lambdas.size() );
+        std::sort(lambdas.begin(), lambdas.end(), std::less<R>() );
+        if (lambdas[0] <= 0 || lambdas[n-1] >= 1)
+        {
+            throw("NLM_CellNetwork::splitComplexEdges(): got exceptino about complex edge indicating fractional edge intersection value lambda outside ]0, 1[."\
+                " internal logic error.");
         }
 
-        /* backup (potentially just partially flushed) cell mesh */
-        M_cell_backup                   = M_cell;
+        /* compute split points */
+        std::vector<R> e_split_points(n-1);
 
-        /* backup ids of all boundary_vertices (referring to M_cell) from M_cell_flushinfo */
-        M_cell_flush_last_boundary_vertices_ids_backup.clear();
-        for (auto &vp : M_cell_flushinfo.last_boundary_vertices) {
-            M_cell_flush_last_boundary_vertices_ids_backup.push_back(vp.first->id());
+        for (uint32_t i = 1; i < n; i++) {
+            e_split_points[i-1] = (lambdas[i] + lambdas[i-1]) / 2.0;
+            debugl(3, "split_points[%d] = %5.4f\n", i - 1, e_split_points[i-1]);
         }
 
-        /*
-        tmp = M_cell;
-        tmp.writeObjFile("M_cell_before_merge");
-        */
+        /* split in red mesh, i.e. M_red */
+        if (e_info.red) {
+            auto u_it = M_red.vertices.find(e_info.u_id);
+            auto v_it = M_red.vertices.find(e_info.v_id);
 
-        uint32_t segment_index = 1;
+            if (u_it != M_red.vertices.end() && v_it != M_red.vertices.end()) {
+                M_red.splitEdge(u_it, v_it, e_split_points);
+            }
+            else {
+                throw("NLM_CellNetwork::splitComplexEdges(): discovered invalid vertex id contained "\
+                    " in complex edge information of RedBlue_Ex_ComplexEdges (id not found). internal"\
+                    " logic error.");
+            }
+        }
+        /* split in blue mesh, i.e. M_blue */
+        else {
+            auto u_it = M_blue.vertices.find(e_info.u_id);
+            auto v_it = M_blue.vertices.find(e_info.v_id);
 
-        debugl(1, "entering outer meshing loop for path %d.\n", (*npt_vit)->id());
-        debugTabInc();
-        while (!done) {
-            /* if necessary, use back M_cell_backup to restore original M_cell before the RedBlueUnion call if
-             * necessary. this is the case iff the exception that lead to the necessity of another run indicated
-             * R_intact == true (M_cell has been used as the red mesh). */
-            if (restore_M_cell) {
-                /* NOTE: the mesh flush info struct contains _pointers_ to boundary vertices of the old M_cell. once the
-                 * backup is used to restore, the current M_cell is effectively clear()ed and overwritten with the
-                 * backup copy by Mesh::operator=(). this process frees all vertices and faces of the mesh to which the
-                 * backup copy is assigned, which in turn causes dangling invalid pointers inside M_cell_flushinfo. it
-                 * therefore becomes necessary to update all last_boundary_vertices pointer to point to the correct
-                 * vertices of M_cell after the restore. however, mesh assignment with Mesh::operator=() preserves
-                 * integer ids, and so the update can be achieved as follows:
-                 *
-                 * 1. restore M_cell from M_cell_backup with assignment.
-                 *
-                 * 2. locate all boundary vertex ids in the restored M_cell and update pointers in M_cell_flushinfo. the
-                 * reference to M_cell stays intact, since the object itself is never deleted but only overwritten by
-                 * assignment. the integer ids of all boundary vertices are stored in the list
-                 * M_cell_boundary_vertex_ids_backup.
-                 *
-                 * */
-                debugl(1, "restoring M_cell from backup via assignment.\n");
-                M_cell = M_cell_backup;
-
-                debugl(1, "updating pointers in M_flush_info.last_boundary_vertices via id lookup..\n");
-                auto fp_it = M_cell_flushinfo.last_boundary_vertices.begin();
-                for (auto &v_id : M_cell_flush_last_boundary_vertices_ids_backup) {
-                    auto v_it = M_cell.vertices.find(v_id);
-                    if (v_it != M_cell.vertices.end()) {
-                        fp_it->first = &(*v_it);
-                        ++fp_it; 
-                    }
-                    else {
-                        debugTabDec(); debugTabDec(); debugTabDec();
-                        throw("NLM_CellNetwork::renderCellNetwork(): failed to locate flush boundary vertex via id during cell mesh backup.");
-                    }
-                }
+            if (u_it != M_blue.vertices.end() && v_it != M_blue.vertices.end()) {
+                M_blue.splitEdge(u_it, v_it, e_split_points);
+            }
+            else {
+                throw("NLM_CellNetwork::splitComplexEdges(): discovered invalid vertex id contained "\
+                    " in complex edge information of RedBlue_Ex_ComplexEdges (id not found). internal"\
+                    " logic error.");
+            }
+        }
+    }
+}
 
-                if (fp_it != M_cell_flushinfo.last_boundary_vertices.end()) {
-                    debugTabDec(); debugTabDec(); debugTabDec();
-                    throw("NLM_CellNetwork::renderCellNetwork(): iterator to MeshObjFlushInfo::last_boundary_vertices has not reached end() after cell mesh backup. internal logic error.");
-                }
+/* merge the mesh of neurite path P into M_cell with RedBlueUnion, handling all RedBlue exceptions by splitting edges /
+ * faces or re-generating P's initial segment mesh with a new random angular offset and a decreased radius factor. M_cell
+ * is protected by a checkpoint, which is rolled back whenever a failed attempt has left it modified. if phi_0_rng is
+ * given, it is used to draw the angular offsets instead of the global random sequence. P's cross-sections are
+ * discretized with n_phi_segments segments. only reads the settings of (this) network and may therefore be called
+ * concurrently for different meshes. */
+template <typename R>
+template <typename Tm, typename Tv, typename Tf>
+void
+NLM_CellNetwork<R>::meshNeuritePath(
+    Mesh<Tm, Tv, Tf, R>                    &M_cell,
+    NLM::NeuritePath<R> const              &P,
+    uint32_t                                path_id,
+    Vec3<R> const                          &render_vector,
+    uint32_t                                n_phi_segments,
+    std::mt19937                           *phi_0_rng) const
+{
+    using namespace RedBlue_ExCodes;
 
-                debugl(1, "M_cell and flush info fully restored.\n");
-            }
+    Mesh<Tm, Tv, Tf, R>                                     M_P;
+    bool                                                    end_circle_offset;
+    std::vector<
+            typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
+        >                                                   end_circle_its, circle_its_update,
+                                                            circle_its_update_original;
+    typename Mesh<Tm, Tv, Tf, R>::vertex_iterator           closing_vertex_it;
 
-            new_outer_iteration         = false;
-            restore_M_cell              = false;
-            outer_loop_iter++;
+    /* variables for angular offset */
+    R           phi_0;
+
+    /* merge neurite path initial mesh segment with RedBlueUnion, catch exceptions, re-randomize / decrease radius
+     * factor / handle errors as required */
+    uint32_t    outer_loop_iter             = 0;
+    uint32_t    inner_loop_iter             = 0;
+    bool        done                        = false;
+    bool        restore_M_cell              = false;
+    bool        new_outer_iteration         = false;
+    bool        break_inner_meshing_loop    = true;
+
+    R           complex_edge_growth_factor  = 0.0;
+    uint32_t    complex_edge_initial_count  = 0;
+
+    // compute a good initial guess for the radius reduction factor of the initial segment:
+    // to that end, compute the radius of the in-circle of the cross-section polygon of the
+    // parent section
+    R radius_factor = cos(M_PI / n_phi_segments);
+
+    /* compute a radius factor the corresponds to a generous lower bound on a safe radius, which can be obtained
+     * by analysing the local neighbourhood of P's start vertex. */
+    NeuriteVertex const &P_vstart       = *(P.neurite_segments[0]->getSourceVertex());
+    R           P_vstart_radius         = P_vstart.getRadius();
+    auto        P_vstart_vertex_nbs     = P_vstart.template getFilteredNeighbours<NeuriteVertex>();
+    R           radius_factor_safe_lb   = 0.5;
+
+    for (auto &x : P_vstart_vertex_nbs) {
+        radius_factor_safe_lb = std::min(radius_factor_safe_lb, x->getRadius() / (2.0 * P_vstart_radius));
+    }
+    debugl(1, "radius_factor_safe_lb = %5.4f\n", radius_factor_safe_lb);
 
-            if (outer_loop_iter % this->meshing_outer_loop_maxiter == 0) {
-                radius_factor = std::max(radius_factor_safe_lb, radius_factor - this->meshing_radius_factor_decrement);
-            }
+    /* open a checkpoint on the (potentially just partially flushed) cell mesh. all changes applied to M_cell
+     * while trying to merge P's initial segment are recorded in the undo log of M_cell and can be rolled back
+     * in time proportional to the number of changed elements, instead of keeping a full backup copy. */
+    {
+        Profiling::ScopedStage backup_stage("meshing/backup");
+        M_cell.beginCheckpoint();
+    }
+
+    /*
+    tmp = M_cell;
+    tmp.writeObjFile("M_cell_before_merge");
+    */
+
+    uint32_t segment_index = 1;
+
+    debugl(1, "entering outer meshing loop for path %d.\n", path_id);
+    debugTabInc();
+    while (!done) {
+        /* if necessary, use back M_cell_backup to restore original M_cell before the RedBlueUnion call if
+         * necessary. this is the case iff the exception that lead to the necessity of another run indicated
+         * R_intact == true (M_cell has been used as the red mesh). */
+        if (restore_M_cell) {
+            /* NOTE: the mesh flush info struct contains _pointers_ to boundary vertices of M_cell. rolling back
+             * the checkpoint re-inserts erased vertices as the very same objects under their original ids, hence
+             * these pointers stay valid. a fresh checkpoint is opened for the next attempt. */
+            debugl(1, "restoring M_cell by rolling back checkpoint.\n");
+            Profiling::ScopedStage restore_stage("meshing/restore");
+            M_cell.rollbackCheckpoint();
+            M_cell.beginCheckpoint();
+
+            debugl(1, "M_cell and flush info fully restored.\n");
+        }
+
+        new_outer_iteration         = false;
+        restore_M_cell              = false;
+        outer_loop_iter++;
 
-            debugl(1, "outer meshing loop: iteration %d. radius factor: %5.4f\n", outer_loop_iter, radius_factor);
-            debugl(1, "choosing random phi_0 and generating initial mesh segment..\n");
+        if (outer_loop_iter % this->meshing_outer_loop_maxiter == 0) {
+            radius_factor = std::max(radius_factor_safe_lb, radius_factor - this->meshing_radius_factor_decrement);
+        }
+
+        debugl(1, "outer meshing loop: iteration %d. radius factor: %5.4f\n", outer_loop_iter, radius_factor);
+        TRACE_SCOPE_ARG("meshing/outer_iteration", "path", path_id);
+        debugl(1, "choosing random phi_0 and generating initial mesh segment..\n");
+
+        /* compute random angular offset phi_0 */
+        if (phi_0_rng) {
+            phi_0 = std::uniform_real_distribution<R>(0.0, (2*(R)M_PI) / (R)n_phi_segments)(*phi_0_rng);
+        }
+        else {
+            phi_0 = Aux::Numbers::frand(0.0, (2*(R)M_PI) / (R)n_phi_segments);
+        }
 
-            /* compute random angular offset phi_0 */
-            phi_0 = Aux::Numbers::frand(0.0, (2*(R)M_PI) / (R)this->meshing_canal_segment_n_phi_segments);
+        /* unit-circle offsets for phi_0, shared by all canal segments and the terminal half-sphere of P */
+        CanalSurfaceRingCache<R> ring_cache(n_phi_segments, phi_0);
 
-            /* clear path mesh */
-            M_P.clear();
+        /* clear path mesh */
+        M_P.clear();
+
+        {
+            Profiling::ScopedStage generate_stage("meshing/generate");
 
             /* generate P's initial segment mesh and append to M */
             try
@@ -3496,7 +3837,7 @@ NLM_CellNetwork<R>::renderCellNetwork(std::string filename)
                     /* append to mesh M_P for path P*/
                     M_P,
                     /* n_phi_segments default to 16 for testing */
-                    this->meshing_canal_segment_n_phi_segments,
+                    n_phi_segments,
                     meshing_cansurf_triangle_height_factor,
                     /* render vector */
                     render_vector,
@@ -3509,7 +3850,8 @@ NLM_CellNetwork<R>::renderCellNetwork(std::string filename)
                     closing_vertex_it,
                     /* radius factor, which is being ignored for neurite root paths. */
                     radius_factor,
-                    this->meshing_preserve_crease_edges);
+                    this->meshing_preserve_crease_edges,
+                    &ring_cache);
             }
             catch (...) {debugTabDec(); debugTabDec(); debugTabDec(); throw;}
 
@@ -3522,7 +3864,7 @@ NLM_CellNetwork<R>::renderCellNetwork(std::string filename)
                     (
                         M_P,
                         i,
-                        this->meshing_canal_segment_n_phi_segments,
+                        n_phi_segments,
                         meshing_cansurf_triangle_height_factor,
                         render_vector,
                         phi_0,
@@ -3530,284 +3872,247 @@ NLM_CellNetwork<R>::renderCellNetwork(std::string filename)
                         end_circle_offset,
                         end_circle_its,
                         closing_vertex_it,
-                        this->meshing_preserve_crease_edges
+                        this->meshing_preserve_crease_edges,
+                        &ring_cache
                     );
                 }
                 catch (...) {debugTabDec(); debugTabDec(); debugTabDec(); throw;}
             }
+        }
+        Profiling::addCounter("meshing/generated_triangles", ring_cache.takeTriangleCount());
 
-            /* triangulate M_P for RedBlueAlgorithm */
-            M_P.triangulateQuads();
-
-            /*
-            tmp = M_P;
-            tmp.writeObjFile("M_P_before_merge");
-            */
+        /* triangulate M_P for RedBlueAlgorithm */
+        M_P.triangulateQuads();
 
-            /* merge initial path mesh segment into cell mesh with RedBlueUnion. to append the tail of the path mesh, it
-             * is required to know the end circle and closing vertex iterators AFTER merging, so these are assembled
-             * into the update iterator vector circle_its_update for the RedBlueUnion call. */
-            circle_its_update_original = end_circle_its;
-            circle_its_update_original.push_back(closing_vertex_it);
-
-            /* inner meshing loop: while the initial mesh segment generated above might still be usable (e.g. by
-             * splitting complex edges), try to use it. as soon as exception handling sets new_outer_iteration or
-             * break_inner_meshing_loop is set to false at the end of the try {..} block, the inner loop breaks.
-             * directly after the body of the inner meshing loop, it is checked whether new_outer_iteration == true. */
-            break_inner_meshing_loop    = false;
-            inner_loop_iter             = 0;
-            complex_edge_growth_factor  = 0.0;
-            complex_edge_initial_count  = 0;
-
-            debugl(1, "entering inner meshing loop..\n");
-            debugTabInc();
-            while (!new_outer_iteration && !break_inner_meshing_loop && inner_loop_iter < this->meshing_inner_loop_maxiter) {
-                /* copy circle_its_update_original into circle_its_update for current meshing run */
-                circle_its_update = circle_its_update_original;
-                inner_loop_iter++;
+        /*
+        tmp = M_P;
+        tmp.writeObjFile("M_P_before_merge");
+        */
 
-                debugl(2, "calling RedBlueUnion algorithm to merge initial mesh segment into partially completed cell mesh.\n");
+        /* merge initial path mesh segment into cell mesh with RedBlueUnion. to append the tail of the path mesh, it
+         * is required to know the end circle and closing vertex iterators AFTER merging, so these are assembled
+         * into the update iterator vector circle_its_update for the RedBlueUnion call. */
+        circle_its_update_original = end_circle_its;
+        circle_its_update_original.push_back(closing_vertex_it);
+
+        /* inner meshing loop: while the initial mesh segment generated above might still be usable (e.g. by
+         * splitting complex edges), try to use it. as soon as exception handling sets new_outer_iteration or
+         * break_inner_meshing_loop is set to false at the end of the try {..} block, the inner loop breaks.
+         * directly after the body of the inner meshing loop, it is checked whether new_outer_iteration == true. */
+        break_inner_meshing_loop    = false;
+        inner_loop_iter             = 0;
+        complex_edge_growth_factor  = 0.0;
+        complex_edge_initial_count  = 0;
+
+        debugl(1, "entering inner meshing loop..\n");
+        debugTabInc();
+        while (!new_outer_iteration && !break_inner_meshing_loop && inner_loop_iter < this->meshing_inner_loop_maxiter) {
+            /* copy circle_its_update_original into circle_its_update for current meshing run */
+            circle_its_update = circle_its_update_original;
+            inner_loop_iter++;
 
-                Aux::Timing::tick(14);
+            debugl(2, "calling RedBlueUnion algorithm to merge initial mesh segment into partially completed cell mesh.\n");
 
-                try {
-                    MeshAlg::RedBlueUnion<Tm, Tv, Tf, R>(
-                        /* R = M_cell, which is to be union mesh afterwards */
-                        M_cell,
-                        /* B = M_P, the mesh for the initial segment of P */
-                        M_P,
-                        /* list of end circle iterators from M_P which are updated to reflect the corresponding vertices in
-                         * the union mesh */
-                       &circle_its_update);
+            Aux::Timing::tick(14);
 
-                    /* RedBlueUnion call has been succcessful. break inner meshing loop */
-                    break_inner_meshing_loop = true;
-                }
-                catch (RedBlue_Ex_InternalLogic& logic_ex) {
-                    debugTabDec(); debugTabDec(); debugTabDec(); debugTabDec();
-                    throw;
-                }
-                catch (RedBlue_Ex_Disjoint& disjoint_ex) {
-                    debugTabDec(); debugTabDec(); debugTabDec(); debugTabDec();
-                    throw;
-                }
-                catch (RedBlue_Ex_ComplexEdges<R>& complex_ex) {
-                    debugl(0, "NLM_CellNetwork::renderCellNetwork(): RedBlueAlgorithm returned exception: %d complexly intersecting edges.. splitting.\n", complex_ex.edge_isec_info.size());
-                    debugTabInc();
+            try {
+                Profiling::ScopedStage redblue_stage("meshing/redblue");
 
-                    uint32_t const nce = complex_ex.edge_isec_info.size();
+                MeshAlg::RedBlueUnion<Tm, Tv, Tf, R>(
+                    /* R = M_cell, which is to be union mesh afterwards */
+                    M_cell,
+                    /* B = M_P, the mesh for the initial segment of P */
+                    M_P,
+                    /* list of end circle iterators from M_P which are updated to reflect the corresponding vertices in
+                     * the union mesh */
+                   &circle_its_update);
 
-                    /* if this is the first complex edge exception, set initial complex edge count */
-                    if (complex_edge_growth_factor == 0.0) {
-                        complex_edge_initial_count  = nce;
-                        complex_edge_growth_factor  = 1.0;
-                        debugl(1, "setting complex edge initial count to %d, factor to %5.4f\n", nce, complex_edge_growth_factor);
-                    }
-                    /* otherwise calculate "growth factor". in certain situations, splitting all complex edges creates
-                     * even more complex edges. this process can amplify itself exponentially. to prevent this, check
-                     * if the growth factor exceeds a certain limit */
-                    else {
-                        complex_edge_growth_factor  = (R)nce / (R)complex_edge_initial_count;
-                        debugl(1, "setting complex edge growth factor to %5.4f\n", complex_edge_growth_factor);
-                    }
+                /* RedBlueUnion call has been succcessful. break inner meshing loop */
+                break_inner_meshing_loop = true;
+            }
+            catch (RedBlue_Ex_InternalLogic& logic_ex) {
+                debugTabDec(); debugTabDec(); debugTabDec(); debugTabDec();
+                throw;
+            }
+            catch (RedBlue_Ex_Disjoint& disjoint_ex) {
+                debugTabDec(); debugTabDec(); debugTabDec(); debugTabDec();
+                throw;
+            }
+            catch (RedBlue_Ex_ComplexEdges<R>& complex_ex) {
+                debugl(0, "NLM_CellNetwork::renderCellNetwork(): RedBlueAlgorithm returned exception: %d complexly intersecting edges.. splitting.\n", complex_ex.edge_isec_info.size());
+                Profiling::addCounter("meshing/redblue_retry/complex_edges");
+                debugTabInc();
 
-                    /* if complex edge growth factor is too large, start new outer meshing iteration */
-                    if (complex_edge_growth_factor > this->meshing_complex_edge_max_growth_factor) {
-                        debugl(0, "Complex edge growth factor too large.\n");
-                        radius_factor   = std::max(radius_factor_safe_lb, radius_factor - this->meshing_radius_factor_decrement);
-                        new_outer_iteration = true;
-                        restore_M_cell      = true;
-                    }
-                    else for (auto e_info : complex_ex.edge_isec_info) {
-                        debugl(2, "complex edge: e = (%d, %d)\n", e_info.u_id, e_info.v_id);
-
-                        /* sort and check lambdas */
-                        std::vector<R>& lambdas = e_info.edge_lambdas;
-                        const uint32_t n = lambdas.size();
-
-                        debugl(2, "sorting complex exception edge lambdas. size(): %zu..\n", lambdas.size() );
-                        std::sort(lambdas.begin(), lambdas.end(), std::less<R>() );
-                        if (lambdas[0] <= 0 || lambdas[n-1] >= 1)
-                        {
-                            debugTabDec(); debugTabDec(); debugTabDec(); debugTabDec(); debugTabDec();
-                            throw("NLM_CellNetwork::renderCellNetwork(): got exceptino about complex edge indicating fractional edge intersection value lambda outside ]0, 1[."\
-                                " internal logic error.");
-                        }
+                uint32_t const nce = complex_ex.edge_isec_info.size();
 
-                        /* compute split points */
-                        std::vector<R> e_split_points(n-1);
-
-                        debugl(3, "split_points[0] = %5.4f\n", e_split_points[0]);
-                        for (uint32_t i = 1; i < n; i++) {
-                            e_split_points[i-1] = (lambdas[i] + lambdas[i-1]) / 2.0;
-                            debugl(3, "split_points[%d] = %5.4f\n", i, e_split_points[i]);
-                        }
-                        debugl(3, "split_points[%d] = %5.4f\n", n, e_split_points[n]);
-
-                        /* split in red mesh, i.e. M_cell */
-                        if (e_info.red) {
-                            auto u_it = M_cell.vertices.find(e_info.u_id);
-                            auto v_it = M_cell.vertices.find(e_info.v_id);
-
-                            if (u_it != M_cell.vertices.end() && v_it != M_cell.vertices.end()) {
-                                M_cell.splitEdge(u_it, v_it, e_split_points);
-                            }
-                            else {
-                                debugTabDec(); debugTabDec(); debugTabDec(); debugTabDec(); debugTabDec();
-                                throw("NLM_CellNetwork::renderCellNetwork(): discovered invalid vertex id contained "\
-                                    " in complex edge information of RedBlue_Ex_ComplexEdges (id not found). internal"\
-                                    " logic error.");
-                            }
-                        }
-                        /* split in blue mesh, i.e. M_P */
-                        else {
-                            auto u_it = M_P.vertices.find(e_info.u_id);
-                            auto v_it = M_P.vertices.find(e_info.v_id);
-
-                            if (u_it != M_P.vertices.end() && v_it != M_P.vertices.end()) {
-                                M_P.splitEdge(u_it, v_it, e_split_points);
-                            }
-                            else {
-                                debugTabDec(); debugTabDec(); debugTabDec(); debugTabDec(); debugTabDec();
-                                throw("NLM_CellNetwork::renderCellNetwork(): discovered invalid vertex id contained "\
-                                    " in complex edge information of RedBlue_Ex_ComplexEdges (id not found). internal"\
-                                    " logic error.");
-                            }
-                        }
-                    }
-                    debugTabDec();
-
-                    /* all splits performed. at this point, new_outer_iteration == false, break_inner_meshing_loop == false =>
-                     * another iteration of the inner meshing loop is performed, which issues another RedBlueUnion call
-                     * on the same initial mesh segment after splitting complex edges. */
-                    /*
-                    Mesh<Tm, Tv, Tf, R> tmp = M_cell;
-                    std::ostringstream oss1;
-                    oss1 << "M_cell_split_" << outer_loop_iter << "_" << inner_loop_iter;
-                    tmp.writeObjFile(oss1.str().c_str());
-
-                    tmp = M_P;
-                    std::ostringstream oss2;
-                    oss2 << "M_P_split_" << outer_loop_iter << "_" << inner_loop_iter;
-                    tmp.writeObjFile(oss2.str().c_str());
-                    */
+                /* if this is the first complex edge exception, set initial complex edge count */
+                if (complex_edge_growth_factor == 0.0) {
+                    complex_edge_initial_count  = nce;
+                    complex_edge_growth_factor  = 1.0;
+                    debugl(1, "setting complex edge initial count to %d, factor to %5.4f\n", nce, complex_edge_growth_factor);
                 }
-                catch (RedBlue_Ex_NumericalEdgeCase& numerical_ex) {
-                    debugl(0, "NLM_CellNetwork::renderCellNetwork(): RedBlueAlgorithm returned exception: numerical edge case => retry..\n");
-                    new_outer_iteration = true;
-                    restore_M_cell      = !numerical_ex.R_intact;
+                /* otherwise calculate "growth factor". in certain situations, splitting all complex edges creates
+                 * even more complex edges. this process can amplify itself exponentially. to prevent this, check
+                 * if the growth factor exceeds a certain limit */
+                else {
+                    complex_edge_growth_factor  = (R)nce / (R)complex_edge_initial_count;
+                    debugl(1, "setting complex edge growth factor to %5.4f\n", complex_edge_growth_factor);
                 }
-                catch (RedBlue_Ex_Triangulation<R>& tri_ex) {
-                    debugl(0, "NLM_CellNetwork::renderCellNetwork(): RedBlueAlgorithm returned exception: error during triangulation of outside / inside polygons. => retry..\n");
 
-                    /* decrease radius factor, but lower bound by radius_factor_safe_lb. */
-                    radius_factor       = std::max(radius_factor_safe_lb, radius_factor - this->meshing_radius_factor_decrement);
-                    new_outer_iteration = true;
-                    restore_M_cell      = !tri_ex.R_intact;
-                }
-                catch (RedBlue_Ex_NumIsecPoly& isecpoly_ex) {
-                    debugl(0, "NLM_CellNetwork::renderCellNetwork(): RedBlueAlgorithm returned exception: number of intersection polygons != 1.\n");
-                    radius_factor       = std::max(radius_factor_safe_lb, radius_factor - this->meshing_radius_factor_decrement);
+                /* if complex edge growth factor is too large, start new outer meshing iteration */
+                if (complex_edge_growth_factor > this->meshing_complex_edge_max_growth_factor) {
+                    debugl(0, "Complex edge growth factor too large.\n");
+                    radius_factor   = std::max(radius_factor_safe_lb, radius_factor - this->meshing_radius_factor_decrement);
                     new_outer_iteration = true;
-                    restore_M_cell      = !isecpoly_ex.R_intact;
+                    restore_M_cell      = true;
                 }
-                catch (RedBlue_Ex_AffectedCircleTrivial<R>& trivcircle_ex){
-                    debugl(0, "NLM_CellNetwork::renderCellNetwork(): RedBlueAlgorithm returned exception: affected circle trivial.\n");
-
-                    // split the single triangle with a center vertex at the pre-computed position
-                    if (trivcircle_ex.red)
-                        M_cell.split_face_with_center(trivcircle_ex.face_id, trivcircle_ex.splitPos);
-                    else
-                        M_P.split_face_with_center(trivcircle_ex.face_id, trivcircle_ex.splitPos);
+                else {
+                    NLM_CellNetwork<R>::splitComplexEdges(M_cell, M_P, complex_ex);
                 }
-                debugl(1, "inner meshing loop time: %5.4f\n\n", Aux::Timing::tack(14));
+                debugTabDec();
+
+                /* all splits performed. at this point, new_outer_iteration == false, break_inner_meshing_loop == false =>
+                 * another iteration of the inner meshing loop is performed, which issues another RedBlueUnion call
+                 * on the same initial mesh segment after splitting complex edges. */
+                /*
+                Mesh<Tm, Tv, Tf, R> tmp = M_cell;
+                std::ostringstream oss1;
+                oss1 << "M_cell_split_" << outer_loop_iter << "_" << inner_loop_iter;
+                tmp.writeObjFile(oss1.str().c_str());
+
+                tmp = M_P;
+                std::ostringstream oss2;
+                oss2 << "M_P_split_" << outer_loop_iter << "_" << inner_loop_iter;
+                tmp.writeObjFile(oss2.str().c_str());
+                */
             }
-            debugTabDec();
-            debugl(1, "inner meshing loop left..\n");
+            catch (RedBlue_Ex_NumericalEdgeCase& numerical_ex) {
+                debugl(0, "NLM_CellNetwork::renderCellNetwork(): RedBlueAlgorithm returned exception: numerical edge case => retry..\n");
+                Profiling::addCounter("meshing/redblue_retry/numerical_edge_case");
+                new_outer_iteration = true;
+                restore_M_cell      = !numerical_ex.R_intact;
+            }
+            catch (RedBlue_Ex_Triangulation<R>& tri_ex) {
+                debugl(0, "NLM_CellNetwork::renderCellNetwork(): RedBlueAlgorithm returned exception: error during triangulation of outside / inside polygons. => retry..\n");
+                Profiling::addCounter("meshing/redblue_retry/triangulation");
 
-            /* if maximum number of inner meshing loop iterations has been reached, restart outer meshing loop. */
-            if (inner_loop_iter == this->meshing_inner_loop_maxiter) {
-                debugl(0, "inner meshing loop broken because maximum number of iterations has been reached => restart outer meshing loop.\n");
-                radius_factor   = std::max(radius_factor_safe_lb, radius_factor - this->meshing_radius_factor_decrement);
+                /* decrease radius factor, but lower bound by radius_factor_safe_lb. */
+                radius_factor       = std::max(radius_factor_safe_lb, radius_factor - this->meshing_radius_factor_decrement);
                 new_outer_iteration = true;
-                restore_M_cell      = true;
+                restore_M_cell      = !tri_ex.R_intact;
             }
+            catch (RedBlue_Ex_NumIsecPoly& isecpoly_ex) {
+                debugl(0, "NLM_CellNetwork::renderCellNetwork(): RedBlueAlgorithm returned exception: number of intersection polygons != 1.\n");
+                Profiling::addCounter("meshing/redblue_retry/num_isec_poly");
+                radius_factor       = std::max(radius_factor_safe_lb, radius_factor - this->meshing_radius_factor_decrement);
+                new_outer_iteration = true;
+                restore_M_cell      = !isecpoly_ex.R_intact;
+            }
+            catch (RedBlue_Ex_AffectedCircleTrivial<R>& trivcircle_ex){
+                debugl(0, "NLM_CellNetwork::renderCellNetwork(): RedBlueAlgorithm returned exception: affected circle trivial.\n");
+                Profiling::addCounter("meshing/redblue_retry/affected_circle_trivial");
+
+                // split the single triangle with a center vertex at the pre-computed position
+                if (trivcircle_ex.red)
+                    M_cell.split_face_with_center(trivcircle_ex.face_id, trivcircle_ex.splitPos);
+                else
+                    M_P.split_face_with_center(trivcircle_ex.face_id, trivcircle_ex.splitPos);
+            }
+            debugl(1, "inner meshing loop time: %5.4f\n\n", Aux::Timing::tack(14));
+        }
+        debugTabDec();
+        debugl(1, "inner meshing loop left..\n");
+
+        /* if maximum number of inner meshing loop iterations has been reached, restart outer meshing loop. */
+        if (inner_loop_iter == this->meshing_inner_loop_maxiter) {
+            Profiling::addCounter("meshing/redblue_retry/inner_loop_maxiter");
+            debugl(0, "inner meshing loop broken because maximum number of iterations has been reached => restart outer meshing loop.\n");
+            radius_factor   = std::max(radius_factor_safe_lb, radius_factor - this->meshing_radius_factor_decrement);
+            new_outer_iteration = true;
+            restore_M_cell      = true;
+        }
 
-            // check that the complete end circle of P is not merged with M_cell
-            // this is not allowed, as we need it to connect the rest of the neurite
-            for (auto &it : circle_its_update)
+        // check that the complete end circle of P is not merged with M_cell
+        // this is not allowed, as we need it to connect the rest of the neurite
+        for (auto &it : circle_its_update)
+        {
+            if (it.explicitlyInvalid())
             {
-                if (it.explicitlyInvalid())
-                {
-                    debugl(0, "Neurite end circle intersects cell grid to connect to.\n"
-                              "Adding another segment to initial neurite stump and trying to connect again.\n");
-
-                    // if P has no more segments left to append, then this is an error
-                    if (P.numEdges() <= segment_index)
-                    {
-                        debugTabDec(); debugTabDec(); debugTabDec();
-                        throw("NLM_CellNetwork::renderCellNetwork(): RedBlueUnion algorithm has explicitly invalidated an "\
-                          "end circle iterator or the closing vertex iterator of the current path P's initial mesh "
-                          "segment. This means the tip of the initial segment intersects with the rest of the geometry."
-                          " This degenerate case cannot be dealt with at the moment. In a clean network, this should be "
-                          "impossible. numerical edge case due to tight PMDV / SMDV constants?");
-                    }
+                debugl(0, "Neurite end circle intersects cell grid to connect to.\n"
+                          "Adding another segment to initial neurite stump and trying to connect again.\n");
 
-                    // otherwise send R-B in another outer iteration
-                    // and tell it to append one further segment to P
-                    ++segment_index;
-                    new_outer_iteration = true;
-                    restore_M_cell      = true;
-                    break;
+                // if P has no more segments left to append, then this is an error
+                if (P.numEdges() <= segment_index)
+                {
+                    debugTabDec(); debugTabDec(); debugTabDec();
+                    throw("NLM_CellNetwork::renderCellNetwork(): RedBlueUnion algorithm has explicitly invalidated an "\
+                      "end circle iterator or the closing vertex iterator of the current path P's initial mesh "
+                      "segment. This means the tip of the initial segment intersects with the rest of the geometry."
+                      " This degenerate case cannot be dealt with at the moment. In a clean network, this should be "
+                      "impossible. numerical edge case due to tight PMDV / SMDV constants?");
                 }
-            }
-
-            /* start fresh iteration of outer meshing loop if required */
-            if (new_outer_iteration) {
-                debugl(1, "re-iteration of outer meshing loop necessary..\n");
-                /* if radius_factor has reached radius_factor_safe_lb, throw exception, since a definitely safe radius
-                 * should already have been reached. */
-                if (radius_factor == radius_factor_safe_lb) {
-
-                    Mesh<Tm, Tv, Tf, R> tmp = M_cell;
-                    std::ostringstream oss1;
-                    oss1 << "M_cell_split_" << outer_loop_iter << "_" << inner_loop_iter;
-                    tmp.writeObjFile(oss1.str().c_str());
 
-                    tmp = M_P;
-                    std::ostringstream oss2;
-                    oss2 << "M_P_split_" << outer_loop_iter << "_" << inner_loop_iter;
-                    tmp.writeObjFile(oss2.str().c_str());
+                // otherwise send R-B in another outer iteration
+                // and tell it to append one further segment to P
+                ++segment_index;
+                new_outer_iteration = true;
+                restore_M_cell      = true;
+                break;
+            }
+        }
 
-                    debugTabDec(); debugTabDec(); debugTabDec();
-                    throw("NLM_CellNetwork::renderCellNetwork(): Reached safe lower bound radius factor for current "
-                        "neurite path. This must not happen for clean cell networks and indicates that the initial "
-                        "segment of the neurite currently being connected, apart from the connection point, has a "
-                        "second intersection with the rest of the geometry.");
-                }
-                /* otherwise start another meshing run */
-                else {
-                    continue;
-                }
+        /* start fresh iteration of outer meshing loop if required */
+        if (new_outer_iteration) {
+            debugl(1, "re-iteration of outer meshing loop necessary..\n");
+            /* if radius_factor has reached radius_factor_safe_lb, throw exception, since a definitely safe radius
+             * should already have been reached. */
+            if (radius_factor == radius_factor_safe_lb) {
+
+                Mesh<Tm, Tv, Tf, R> tmp = M_cell;
+                std::ostringstream oss1;
+                oss1 << "M_cell_split_" << outer_loop_iter << "_" << inner_loop_iter;
+                tmp.writeObjFile(oss1.str().c_str());
+
+                tmp = M_P;
+                std::ostringstream oss2;
+                oss2 << "M_P_split_" << outer_loop_iter << "_" << inner_loop_iter;
+                tmp.writeObjFile(oss2.str().c_str());
+
+                debugTabDec(); debugTabDec(); debugTabDec();
+                throw("NLM_CellNetwork::renderCellNetwork(): Reached safe lower bound radius factor for current "
+                    "neurite path. This must not happen for clean cell networks and indicates that the initial "
+                    "segment of the neurite currently being connected, apart from the connection point, has a "
+                    "second intersection with the rest of the geometry.");
             }
+            /* otherwise start another meshing run */
+            else {
+                continue;
+            }
+        }
 
-            // security check
-            for (auto &it : circle_its_update) {
-                if (!it.checkContainer(M_cell)) {
-                    debugl(1, "it.container: %p, M_cell (ptr): %p, M_P (ptr): %p.\n", it.getContainer(), &M_cell, &M_P);
-                    debugTabDec(); debugTabDec(); debugTabDec();
-                    throw("NLM_CellNetwork::renderCellNetwork(): RedBlueUnion algorithm has returned an "\
-                        "updated end circle iterator that does not refer to the partially completed cell mesh. "\
-                        "internal logic error.");
-                }
+        // security check
+        for (auto &it : circle_its_update) {
+            if (!it.checkContainer(M_cell)) {
+                debugl(1, "it.container: %p, M_cell (ptr): %p, M_P (ptr): %p.\n", it.getContainer(), &M_cell, &M_P);
+                debugTabDec(); debugTabDec(); debugTabDec();
+                throw("NLM_CellNetwork::renderCellNetwork(): RedBlueUnion algorithm has returned an "\
+                    "updated end circle iterator that does not refer to the partially completed cell mesh. "\
+                    "internal logic error.");
             }
+        }
 
-            debugl(2, "initial mesh segment successfully merged. appending path tail mesh..\n");
+        debugl(2, "initial mesh segment successfully merged. appending path tail mesh..\n");
 
-            /* unpack updated iterators referring to M_cell. */
-            closing_vertex_it   = circle_its_update.back();
-            circle_its_update.pop_back();
-            end_circle_its      = circle_its_update;
+        /* no further restore of M_cell for P: accept all changes */
+        M_cell.commitCheckpoint();
+
+        /* unpack updated iterators referring to M_cell. */
+        closing_vertex_it   = circle_its_update.back();
+        circle_its_update.pop_back();
+        end_circle_its      = circle_its_update;
+
+        {
+            Profiling::ScopedStage generate_stage("meshing/generate");
 
             /* append P's tail mesh (for neurite canal segments 1, .., m) to M */
             try
@@ -3815,7 +4120,7 @@ NLM_CellNetwork<R>::renderCellNetwork(std::string filename)
                 P.template appendTailMesh<Tm, Tv, Tf>(
                     M_cell,
                     segment_index,
-                    this->meshing_canal_segment_n_phi_segments,
+                    n_phi_segments,
                     meshing_cansurf_triangle_height_factor,
                     render_vector,
                     phi_0,
@@ -3828,7 +4133,8 @@ NLM_CellNetwork<R>::renderCellNetwork(std::string filename)
                    &end_circle_offset,
                    &end_circle_its,
                    &closing_vertex_it,
-                    this->meshing_preserve_crease_edges);
+                    this->meshing_preserve_crease_edges,
+                   &ring_cache);
             }
             catch (...) {debugTabDec(); debugTabDec(); debugTabDec(); throw;}
 
@@ -3846,25 +4152,466 @@ NLM_CellNetwork<R>::renderCellNetwork(std::string filename)
                     start,
                     radius,
                     direction,
-                    this->meshing_canal_segment_n_phi_segments,
+                    n_phi_segments,
                     phi_0,
                     end_circle_its,
-                    closing_vertex_it);
+                    closing_vertex_it,
+                   &ring_cache);
+        }
+        Profiling::addCounter("meshing/generated_triangles", ring_cache.takeTriangleCount());
+
+        debugl(2, "half-sphere appended. triangulating quads..\n");
 
-            debugl(2, "half-sphere appended. triangulating quads..\n");
+        /* triangulate quads in M_cell */
+        M_cell.triangulateQuads();
 
-            /* triangulate quads in M_cell */
-            M_cell.triangulateQuads();
+        debugl(1, "path %d completely processed. M_cell.numVertices(): %d\n", path_id, M_cell.numVertices());
 
-            debugl(1, "path %d completely processed. M_cell.numVertices(): %d\n", (*npt_vit)->id(), M_cell.numVertices());
+        /* done for path P */
+        done = true;
+    }
+    debugTabDec();
+}
 
-            /* done for path P */
-            done = true;
+/* mesh the neurite root path P stand-alone into the (empty) mesh M_T, i.e. without merging it into the soma sphere.
+ * the result is the seed mesh of P's neurite path tree, into which all remaining paths of the tree are merged by
+ * meshNeuritePath() and which is finally merged into the cell mesh by mergeNeuritePathTreeMesh(). */
+template <typename R>
+template <typename Tm, typename Tv, typename Tf>
+void
+NLM_CellNetwork<R>::meshRootNeuritePath(
+    Mesh<Tm, Tv, Tf, R>                    &M_T,
+    NLM::NeuritePath<R> const              &P,
+    Vec3<R> const                          &render_vector,
+    uint32_t                                n_phi_segments,
+    std::mt19937                           &phi_0_rng) const
+{
+    bool                                                    end_circle_offset;
+    std::vector<
+            typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
+        >                                                   end_circle_its;
+    typename Mesh<Tm, Tv, Tf, R>::vertex_iterator           closing_vertex_it;
+
+    R phi_0 = std::uniform_real_distribution<R>(0.0, (2*(R)M_PI) / (R)n_phi_segments)(phi_0_rng);
+
+    CanalSurfaceRingCache<R>    ring_cache(n_phi_segments, phi_0);
+    Profiling::ScopedStage      generate_stage("meshing/generate");
+
+    P.template generateInitialSegmentMesh<Tm, Tv, Tf>(
+        M_T,
+        n_phi_segments,
+        meshing_cansurf_triangle_height_factor,
+        render_vector,
+        phi_0,
+        1E-3,
+        end_circle_offset,
+        end_circle_its,
+        closing_vertex_it,
+        /* radius factor is ignored for root paths */
+        1.0,
+        this->meshing_preserve_crease_edges,
+       &ring_cache);
+
+    P.template appendTailMesh<Tm, Tv, Tf>(
+        M_T,
+        1,
+        n_phi_segments,
+        meshing_cansurf_triangle_height_factor,
+        render_vector,
+        phi_0,
+        1E-3,
+        end_circle_offset,
+        end_circle_its,
+        closing_vertex_it,
+       &end_circle_offset,
+       &end_circle_its,
+       &closing_vertex_it,
+        this->meshing_preserve_crease_edges,
+       &ring_cache);
+
+    BLRCanalSurface<3u, R> &C_end   = *(P.canal_segments_magnified.back());
+    Vec3<R> start                   = C_end.spineCurveEval(1.0);
+    Vec3<R> direction               = C_end.spineCurveEval_d(1.0);
+    R       radius                  = C_end.radiusEval(1.0);
+
+    MeshAlg::appendHalfSphereToCanalSurfaceMesh<Tm, Tv, Tf, R>(
+            M_T,
+            render_vector,
+            start,
+            radius,
+            direction,
+            n_phi_segments,
+            phi_0,
+            end_circle_its,
+            closing_vertex_it,
+           &ring_cache);
+
+    Profiling::addCounter("meshing/generated_triangles", ring_cache.takeTriangleCount());
+
+    M_T.triangulateQuads();
+}
+
+/* merge the complete mesh M_T of a neurite path tree into M_cell with RedBlueUnion. complex edges and trivial affected
+ * circles are handled by splitting as in meshNeuritePath(), all other RedBlue exceptions are considered fatal for the
+ * tree mesh. M_cell is protected by a checkpoint and left unchanged if false is returned. */
+template <typename R>
+template <typename Tm, typename Tv, typename Tf>
+bool
+NLM_CellNetwork<R>::mergeNeuritePathTreeMesh(
+    Mesh<Tm, Tv, Tf, R>                    &M_cell,
+    Mesh<Tm, Tv, Tf, R>                    &M_T) const
+{
+    using namespace RedBlue_ExCodes;
+
+    M_cell.beginCheckpoint();
+    for (uint32_t iter = 0; iter < this->meshing_inner_loop_maxiter; iter++) {
+        try {
+            Profiling::ScopedStage redblue_stage("meshing/redblue");
+            MeshAlg::RedBlueUnion<Tm, Tv, Tf, R>(M_cell, M_T);
+
+            M_cell.commitCheckpoint();
+            return true;
         }
-        debugTabDec();
-        np_idx++;
+        catch (RedBlue_Ex_ComplexEdges<R>& complex_ex) {
+            debugl(0, "NLM_CellNetwork::mergeNeuritePathTreeMesh(): %d complexly intersecting edges.. splitting.\n", complex_ex.edge_isec_info.size());
+            Profiling::addCounter("meshing/redblue_retry/complex_edges");
+            NLM_CellNetwork<R>::splitComplexEdges(M_cell, M_T, complex_ex);
+        }
+        catch (RedBlue_Ex_AffectedCircleTrivial<R>& trivcircle_ex) {
+            debugl(0, "NLM_CellNetwork::mergeNeuritePathTreeMesh(): affected circle trivial.\n");
+            Profiling::addCounter("meshing/redblue_retry/affected_circle_trivial");
+            if (trivcircle_ex.red) {
+                M_cell.split_face_with_center(trivcircle_ex.face_id, trivcircle_ex.splitPos);
+            }
+            else {
+                M_T.split_face_with_center(trivcircle_ex.face_id, trivcircle_ex.splitPos);
+            }
+        }
+        catch (RedBlue_Ex& ex) {
+            debugl(0, "NLM_CellNetwork::mergeNeuritePathTreeMesh(): RedBlueAlgorithm returned exception: %s\n", ex.what());
+            break;
+        }
+    }
+
+    M_cell.rollbackCheckpoint();
+    return false;
+}
+
+/* multi-threaded variant of the neurite path loop of renderCellNetwork(). the neurite path trees, which only interact
+ * with each other via the soma spheres, are meshed concurrently into separate meshes on meshing_nthreads threads,
+ * starting from a stand-alone mesh of the root path. the tree meshes are then merged into M_cell in a serial pass in
+ * BFS order. if a tree could not be meshed on its own or its merge fails, its paths are meshed one by one into M_cell
+ * exactly as in the serial case. render vectors are computed serially in BFS order and angular offsets are drawn from
+ * one generator per tree, so the result does not depend on thread scheduling. */
+template <typename R>
+template <typename Tm, typename Tv, typename Tf>
+void
+NLM_CellNetwork<R>::renderNeuritePathTreesMultiThreaded(
+    Mesh<Tm, Tv, Tf, R>                                            &M_cell,
+    MeshAlg::MeshObjFlushInfo<Tm, Tv, Tf, R>                       &M_cell_flushinfo,
+    MeshingFlushIndex                                              &flush_index,
+    std::list<typename NeuritePathTree::vertex_iterator> const     &npt_vertices_bfs_ordered,
+    std::vector<size_t> const                                      &npt_subtree_sizes) const
+{
+    typedef typename std::list<typename NeuritePathTree::vertex_iterator>::const_iterator npt_list_iterator;
+
+    struct PathTreeMesh {
+        npt_list_iterator       begin, end;
+        std::vector<Vec3<R>>    render_vectors;
+        Mesh<Tm, Tv, Tf, R>     M;
+        bool                    meshed;
+    };
+
+    std::vector<PathTreeMesh> trees(npt_subtree_sizes.size());
+
+    /* partition BFS ordering into trees and find render vectors */
+    auto npt_vit = npt_vertices_bfs_ordered.begin();
+    for (auto &T : trees) {
+        size_t const i  = &T - trees.data();
+        T.begin         = npt_vit;
+        for (size_t j = 0; j < npt_subtree_sizes[i]; j++, ++npt_vit) {
+            T.render_vectors.push_back(((*npt_vit)->vertex_data).findPermissibleRenderVector());
+        }
+        T.end           = npt_vit;
+        T.meshed        = false;
+    }
+
+    /* mesh trees concurrently. any failure just leaves the tree to the serial fallback below. */
+    Aux::Parallel::forEachIndex(trees.size(), this->meshing_nthreads,
+        [&] (size_t i, uint32_t) -> void {
+            PathTreeMesh               &T = trees[i];
+            NLM::NeuritePath<R> const  &P_root = (*T.begin)->vertex_data;
+            if (!P_root.root_path) {
+                return;
+            }
+
+            TRACE_SCOPE_ARG("meshing/path_tree", "index", i);
+            Profiling::ScopedStage tree_stage("meshing/path_tree");
+
+            /* tree-local generators for the angular offsets and for all other random draws made while meshing
+             * (e.g. by polygon triangulation), so that the tree mesh does not depend on thread scheduling. */
+            std::mt19937                        phi_0_rng(i);
+            std::mt19937                        frand_rng(i);
+            Aux::Numbers::ScopedRandomGenerator frand_scope(frand_rng);
+            try {
+                this->template meshRootNeuritePath<Tm, Tv, Tf>(T.M, P_root, T.render_vectors[0], this->meshing_canal_segment_n_phi_segments, phi_0_rng);
+                T.M.enableFaceIndex();
+
+                auto rv_it = T.render_vectors.begin();
+                for (auto it = std::next(T.begin); it != T.end; ++it) {
+                    this->template meshNeuritePath<Tm, Tv, Tf>(T.M, (*it)->vertex_data, (*it)->id(), *(++rv_it), this->meshing_canal_segment_n_phi_segments, &phi_0_rng);
+                }
+                T.meshed = true;
+            }
+            catch (...) {
+                T.M.clear();
+            }
+        },
+        "meshing worker");
+
+    /* merge tree meshes into M_cell in BFS order */
+    for (auto &T : trees) {
+        size_t const i = &T - trees.data();
+        printf("\t merging neurite path tree %5zu of %5zu.\n", i + 1, trees.size());
+
+        this->template flushUnaffectedCellMeshFaces<Tm, Tv, Tf>(M_cell, M_cell_flushinfo, flush_index, T.begin, npt_vertices_bfs_ordered.end());
+
+        bool merged = false;
+        if (T.meshed) {
+            Profiling::ScopedStage merge_stage("meshing/path_tree_merge");
+            merged = this->template mergeNeuritePathTreeMesh<Tm, Tv, Tf>(M_cell, T.M);
+        }
+
+        if (!merged) {
+            printf("\t neurite path tree %5zu could not be meshed on its own. meshing its paths sequentially.\n", i + 1);
+            Profiling::addCounter("meshing/path_tree_fallbacks");
+
+            auto rv_it = T.render_vectors.begin();
+            for (auto it = T.begin; it != T.end; ++it, ++rv_it) {
+                Profiling::ScopedStage path_stage("meshing/neurite_path");
+                this->template flushUnaffectedCellMeshFaces<Tm, Tv, Tf>(M_cell, M_cell_flushinfo, flush_index, it, npt_vertices_bfs_ordered.end());
+                this->template meshNeuritePath<Tm, Tv, Tf>(M_cell, (*it)->vertex_data, (*it)->id(), *rv_it, this->meshing_canal_segment_n_phi_segments);
+            }
+        }
+        T.M.clear();
+    }
+}
+
+template <typename R>
+void
+NLM_CellNetwork<R>::computeMeshingOrder(
+    std::list<typename NeuritePathTree::vertex_iterator>   &npt_vertices_bfs_ordered,
+    std::vector<size_t>                                    &npt_subtree_sizes)
+{
+    npt_vertices_bfs_ordered.clear();
+    npt_subtree_sizes.clear();
+
+    /* for all somas, get breadth-first ordering of neurite paths for all neurites and append to global list */
+    for (auto &s : this->soma_vertices) {
+        NLM::SomaInfo<R> &s_info  = s.soma_data;
+
+        /* iterate over all neurite path trees, i.e. all neurites, of the soma. */
+        for (NeuritePathTree &npt : s_info.neurite_path_trees) {
+            std::list<typename NeuritePathTree::Vertex const *>  source_vertices;
+            for (auto &v : npt.vertices) {
+                if (v.indeg() == 0) {
+                    source_vertices.push_back(&v);
+                }
+            }
+
+            for (auto &sv : source_vertices) {
+                /* get connected component of source vertex in breadth-first order and append corresponding
+                 * NeuritePath pointers to neurite path list. */
+                std::list<typename NeuritePathTree::Vertex *> sv_cc;  
+
+                uint32_t tid = npt.getFreshTraversalId();
+
+                npt.getConnectedComponentBreadthFirst(
+                    sv->iterator(),
+                    tid,
+                    &sv_cc,
+                    NULL);
+
+                for (auto &u : sv_cc) {
+                    npt_vertices_bfs_ordered.push_back(u->iterator());
+                }
+                npt_subtree_sizes.push_back(sv_cc.size());
+            }
+        }
+    }
+}
+
+template <typename R>
+template <typename Tm, typename Tv, typename Tf>
+void
+NLM_CellNetwork<R>::renderCellNetwork(std::string filename)
+{
+    debugl(1, "NLM_CellNetwork<R>::renderCellNetwork(): \"%s\".\n", filename.c_str());
+    debugTabInc();
+
+    std::list<typename NeuritePathTree::vertex_iterator>    npt_vertices_bfs_ordered;
+    std::vector<size_t>                                     npt_subtree_sizes;
+
+    debugl(1, "computing BFS ordering among neurite paths.\n");
+    this->computeMeshingOrder(npt_vertices_bfs_ordered, npt_subtree_sizes);
+
+    try {
+        this->template renderCellMesh<Tm, Tv, Tf>(
+            filename,
+            this->meshing_canal_segment_n_phi_segments,
+            npt_vertices_bfs_ordered,
+            npt_subtree_sizes,
+            NULL,
+            NULL);
     }
+    catch (...) {debugTabDec(); throw;}
+
     debugTabDec();
+    debugl(1, "NLM_CellNetwork<R>::renderCellNetwork(): done.\n");
+}
+
+/* the BFS ordering and the render vectors of all neurite paths are computed once and shared by all levels of detail.
+ * each level is rendered by renderCellMesh() with its own generator for the angular offsets, seeded with its number of
+ * segments, so every output depends only on its own n_phi_segments and not on the other levels or on thread
+ * scheduling. levels are distributed over meshing_nthreads threads, the neurite paths of each level are meshed
+ * sequentially. */
+template <typename R>
+template <typename Tm, typename Tv, typename Tf>
+void
+NLM_CellNetwork<R>::renderCellNetworkLODs(
+    std::string                     filename,
+    std::vector<uint32_t> const    &lod_n_phi_segments)
+{
+    debugl(1, "NLM_CellNetwork<R>::renderCellNetworkLODs(): \"%s\", %zu levels.\n", filename.c_str(), lod_n_phi_segments.size());
+    debugTabInc();
+
+    std::list<typename NeuritePathTree::vertex_iterator>    npt_vertices_bfs_ordered;
+    std::vector<size_t>                                     npt_subtree_sizes;
+    std::vector<Vec3<R>>                                    render_vectors;
+
+    debugl(1, "computing BFS ordering and render vectors of all neurite paths.\n");
+    this->computeMeshingOrder(npt_vertices_bfs_ordered, npt_subtree_sizes);
+
+    /* finding render vectors draws from the global random sequence */
+    render_vectors.reserve(npt_vertices_bfs_ordered.size());
+    for (auto &npt_v : npt_vertices_bfs_ordered) {
+        render_vectors.push_back(npt_v->vertex_data.findPermissibleRenderVector());
+    }
+
+    std::vector<std::exception_ptr>     lod_exceptions(lod_n_phi_segments.size());
+
+    /* errors are collected per level of detail and reported below, so that one failing level doesn't stop the others */
+    Aux::Parallel::forEachIndex(lod_n_phi_segments.size(), this->meshing_nthreads,
+        [&] (size_t k, uint32_t) -> void
+        {
+            uint32_t const  n_phi       = lod_n_phi_segments[k];
+            std::string     lod_name    = filename + "_lod" + std::to_string(n_phi);
+            std::mt19937    phi_0_rng(n_phi);
+            std::mt19937    frand_rng(n_phi);
+
+            Aux::Numbers::ScopedRandomGenerator frand_scope(frand_rng);
+
+            printf("\t rendering level of detail \"%s.obj\" with %u segments per cross-section.\n", lod_name.c_str(), n_phi);
+            try {
+                TRACE_SCOPE_ARG("meshing/lod", "n_phi_segments", n_phi);
+                this->template renderCellMesh<Tm, Tv, Tf>(
+                    lod_name,
+                    n_phi,
+                    npt_vertices_bfs_ordered,
+                    npt_subtree_sizes,
+                   &render_vectors,
+                   &phi_0_rng);
+            }
+            catch (...) {
+                lod_exceptions[k] = std::current_exception();
+            }
+        },
+        "meshing lod worker");
+
+    debugTabDec();
+    for (auto &ex : lod_exceptions) {
+        if (ex) {
+            std::rethrow_exception(ex);
+        }
+    }
+    debugl(1, "NLM_CellNetwork<R>::renderCellNetworkLODs(): done.\n");
+}
+
+/* inductively mesh the cell network into "<filename>.obj" with n_phi_segments segments per cross-section, given the BFS
+ * ordering of all neurite paths. if render_vectors (one per path in BFS order) are given, they are used instead of
+ * finding new ones and the paths are meshed sequentially, drawing angular offsets from phi_0_rng. otherwise, the
+ * settings of (this) network decide between sequential and multi-threaded meshing and the global random sequence is
+ * used. */
+template <typename R>
+template <typename Tm, typename Tv, typename Tf>
+void
+NLM_CellNetwork<R>::renderCellMesh(
+    std::string                                                     filename,
+    uint32_t                                                        n_phi_segments,
+    std::list<typename NeuritePathTree::vertex_iterator> const     &npt_vertices_bfs_ordered,
+    std::vector<size_t> const                                      &npt_subtree_sizes,
+    std::vector<Vec3<R>> const                                     *render_vectors,
+    std::mt19937                                                   *phi_0_rng) const
+{
+    debugl(1, "NLM_CellNetwork<R>::renderCellMesh(): \"%s\".\n", filename.c_str());
+    debugTabInc();
+
+    Mesh<Tm, Tv, Tf, R>                                     M_cell, M_S;
+
+    /* initialize the cell mesh to consist of all soma spheres. */
+    debugl(1, "initializing soma sphere meshes.\n");
+    for (auto &s : this->soma_vertices) {
+        s.soma_data.soma_sphere.template generateMesh<Tm, Tv, Tf>(M_S, meshing_n_soma_refs);
+        M_cell.moveAppend(M_S);
+    }
+
+    /* keep a persistent spatial index of the faces of M_cell, so that locating the faces near a neurite path in
+     * RedBlueUnion and for flushing does not depend on the size of M_cell. */
+    M_cell.enableFaceIndex();
+
+    /* initialize flush info */
+    MeshAlg::MeshObjFlushInfo<Tm, Tv, Tf, R>    M_cell_flushinfo(filename);
+
+    /* index the canal segments of all neurite paths to be meshed for selecting the faces to flush */
+    MeshingFlushIndex                           flush_index;
+    if (this->meshing_flush) {
+        this->buildMeshingFlushIndex(npt_vertices_bfs_ordered, flush_index);
+    }
+
+    /* in the computed bread-first ordering, inductively append neurite path meshes */
+    if (!render_vectors && this->meshing_nthreads > 1) {
+        debugl(1, "processing neurite path trees on %d threads.\n", this->meshing_nthreads);
+        debugTabInc();
+        this->template renderNeuritePathTreesMultiThreaded<Tm, Tv, Tf>(M_cell, M_cell_flushinfo, flush_index, npt_vertices_bfs_ordered, npt_subtree_sizes);
+        debugTabDec();
+    }
+    else {
+        debugl(1, "processing neurite paths in BFS order.\n");
+        debugTabInc();
+        uint32_t np_idx = 1;
+        for (auto npt_vit = npt_vertices_bfs_ordered.begin(); npt_vit != npt_vertices_bfs_ordered.end(); ++npt_vit) {
+            debugl(2, "processing neurite path %d\n", (*npt_vit)->id());
+            if (!render_vectors) {
+                printf("\t meshing neurite path %5u of %5zu.\n", np_idx, npt_vertices_bfs_ordered.size() );
+            }
+
+            Profiling::ScopedStage path_stage("meshing/neurite_path");
+
+            /* get reference to neurite path */
+            NLM::NeuritePath<R> const &P    = (*npt_vit)->vertex_data;
+
+            /* find permissible render vector for neurite path */
+            Vec3<R> render_vector;
+            render_vector = render_vectors ? (*render_vectors)[np_idx - 1] : P.findPermissibleRenderVector();
+
+            /* flush parts of M_cell that are definitely not affected by the remaining merging operations */
+            this->template flushUnaffectedCellMeshFaces<Tm, Tv, Tf>(M_cell, M_cell_flushinfo, flush_index, npt_vit, npt_vertices_bfs_ordered.end());
+
+            this->template meshNeuritePath<Tm, Tv, Tf>(M_cell, P, (*npt_vit)->id(), render_vector, n_phi_segments, phi_0_rng);
+            np_idx++;
+        }
+        debugTabDec();
+    }
     debugl(1, "all neurite paths processed. finalizing obj file..\n");
 
     /* select all faces from cell mesh and flush them .. if no flush has been performed before, this is semantically
@@ -3872,96 +4619,143 @@ NLM_CellNetwork<R>::renderCellNetwork(std::string filename)
      * flush obj file. */
     std::list<typename Mesh<Tm, Tv, Tf, R>::Face *> remaining_faces = {};
     M_cell.invertFaceSelection(remaining_faces);
-    try {MeshAlg::partialFlushToObjFile(M_cell, M_cell_flushinfo, remaining_faces);}
-    catch (...) {debugTabDec(); debugTabDec(); throw;}
+
+    Profiling::ScopedStage flush_stage("meshing/final_flush");
+    Profiling::addCounter("meshing/flushed_faces", remaining_faces.size());
+
+    try {
+        MeshAlg::partialFlushToObjFile(M_cell, M_cell_flushinfo, remaining_faces);
+
+        /* join the background writer, which assembles the complete obj file */
+        M_cell_flushinfo.finalize();
+    }
+    catch (...) {debugTabDec(); throw;}
 
     debugTabDec();
-    debugl(1, "NLM_CellNetwork<R>::renderCellNetwork(): done.\n");
+    debugl(1, "NLM_CellNetwork<R>::renderCellMesh(): done.\n");
 }
 
+/* all soma and neurite path meshes are independent of each other: they are generated into separate meshes on
+ * meshing_nthreads threads and concatenated in a fixed order afterwards, which only moves pointers. render vectors are
+ * computed beforehand, since finding them draws from the global random sequence. */
 template <typename R>
 template <typename Tm, typename Tv, typename Tf>
 void
 NLM_CellNetwork<R>::renderModellingMeshesIndividually(std::string filename) const
 {
-    Mesh<Tm, Tv, Tf, R>                                     M_cell, M_S, M_P;
-    bool                                                    initial_segment_end_circle_offset;
-    std::vector<
-            typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
-        >                                                   initial_segment_end_circle_its;
-    typename Mesh<Tm, Tv, Tf, R>::vertex_iterator           initial_segment_closing_vertex_it;
+    /* a single soma or neurite path mesh to be generated */
+    struct MeshJob {
+        NLM::SomaInfo<R> const     *s_info;
+        NLM::NeuritePath<R> const  *P;
+        Vec3<R>                     render_vector;
+    };
+
+    std::vector<MeshJob> jobs;
 
     /* iterate over all somas */
     for (auto &s : this->soma_vertices) {
-        /* generate mesh for soma sphere and append to cell mesh. */
         NLM::SomaInfo<R> const &s_info  = s.soma_data;
-        s_info.soma_sphere.template generateMesh<Tm, Tv, Tf>(M_S);
-        M_cell.moveAppend(M_S);
-        
-        /* iterate over all neurite path trees and append meshes from all neurite paths */
+        jobs.push_back({ &s_info, NULL, Vec3<R>() });
+
+        /* iterate over all neurite path trees and add jobs for all neurite paths */
         for (auto &npt : s_info.neurite_path_trees) {
             for (auto &npt_v : npt.vertices) {
                 NLM::NeuritePath<R> const  &P = *npt_v;
-                Vec3<R>                     render_vector;
 
                 /* find permissible render vector for neurite path */
-                render_vector = P.findPermissibleRenderVector();
+                jobs.push_back({ NULL, &P, P.findPermissibleRenderVector() });
+            }
+        }
+    }
 
-                /* clear path mesh */
-                M_P.clear();
+    std::vector<Mesh<Tm, Tv, Tf, R>> meshes(jobs.size());
 
-                /* generate P's initial segment mesh and append to M */
-                P.template generateInitialSegmentMesh<Tm, Tv, Tf>(
-                    /* append to mesh M_P for path P*/
-                    M_P,
-                    meshing_canal_segment_n_phi_segments,
-                    meshing_cansurf_triangle_height_factor,
-                    /* render vector */
-                    render_vector,
-                    /* phi_0 = 0, arclen_dt = 1E-3 */
-                    0,
-                    1E-3,
-                    /* end circle info */
-                    initial_segment_end_circle_offset,
-                    initial_segment_end_circle_its,
-                    initial_segment_closing_vertex_it,
-                    /* no radius reduction => factor 1 */
-                    1);
+    auto generateMesh = [&] (MeshJob const &job, Mesh<Tm, Tv, Tf, R> &M_P) -> void {
+        /* generate mesh for soma sphere */
+        if (job.s_info) {
+            job.s_info->soma_sphere.template generateMesh<Tm, Tv, Tf>(M_P);
+            return;
+        }
 
-                /*
-                Mesh<Tm, Tv, Tf, R> M_initial = M_P;
-                M_initial.writeObjFile("M_initial", false);
-                */
+        NLM::NeuritePath<R> const                              &P = *job.P;
+        CanalSurfaceRingCache<R>                                ring_cache(meshing_canal_segment_n_phi_segments, 0);
+        bool                                                    initial_segment_end_circle_offset;
+        std::vector<
+                typename Mesh<Tm, Tv, Tf, R>::vertex_iterator
+            >                                                   initial_segment_end_circle_its;
+        typename Mesh<Tm, Tv, Tf, R>::vertex_iterator           initial_segment_closing_vertex_it;
+
+        /* generate P's initial segment mesh and append to M */
+        P.template generateInitialSegmentMesh<Tm, Tv, Tf>(
+            /* append to mesh M_P for path P*/
+            M_P,
+            meshing_canal_segment_n_phi_segments,
+            meshing_cansurf_triangle_height_factor,
+            /* render vector */
+            job.render_vector,
+            /* phi_0 = 0, arclen_dt = 1E-3 */
+            0,
+            1E-3,
+            /* end circle info */
+            initial_segment_end_circle_offset,
+            initial_segment_end_circle_its,
+            initial_segment_closing_vertex_it,
+            /* no radius reduction => factor 1 */
+            1,
+            false,
+           &ring_cache);
 
-                /* append P's tail mesh (for neurite canal segments 1, .., m) to M */
-                P.template appendTailMesh<Tm, Tv, Tf>(
-                    /* append to mesh M_P for path P */
-                    M_P,
-                    1,
-                    meshing_canal_segment_n_phi_segments,
-                    meshing_cansurf_triangle_height_factor,
-                    /* render vector */
-                    render_vector,
-                    /* phi_0 = 0, arclen_dt = 1E-3 */
-                    0,
-                    1E-3,
-                    /* end circle information from initial segment as start circle information for tail */
-                    initial_segment_end_circle_offset,
-                    initial_segment_end_circle_its,
-                    initial_segment_closing_vertex_it,
-                    /* no return information required */
-                    NULL,
-                    NULL,
-                    NULL);
+        /*
+        Mesh<Tm, Tv, Tf, R> M_initial = M_P;
+        M_initial.writeObjFile("M_initial", false);
+        */
 
-                M_cell.moveAppend(M_P);
-            }
-        }
+        /* append P's tail mesh (for neurite canal segments 1, .., m) to M */
+        P.template appendTailMesh<Tm, Tv, Tf>(
+            /* append to mesh M_P for path P */
+            M_P,
+            1,
+            meshing_canal_segment_n_phi_segments,
+            meshing_cansurf_triangle_height_factor,
+            /* render vector */
+            job.render_vector,
+            /* phi_0 = 0, arclen_dt = 1E-3 */
+            0,
+            1E-3,
+            /* end circle information from initial segment as start circle information for tail */
+            initial_segment_end_circle_offset,
+            initial_segment_end_circle_its,
+            initial_segment_closing_vertex_it,
+            /* no return information required */
+            NULL,
+            NULL,
+            NULL,
+            false,
+           &ring_cache);
+
+        Profiling::addCounter("meshing_individual_surfaces/generated_triangles", ring_cache.takeTriangleCount());
+
+        M_P.triangulateQuads();
+    };
+
+    /* generate meshes. the first error is re-thrown on the calling thread once all workers have finished. */
+    {
+        Profiling::ScopedStage generate_stage("meshing_individual_surfaces/generate");
+
+        Aux::Parallel::forEachIndex(jobs.size(), this->meshing_nthreads,
+            [&] (size_t i, uint32_t) -> void { generateMesh(jobs[i], meshes[i]); },
+            "meshing worker");
+    }
+
+    /* concatenate all meshes in job order and output M */
+    Mesh<Tm, Tv, Tf, R> M_cell;
+    {
+        Profiling::ScopedStage append_stage("meshing_individual_surfaces/append");
+        M_cell.moveAppend(meshes);
     }
 
-    /* output M */
-    M_cell.triangulateQuads();
-    M_cell.writeObjFile(filename.c_str());
+    Profiling::ScopedStage write_stage("meshing_individual_surfaces/write");
+    M_cell.writeObjFile(filename.c_str(), this->meshing_nthreads);
 }
 
 template <typename R>
@@ -1423,7 +1423,7 @@ BiLinClip_getApproximationData(
     using Aux::Numbers::bicof;
 
     // static variables to store precomputable legendre polynomials and approximation matrices.
-    static bool firstCall = true;
+    static std::once_flag init_flag;
     static BiBernsteinPolynomial<deg1, deg2, R, R> LegendreBiPolBB00;
     static BiBernsteinPolynomial<deg1, deg2, R, R> LegendreBiPolBB01;
     static BiBernsteinPolynomial<deg1, deg2, R, R> LegendreBiPolBB10;
@@ -1431,8 +1431,8 @@ BiLinClip_getApproximationData(
     static StaticMatrix<deg1+1, deg2+1, R> LegendreBiApproximantMatrix01;
     static StaticMatrix<deg1+1, deg2+1, R> LegendreBiApproximantMatrix10;
 
-    // recompute if necessary and dynamic_recomputation == true
-    if (firstCall)
+    // compute exactly once, also if several analysis threads or cells request the data concurrently
+    std::call_once(init_flag, [] () -> void
     {
         debugl(1, "BiLinClip_getApproximationData(): recomputing approximation data for pair (deg1, deg2) = (%d, %d).\n", deg1, deg2);
 
@@ -1561,11 +1561,8 @@ BiLinClip_getApproximationData(
             }
         }
 
-        /* set dynamic recomputation flag after update */
-        firstCall = false;
-
         debugl(1, "BiLinClip_getApproximationData(): approximation data computed for pair (m, n) = (%d, %d).\n", deg1, deg2);
-    }
+    });
 
     /* if no exception has been thrown due to disabled dynamic recomputation, all approximation data has already been
      * available or recomputed if necessary.  write values desired by the caller. */
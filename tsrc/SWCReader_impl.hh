@@ -0,0 +1,261 @@
+/*
+ * This file is part of
+ *
+ * AnaMorph: a framework for geometric modelling, consistency analysis and surface
+ * mesh generation of anatomically reconstructed neuron morphologies.
+ * 
+ * Copyright (c) 2013-2017: G-CSC, Goethe University Frankfurt - Queisser group
+ * Author: Konstantin Mörschel
+ * 
+ * AnaMorph is free software: Redistribution and use in source and binary forms,
+ * with or without modification, are permitted under the terms of the
+ * GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works:
+ * "Based on AnaMorph (https://github.com/NeuroBox3D/AnaMorph)."
+ *
+ * (3) Neither the name "AnaMorph" nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * (4) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Mörschel K, Breit M, Queisser G. Generating neuron geometries for detailed
+ *   three-dimensional simulations using AnaMorph. Neuroinformatics (2017)"
+ * "Grein S, Stepniewski M, Reiter S, Knodel MM, Queisser G.
+ *   1D-3D hybrid modelling – from multi-compartment models to full resolution
+ *   models in space and time. Frontiers in Neuroinformatics 8, 68 (2014)"
+ * "Breit M, Stepniewski M, Grein S, Gottmann P, Reinhardt L, Queisser G.
+ *   Anatomically detailed and large-scale simulations studying synapse loss
+ *   and synchrony using NeuroBox. Frontiers in Neuroanatomy 10 (2016)"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+namespace SWCReader {
+    inline bool
+    isBlank(char c)
+    {
+        return (isspace((unsigned char)c));
+    }
+
+    /* sscanf() semantics for a single field: leading whitespace is skipped, but only within the current line */
+    inline bool
+    parseField(
+        char const    *&s,
+        char const     *le,
+        uint32_t       &x)
+    {
+        while (s < le && isBlank(*s)) {
+            ++s;
+        }
+        if (s == le) {
+            return false;
+        }
+        char *e;
+        x = (uint32_t)strtoul(s, &e, 10);
+        if (e == s) {
+            return false;
+        }
+        s = e;
+        return true;
+    }
+
+    inline bool
+    parseField(
+        char const    *&s,
+        char const     *le,
+        int32_t        &x)
+    {
+        while (s < le && isBlank(*s)) {
+            ++s;
+        }
+        if (s == le) {
+            return false;
+        }
+        char *e;
+        x = (int32_t)strtol(s, &e, 10);
+        if (e == s) {
+            return false;
+        }
+        s = e;
+        return true;
+    }
+
+    inline bool
+    parseField(
+        char const    *&s,
+        char const     *le,
+        double         &x)
+    {
+        while (s < le && isBlank(*s)) {
+            ++s;
+        }
+        if (s == le) {
+            return false;
+        }
+        char *e;
+        x = strtod(s, &e);
+        if (e == s) {
+            return false;
+        }
+        s = e;
+        return true;
+    }
+
+    inline bool
+    parseField(
+        char const    *&s,
+        char const     *le,
+        float          &x)
+    {
+        while (s < le && isBlank(*s)) {
+            ++s;
+        }
+        if (s == le) {
+            return false;
+        }
+        char *e;
+        x = strtof(s, &e);
+        if (e == s) {
+            return false;
+        }
+        s = e;
+        return true;
+    }
+
+    /* parse the seven fields of one non-comment line [s, le). the byte at le must not continue a number, i.e. be
+     * '\n' or '\0'. */
+    template <typename R>
+    inline bool
+    parseLine(
+        char const     *s,
+        char const     *le,
+        Record<R>      &rec)
+    {
+        return (
+            parseField(s, le, rec.compartment_id)   &&
+            parseField(s, le, rec.compartment_type) &&
+            parseField(s, le, rec.p[0])             &&
+            parseField(s, le, rec.p[1])             &&
+            parseField(s, le, rec.p[2])             &&
+            parseField(s, le, rec.r)                &&
+            parseField(s, le, rec.parent_id)
+        );
+    }
+
+    template <typename R>
+    char const *
+    parseChunk(
+        char const                 *begin,
+        char const                 *end,
+        std::vector<Record<R>>     &records)
+    {
+        /* SWC lines rarely fall below ~32 bytes, reserve accordingly to avoid regrowth */
+        records.reserve(records.size() + (end - begin) / 32 + 1);
+
+        Record<R>   rec;
+        char const *lb = begin;
+        while (lb < end) {
+            char const *nl = (char const *)memchr(lb, '\n', end - lb);
+            char const *le = nl ? nl : end;
+
+            /* empty line */
+            if (le == lb) {
+                lb = le + 1;
+                continue;
+            }
+
+            /* skip comments */
+            char const *s = lb;
+            while (s < le && isBlank(*s)) {
+                ++s;
+            }
+            if (s < le && *s == '#') {
+                lb = le + 1;
+                continue;
+            }
+
+            bool ok;
+            if (nl) {
+                ok = parseLine(s, le, rec);
+            }
+            else {
+                /* final line without trailing newline: strto*() must not run past the end of the mapping, so parse
+                 * a NUL-terminated copy */
+                std::string last(s, le);
+                ok = parseLine(last.c_str(), last.c_str() + last.size(), rec);
+            }
+
+            if (!ok) {
+                return lb;
+            }
+            records.push_back(rec);
+            lb = le + 1;
+        }
+        return NULL;
+    }
+
+    template <typename R>
+    char const *
+    parse(
+        MappedFile const           &f,
+        uint32_t                    nthreads,
+        std::vector<Record<R>>     &records)
+    {
+        /* small files are not worth splitting */
+        size_t const    min_chunk_size  = 1 << 16;
+        uint32_t const  nchunks         = std::max<size_t>(1, std::min<size_t>(std::max(nthreads, 1u),
+                                            f.size() / min_chunk_size));
+
+        auto chunks = splitIntoLineChunks(f.data(), f.size(), nchunks);
+
+        records.clear();
+        if (chunks.size() <= 1) {
+            return (chunks.empty() ? NULL : parseChunk(f.data(), f.data() + f.size(), records));
+        }
+
+        std::vector<std::vector<Record<R>>> chunk_records(chunks.size());
+        std::vector<char const *>           chunk_errors(chunks.size(), NULL);
+
+        Aux::Parallel::forEachIndex(chunks.size(), nthreads,
+            [&] (size_t i, uint32_t) -> void {
+                chunk_errors[i] = parseChunk(
+                        f.data() + chunks[i].first,
+                        f.data() + chunks[i].second,
+                        chunk_records[i]
+                    );
+            },
+            "swc parser");
+
+        /* report the first malformed line in file order */
+        for (auto e : chunk_errors) {
+            if (e) {
+                return e;
+            }
+        }
+
+        size_t n = 0;
+        for (auto &cr : chunk_records) {
+            n += cr.size();
+        }
+        records.reserve(n);
+        for (auto &cr : chunk_records) {
+            records.insert(records.end(), cr.begin(), cr.end());
+        }
+        return NULL;
+    }
+}